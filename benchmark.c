@@ -0,0 +1,666 @@
+/*
+ * ============================================================================
+ * PROGRAM: benchmark.c
+ * OPIS: Merenje performansi Radix Sort biblioteke
+ * ============================================================================
+ *
+ * Za svaku veličinu niza i raspodelu vrednosti meri medijanu od više
+ * ponavljanja za svaku varijantu iz tabele g_variants. Ulaz se pre svakog
+ * ponavljanja ponovo generiše istim seed-om, generisanje se ne meri.
+ *
+ * KOMPAJLIRANJE:
+ *     gcc -std=c23 -pedantic -Wall -O2 -pthread benchmark.c -L. -lradixsort -o benchmark
+ *
+ *     make benchmark         (povezan sa optimizovanom libradixsort.a)
+ *     make compare           (isti benchmark nad svakom varijantom biblioteke:
+ *                             baseline, release, shared, lto, pgo)
+ *
+ * POKRETANJE:
+ *     ./benchmark [maksimalna_veličina] [broj_ponavljanja]
+ *     ./benchmark 100000000 5
+ *
+ * ============================================================================
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "radix_sort.h"
+
+#define DEFAULT_MAX_SIZE ((size_t)10000000U)
+#define DEFAULT_RUNS 5U
+#define MAX_RUNS 64U
+#define SMALL_ARRAY_SIZE 64U /* veličina malih nizova u batch scenariju */
+#define ASYNC_PART_SIZE 65536U /* veličina dela u asinhronom scenariju */
+#define MAX_ASYNC_PARTS 4096U /* veći nizovi se predaju u talasima */
+
+/*
+ * Raspodela ulaznih vrednosti
+ */
+typedef enum
+{
+	DIST_UNIFORM = 0,
+	DIST_NARROW,      /* ocene: 1000 vrednosti oko 10^9 */
+	DIST_MEDIUM,      /* opseg 2^20 koji prelazi nulu */
+	DIST_FEW_UNIQUE,  /* 100 kodova rasutih po celom int32_t opsegu */
+	DIST_RUNS,        /* 8 nadovezanih sortiranih delova (segmenti po shard-u) */
+	DIST_COUNT
+} Distribution;
+
+/*
+ * Varijanta koja se meri: priprema podešavanja + funkcija sortiranja
+ */
+typedef struct
+{
+	const char* name;
+	void (*prepare)(void);
+	SortResult (*sort)(int32_t* arr, size_t size);
+	bool reportsStats;/*da li varijanta puni SortStats*/
+} Variant;
+
+static void prepareHugePages(void);
+static void prepareNormalPages(void);
+static void prepareNuma(void);
+static void prepareNoNuma(void);
+static void prepareThreadCache(void);
+static SortResult sortParallel(int32_t* arr, size_t size);
+static SortResult sortContext(int32_t* arr, size_t size);
+static SortResult sortSmallLoop(int32_t* arr, size_t size);
+static SortResult sortSmallBatch(int32_t* arr, size_t size);
+static SortResult sortSmallSegmented(int32_t* arr, size_t size);
+static SortResult sortPartsLoop(int32_t* arr, size_t size);
+static SortResult sortPartsAsync(int32_t* arr, size_t size);
+static SortResult sortUnique(int32_t* arr, size_t size);
+static SortResult sortThenDedup(int32_t* arr, size_t size);
+static SortResult sortCopy(int32_t* arr, size_t size);
+static SortResult sortMemcpy(int32_t* arr, size_t size);
+static SortResult sortPacked(int32_t* arr, size_t size);
+static SortResult sortColumnsGather(int32_t* arr, size_t size);
+static SortResult sortRecords16(int32_t* arr, size_t size);
+static SortResult sortBudgetHalf(int32_t* arr, size_t size);
+static SortResult sortBudgetEighth(int32_t* arr, size_t size);
+static SortResult quantilesExact(int32_t* arr, size_t size);
+static SortResult quantilesApprox(int32_t* arr, size_t size);
+static SortResult sortPackedDecode(int32_t* arr, size_t size);
+static SortResult sortQsort(int32_t* arr, size_t size);
+static int compareInt32(const void* a, const void* b);
+static void fillArray(int32_t* arr, size_t size, Distribution dist, uint32_t seed);
+static const char* distributionName(Distribution dist);
+static double nowMs(void);
+static double median(double* values, size_t count);
+
+static const Variant g_variants[] =
+{
+	{ "radix (huge stranice)",   prepareHugePages,   radixSort, true },
+	{ "radix (4 KB stranice)",   prepareNormalPages, radixSort, true },
+	{ "radix (keš po thread-u)", prepareThreadCache, radixSort, true },
+	{ "paralelni (NUMA)",        prepareNuma,        sortParallel, true },
+	{ "paralelni (bez NUMA)",    prepareNoNuma,      sortParallel, true },
+	{ "kontekst (trajni pool)",  NULL,               sortContext, true },
+	{ "po 64: radixSort petlja", NULL,               sortSmallLoop, false },
+	{ "po 64: radixSortBatch",   NULL,               sortSmallBatch, true },
+	{ "po 64: segmentirano",     NULL,               sortSmallSegmented, true },
+	{ "po 64K: radixSort petlja", NULL,              sortPartsLoop, false },
+	{ "po 64K: petlja + keš",    prepareThreadCache, sortPartsLoop, false },
+	{ "po 64K: radixSortAsync",  NULL,               sortPartsAsync, false },
+	{ "radixSortUnique",         NULL,               sortUnique, true },
+	{ "radix + prolaz za dupl.", NULL,               sortThenDedup, false },
+	{ "radixSortCopy",           NULL,               sortCopy, true },
+	{ "memcpy + radixSort",      NULL,               sortMemcpy, false },
+	{ "radixSortPacked",         NULL,               sortPacked, true },
+	{ "kolona: perm + gather",   NULL,               sortColumnsGather, true },
+	{ "zapisi od 16 B",          NULL,               sortRecords16, true },
+	{ "limit 4n B (Budget)",     NULL,               sortBudgetHalf, true },
+	{ "limit n B (Budget)",      NULL,               sortBudgetEighth, true },
+	{ "kvantili (tačno)",        NULL,               quantilesExact, true },
+	{ "kvantili (eps = 0.001)",  NULL,               quantilesApprox, true },
+	{ "packed + dekodiranje",    NULL,               sortPackedDecode, false },
+	{ "qsort",                   NULL,               sortQsort, false },
+};
+
+static RadixSortContext* g_context = NULL; /* pravi se jednom, kao u servisu koji sortira stalno */
+
+static const size_t g_sizes[] = { 10000U, 100000U, 1000000U, 10000000U, 100000000U };
+
+static void prepareHugePages(void)
+{
+	SortConfig config;
+	radixSortGetConfig(&config);
+	config.hugePages = SORT_HUGEPAGES_AUTO;
+	(void)radixSortSetConfig(&config);
+}
+
+static void prepareNormalPages(void)
+{
+	SortConfig config;
+	radixSortGetConfig(&config);
+	config.hugePages = SORT_HUGEPAGES_OFF;
+	(void)radixSortSetConfig(&config);
+}
+
+static void prepareNuma(void)
+{
+	SortConfig config;
+	radixSortGetConfig(&config);
+	config.numaAware = true;
+	(void)radixSortSetConfig(&config);
+}
+
+static void prepareNoNuma(void)
+{
+	SortConfig config;
+	radixSortGetConfig(&config);
+	config.numaAware = false;
+	(void)radixSortSetConfig(&config);
+}
+
+/* Baferi ostaju u thread-u između ponavljanja, kao u servisu koji sortira stalno */
+static void prepareThreadCache(void)
+{
+	SortConfig config;
+	radixSortGetConfig(&config);
+	config.threadCacheBytes = (size_t)512U * 1024U * 1024U;
+	(void)radixSortSetConfig(&config);
+}
+
+/* Svi dostupni CPU-ovi */
+static SortResult sortParallel(int32_t* arr, size_t size)
+{
+	return radixSortParallel(arr, size, 0U);
+}
+
+static SortResult sortContext(int32_t* arr, size_t size)
+{
+	if (g_context == NULL)
+	{
+		SortResult result = radixSortContextCreate(&g_context, 0U, 0U);
+		if (result != SORT_SUCCESS)
+		{
+			return result;
+		}
+	}
+	return radixSortWithContext(g_context, arr, size);
+}
+
+/*
+ * Batch scenario: niz se posmatra kao size / 64 nezavisnih malih nizova
+ * (npr. liste događaja po korisniku) koji se sortiraju svaki za sebe.
+ */
+static SortResult sortSmallLoop(int32_t* arr, size_t size)
+{
+	SortResult result = SORT_SUCCESS;
+	for (size_t i = 0; (i < size) && (result == SORT_SUCCESS); i += SMALL_ARRAY_SIZE)
+	{
+		size_t length = ((size - i) < SMALL_ARRAY_SIZE) ? (size - i) : SMALL_ARRAY_SIZE;
+		result = radixSort(arr + i, length);
+	}
+	return result;
+}
+
+static SortResult sortSmallBatch(int32_t* arr, size_t size)
+{
+	size_t count = (size + SMALL_ARRAY_SIZE - 1U) / SMALL_ARRAY_SIZE;
+	int32_t** arrays = (int32_t**)malloc(count * sizeof(int32_t*));
+	size_t* sizes = (size_t*)malloc(count * sizeof(size_t));
+	if ((arrays == NULL) || (sizes == NULL))
+	{
+		free(arrays);
+		free(sizes);
+		return SORT_ERROR_MEMORY;
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		arrays[i] = arr + (i * SMALL_ARRAY_SIZE);
+		sizes[i] = ((size - (i * SMALL_ARRAY_SIZE)) < SMALL_ARRAY_SIZE) ? (size - (i * SMALL_ARRAY_SIZE)) : SMALL_ARRAY_SIZE;
+	}
+
+	SortResult result = radixSortBatch(arrays, sizes, count);
+	free(arrays);
+	free(sizes);
+	return result;
+}
+
+static SortResult sortSmallSegmented(int32_t* arr, size_t size)
+{
+	size_t count = (size + SMALL_ARRAY_SIZE - 1U) / SMALL_ARRAY_SIZE;
+	size_t* offsets = (size_t*)malloc((count + 1U) * sizeof(size_t));
+	if (offsets == NULL)
+	{
+		return SORT_ERROR_MEMORY;
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		offsets[i] = i * SMALL_ARRAY_SIZE;
+	}
+	offsets[count] = size;
+
+	SortResult result = radixSortSegmented(arr, offsets, count);
+	free(offsets);
+	return result;
+}
+
+/*
+ * Asinhroni scenario: niz od size / 64K nezavisnih delova (npr. blokovi
+ * koji stižu iz mreže). Petlja ih sortira jedan po jedan, async ih
+ * predaje sve odjednom pa pozadinski pool radi na više jezgara.
+ */
+static SortResult sortPartsLoop(int32_t* arr, size_t size)
+{
+	SortResult result = SORT_SUCCESS;
+	for (size_t i = 0; (i < size) && (result == SORT_SUCCESS); i += ASYNC_PART_SIZE)
+	{
+		size_t length = ((size - i) < ASYNC_PART_SIZE) ? (size - i) : ASYNC_PART_SIZE;
+		result = radixSort(arr + i, length);
+	}
+	return result;
+}
+
+static SortResult sortPartsAsync(int32_t* arr, size_t size)
+{
+	static RadixSortHandle* handles[MAX_ASYNC_PARTS];
+	SortResult result = SORT_SUCCESS;
+
+	for (size_t wave = 0; wave < size; wave += (size_t)ASYNC_PART_SIZE * MAX_ASYNC_PARTS)
+	{
+		size_t count = 0U;
+		for (size_t i = wave; (i < size) && (count < MAX_ASYNC_PARTS); i += ASYNC_PART_SIZE)
+		{
+			size_t length = ((size - i) < ASYNC_PART_SIZE) ? (size - i) : ASYNC_PART_SIZE;
+			handles[count] = radixSortAsync(arr + i, length, NULL, NULL);
+			if (handles[count] == NULL)
+			{
+				result = SORT_ERROR_MEMORY;
+				break;
+			}
+			count++;
+		}
+
+		for (size_t j = 0; j < count; j++)
+		{
+			SortResult partResult = radixSortWait(handles[j]);
+			result = (result == SORT_SUCCESS) ? partResult : result;
+		}
+	}
+	return result;
+}
+
+static SortResult sortUnique(int32_t* arr, size_t size)
+{
+	size_t newSize = 0;
+	return radixSortUnique(arr, size, &newSize);
+}
+
+/* Poređenje: isto što i radixSortUnique, ali sa posebnim prolazom posle sortiranja */
+static SortResult sortThenDedup(int32_t* arr, size_t size)
+{
+	SortResult result = radixSort(arr, size);
+	size_t length = (size > 0U) ? 1U : 0U;
+	for (size_t i = 1; (result == SORT_SUCCESS) && (i < size); i++)
+	{
+		if (arr[i] != arr[length - 1U])
+		{
+			arr[length] = arr[i];
+			length++;
+		}
+	}
+	return result;
+}
+
+/*
+ * Sortiranje u novi bafer uz čuvanje originala. Oba scenarija alociraju
+ * odredišni bafer u merenom delu, isto kao pozivalac koji ga nema unapred.
+ */
+static SortResult sortCopy(int32_t* arr, size_t size)
+{
+	int32_t* out = (int32_t*)malloc(size * sizeof(int32_t));
+	if (out == NULL)
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	SortResult result = radixSortCopy(arr, out, size);
+	free(out);
+	return result;
+}
+
+static SortResult sortMemcpy(int32_t* arr, size_t size)
+{
+	int32_t* out = (int32_t*)malloc(size * sizeof(int32_t));
+	if (out == NULL)
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	(void)memcpy(out, arr, size * sizeof(int32_t));
+	SortResult result = radixSort(out, size);
+	free(out);
+	return result;
+}
+
+static int compareInt32(const void* a, const void* b)
+{
+	int32_t x = *(const int32_t*)a;
+	int32_t y = *(const int32_t*)b;
+	return (x > y) - (x < y);
+}
+
+/*
+ * Jedna kolona kao tabela: permutacija pa gather nazad u arr - cena
+ * sortiranja po indeksima u odnosu na direktno sortiranje vrednosti
+ */
+static SortResult sortColumnsGather(int32_t* arr, size_t size)
+{
+	uint32_t* perm = (uint32_t*)malloc(size * sizeof(uint32_t));
+	int32_t* copy = (int32_t*)malloc(size * sizeof(int32_t));
+	if ((perm == NULL) || (copy == NULL))
+	{
+		free(perm);
+		free(copy);
+		return SORT_ERROR_MEMORY;
+	}
+
+	const int32_t* cols[1] = { arr };
+	SortResult result = radixSortColumns(cols, 1U, size, perm);
+	if (result == SORT_SUCCESS)
+	{
+		(void)memcpy(copy, arr, size * sizeof(int32_t));
+		result = radixGather(copy, sizeof(int32_t), size, perm, arr);
+	}
+	free(perm);
+	free(copy);
+	return result;
+}
+
+/*
+ * Zapisi od 16 bajtova (ključ + 12 bajtova podataka), sortirani po ključu;
+ * ključevi se posle vraćaju u arr
+ */
+static SortResult sortRecords16(int32_t* arr, size_t size)
+{
+	int32_t* records = (int32_t*)malloc(size * 4U * sizeof(int32_t));
+	if (records == NULL)
+	{
+		return SORT_ERROR_MEMORY;
+	}
+
+	for (size_t i = 0; i < size; i++)
+	{
+		records[i * 4U] = arr[i];
+		records[(i * 4U) + 1U] = (int32_t)i;
+		records[(i * 4U) + 2U] = (int32_t)i;
+		records[(i * 4U) + 3U] = (int32_t)i;
+	}
+
+	SortResult result = radixSortRecords(records, size, 4U * sizeof(int32_t), 0U);
+	for (size_t i = 0; i < size; i++)
+	{
+		arr[i] = records[i * 4U];
+	}
+	free(records);
+	return result;
+}
+
+/*
+ * Sortiranje sa limitom scratch-a od polovine (4n B) i osmine (n B) onoga
+ * što treba radixSort-u - cena spajanja delova u mestu
+ */
+static SortResult sortBudgetHalf(int32_t* arr, size_t size)
+{
+	return radixSortBudget(arr, size, size * sizeof(int32_t));
+}
+
+static SortResult sortBudgetEighth(int32_t* arr, size_t size)
+{
+	return radixSortBudget(arr, size, size);
+}
+
+/*
+ * Kvantili za monitoring (p50, p90, p99, p99.9, min, max) bez sortiranja;
+ * niz ostaje nesortiran, poređenje je sa radixSort + čitanje po indexu
+ */
+static const double g_monitorQuantiles[6] = { 0.0, 0.5, 0.9, 0.99, 0.999, 1.0 };
+
+static SortResult quantilesExact(int32_t* arr, size_t size)
+{
+	int32_t out[6];
+	return radixQuantiles(arr, size, g_monitorQuantiles, 6U, out);
+}
+
+static SortResult quantilesApprox(int32_t* arr, size_t size)
+{
+	int32_t out[6];
+	return radixQuantilesApprox(arr, size, g_monitorQuantiles, 6U, 0.001, out);
+}
+
+/*
+ * Sortiranje + pakovanje za keš; druga varijanta odmah i raspakuje u arr,
+ * pa je razlika između njih cena dekodiranja
+ */
+static SortResult sortPacked(int32_t* arr, size_t size)
+{
+	size_t capacity = radixPackedBound(size);
+	uint8_t* packed = (uint8_t*)malloc(capacity);
+	if (packed == NULL)
+	{
+		return SORT_ERROR_MEMORY;
+	}
+
+	size_t bytes = 0U;
+	SortResult result = radixSortPacked(arr, size, packed, capacity, &bytes);
+	free(packed);
+	return result;
+}
+
+static SortResult sortPackedDecode(int32_t* arr, size_t size)
+{
+	size_t capacity = radixPackedBound(size);
+	uint8_t* packed = (uint8_t*)malloc(capacity);
+	if (packed == NULL)
+	{
+		return SORT_ERROR_MEMORY;
+	}
+
+	size_t bytes = 0U;
+	size_t count = 0U;
+	SortResult result = radixSortPacked(arr, size, packed, capacity, &bytes);
+	if (result == SORT_SUCCESS)
+	{
+		result = radixPackedDecode(packed, bytes, arr, size, &count);
+	}
+	free(packed);
+	return result;
+}
+
+static SortResult sortQsort(int32_t* arr, size_t size)
+{
+	qsort(arr, size, sizeof(int32_t), compareInt32);
+	return SORT_SUCCESS;
+}
+
+/*
+ * Generator ulaza: xorshift32, nezavisan od rand() i RAND_MAX platforme
+ */
+static void fillArray(int32_t* arr, size_t size, Distribution dist, uint32_t seed)
+{
+	uint32_t state = (seed == 0U) ? 0x9E3779B9U : seed;
+	size_t runLength = (size + 7U) / 8U;
+	uint32_t step = UINT32_MAX / (uint32_t)((runLength < UINT32_MAX) ? (runLength + 1U) : UINT32_MAX);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		switch (dist)
+		{
+			case DIST_NARROW:
+				arr[i] = 1000000000 + (int32_t)(state % 1000U);
+				break;
+			case DIST_MEDIUM:
+				arr[i] = (int32_t)(state & 0xFFFFFU) - 500000;
+				break;
+			case DIST_FEW_UNIQUE:
+				arr[i] = (int32_t)((state % 100U) * 0x9E3779B1U);
+				break;
+			case DIST_RUNS:
+				/* Rastuće unutar dela: korak po elementu + šum manji od koraka */
+				arr[i] = (int32_t)(((uint32_t)(i % runLength) * step + (state % step)) ^ 0x80000000U);
+				break;
+			case DIST_UNIFORM:
+			default:
+				arr[i] = (int32_t)state;
+				break;
+		}
+	}
+}
+
+static const char* distributionName(Distribution dist)
+{
+	switch (dist)
+	{
+		case DIST_UNIFORM:
+			return "uniformna";
+		case DIST_NARROW:
+			return "uska";
+		case DIST_MEDIUM:
+			return "srednja";
+		case DIST_FEW_UNIQUE:
+			return "malo razl.";
+		case DIST_RUNS:
+			return "8 delova";
+		default:
+			return "nepoznata";
+	}
+}
+
+static double nowMs(void)
+{
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((double)ts.tv_sec * 1000.0) + ((double)ts.tv_nsec / 1000000.0);
+}
+
+/* Medijana malog niza - insertion sort je dovoljan za <= MAX_RUNS vrednosti */
+static double median(double* values, size_t count)
+{
+	for (size_t i = 1; i < count; i++)
+	{
+		double key = values[i];
+		size_t j = i;
+		while ((j > 0U) && (values[j - 1U] > key))
+		{
+			values[j] = values[j - 1U];
+			j--;
+		}
+		values[j] = key;
+	}
+	return values[count / 2U];
+}
+
+int main(int argc, char** argv)
+{
+	size_t maxSize = DEFAULT_MAX_SIZE;
+	size_t runs = DEFAULT_RUNS;
+
+	if (argc > 1)
+	{
+		maxSize = (size_t)strtoull(argv[1], NULL, 10);
+	}
+	if (argc > 2)
+	{
+		runs = (size_t)strtoull(argv[2], NULL, 10);
+	}
+	if ((runs == 0U) || (runs > MAX_RUNS))
+	{
+		runs = DEFAULT_RUNS;
+	}
+
+	int32_t* arr = (int32_t*)malloc(maxSize * sizeof(int32_t));
+	if (arr == NULL)
+	{
+		printf("Greška: Neuspela alokacija %zu elemenata\n", maxSize);
+		return 1;
+	}
+
+	SortConfig original;
+	radixSortGetConfig(&original);
+
+	printf("%-12s %-12s %-26s %12s  %s\n", "raspodela", "veličina", "varijanta", "medijana ms", "stranice / thread-ovi / čvorovi / strategija / prolazi");
+
+	for (size_t d = 0; d < (size_t)DIST_COUNT; d++)
+	{
+		for (size_t s = 0; s < sizeof(g_sizes) / sizeof(g_sizes[0]); s++)
+		{
+			size_t size = g_sizes[s];
+			if (size > maxSize)
+			{
+				break;
+			}
+
+			for (size_t v = 0; v < sizeof(g_variants) / sizeof(g_variants[0]); v++)
+			{
+				const Variant* variant = &g_variants[v];
+				double times[MAX_RUNS];
+				SortStats stats = {0};
+				bool ok = true;
+
+				(void)radixSortSetConfig(&original);
+				radixSortReleaseThreadCache();/*prethodna varijanta ne ostavlja bafere u kešu*/
+				if (variant->prepare != NULL)
+				{
+					variant->prepare();
+				}
+
+				for (size_t r = 0; r < runs; r++)
+				{
+					fillArray(arr, size, (Distribution)d, 42U + (uint32_t)r);
+
+					double start = nowMs();
+					SortResult result = variant->sort(arr, size);
+					times[r] = nowMs() - start;
+
+					if (result != SORT_SUCCESS)
+					{
+						ok = false;
+					}
+				}
+
+				if (variant->reportsStats)
+				{
+					radixSortGetStats(&stats);
+				}
+
+				printf("%-12s %-12zu %-26s %12.2f  ",
+				       distributionName((Distribution)d), size, variant->name,
+				       median(times, runs));
+				if (!ok)
+				{
+					printf("GREŠKA\n");
+				}
+				else if (variant->reportsStats)
+				{
+					printf("%s / %zu / %zu / %s / %zu\n", getPageKindString(stats.pages), stats.threads,
+					       stats.numaNodes, getStrategyString(stats.strategy), stats.passes);
+				}
+				else
+				{
+					printf("-\n");
+				}
+			}
+		}
+	}
+
+	(void)radixSortSetConfig(&original);
+	radixSortReleaseThreadCache();
+	radixSortContextDestroy(g_context);
+	free(arr);
+
+	return 0;
+}
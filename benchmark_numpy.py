@@ -0,0 +1,91 @@
+"""
+============================================================================
+benchmark_numpy.py
+OPIS: Merenje Python modula radixsort naspram numpy
+============================================================================
+
+Za svaki tip i veličinu meri medijanu više ponavljanja za tri operacije:
+    sort        ndarray.sort() (u mestu)          radixsort.sort(a)
+    argsort     numpy.argsort(a, kind="stable")   radixsort.argsort(a)
+    key/value   stabilan argsort + dva indeksiranja radixsort.sort_pairs(k, v)
+Ulaz se pre svakog ponavljanja kopira iz istog originala, kopija se ne
+meri. Ključevi su slučajni preko celog opsega (celi brojevi), odnosno
+normalna raspodela (float).
+
+POKRETANJE:
+    make bench-python
+    python3 benchmark_numpy.py [maksimalna_veličina] [broj_ponavljanja]
+
+============================================================================
+"""
+
+import statistics
+import sys
+import time
+
+import numpy
+
+import radixsort
+
+SIZES = (10_000, 100_000, 1_000_000, 10_000_000, 100_000_000)
+DTYPES = ("int32", "float32", "int64", "float64")
+
+
+def make_keys(dtype, size, rng):
+    if dtype.startswith("int"):
+        info = numpy.iinfo(dtype)
+        return rng.integers(info.min, info.max, size=size, dtype=dtype, endpoint=True)
+    return (rng.standard_normal(size) * 1e6).astype(dtype)
+
+
+def measure(runs, prepare, operation):
+    times = []
+    for _ in range(runs):
+        args = prepare()
+        start = time.perf_counter()
+        operation(*args)
+        times.append((time.perf_counter() - start) * 1000.0)
+    return statistics.median(times)
+
+
+def numpy_pairs(keys, values):
+    order = numpy.argsort(keys, kind="stable")
+    keys[:] = keys[order]
+    values[:] = values[order]
+
+
+def main():
+    max_size = int(sys.argv[1]) if len(sys.argv) > 1 else 10_000_000
+    runs = int(sys.argv[2]) if len(sys.argv) > 2 else 5
+
+    print(f"numpy {numpy.__version__}, medijana od {runs} ponavljanja")
+    print(f"{'tip':<8} {'veličina':>11} {'operacija':<10} {'numpy ms':>11} {'radixsort ms':>13} {'ubrzanje':>9}")
+
+    rng = numpy.random.default_rng(46)
+    for dtype in DTYPES:
+        for size in SIZES:
+            if size > max_size:
+                break
+            original = make_keys(dtype, size, rng)
+            payload = numpy.arange(size, dtype=numpy.int64)
+
+            cases = (
+                ("sort",
+                 lambda: (original.copy(),), lambda a: a.sort(),
+                 lambda: (original.copy(),), radixsort.sort),
+                ("argsort",
+                 lambda: (original,), lambda a: numpy.argsort(a, kind="stable"),
+                 lambda: (original,), radixsort.argsort),
+                ("key/value",
+                 lambda: (original.copy(), payload.copy()), numpy_pairs,
+                 lambda: (original.copy(), payload.copy()), radixsort.sort_pairs),
+            )
+            for name, prepare_numpy, run_numpy, prepare_radix, run_radix in cases:
+                numpy_ms = measure(runs, prepare_numpy, run_numpy)
+                radix_ms = measure(runs, prepare_radix, run_radix)
+                print(f"{dtype:<8} {size:>11} {name:<10} {numpy_ms:>11.2f} {radix_ms:>13.2f} {numpy_ms / radix_ms:>8.2f}x")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,93 @@
+# ============================================================================
+# compare.awk: poređenje izlaza benchmark-a za više varijanti biblioteke
+# ============================================================================
+#
+# Prvi fajl je osnovna varijanta (baseline), ostali se porede sa njom.
+# Red benchmark-a ima fiksne kolone (printf u benchmark.c):
+#     raspodela(12) veličina(12) varijanta(26) medijana(12)  ostatak
+# pa se ključ i vreme čitaju po pozicijama bajtova (LC_ALL=C).
+#
+# Ispis: medijana u ms i odnos baseline / varijanta (> 1 = brže), na kraju
+# geometrijska sredina odnosa. qsort ne koristi biblioteku, pa ostaje u
+# tabeli kao kontrolni red za šum, ali ne ulazi u sredinu.
+#
+# ============================================================================
+
+FNR == 1 {
+	file++
+	name = FILENAME
+	sub(/^.*\//, "", name)
+	sub(/\.txt$/, "", name)
+	names[file] = name
+	next
+}
+
+{
+	key = substr($0, 1, 52)
+	sub(/ +$/, "", key)
+	if (!(key in seen))
+	{
+		seen[key] = 1
+		order[++rows] = key
+	}
+	if (index($0, "GREŠKA") > 0)
+	{
+		ms[file, key] = -1
+	}
+	else
+	{
+		ms[file, key] = substr($0, 53, 13) + 0
+	}
+}
+
+END {
+	printf "%-52s", "raspodela / veličina / varijanta"
+	for (f = 1; f <= file; f++)
+	{
+		printf " %16s", names[f]
+	}
+	printf "\n"
+
+	for (r = 1; r <= rows; r++)
+	{
+		key = order[r]
+		base = ms[1, key]
+		printf "%-52s", key
+		for (f = 1; f <= file; f++)
+		{
+			t = ms[f, key]
+			if (((f, key) in ms) == 0 || t < 0)
+			{
+				printf " %16s", "-"
+			}
+			else if (f == 1 || base <= 0 || t <= 0)
+			{
+				printf " %16.2f", t
+			}
+			else
+			{
+				printf " %9.2f %5.2fx", t, base / t
+				if (key !~ / qsort$/)
+				{
+					logSum[f] += log(base / t)
+					logCount[f]++
+				}
+			}
+		}
+		printf "\n"
+	}
+
+	printf "%-52s %16s", "geometrijska sredina ubrzanja (bez qsort)", "1.00x"
+	for (f = 2; f <= file; f++)
+	{
+		if (logCount[f] > 0)
+		{
+			printf " %15.2fx", exp(logSum[f] / logCount[f])
+		}
+		else
+		{
+			printf " %16s", "-"
+		}
+	}
+	printf "\n"
+}
@@ -51,6 +51,7 @@
  *     - radix_sort.h - interfejs modula
  *     - test_functions.c - test funkcije
  *     - test_functions.h - interfejs test modula
+ *     - benchmark.c - merenje performansi (odvojen program)
  *     - libradixsort.a - statička biblioteka (Radix Sort)
  * 
  *
@@ -106,8 +107,11 @@
  *     ar -rs libradixsort.a radix_sort.o
  *     gcc -std=c23 -pedantic -Wall -static main.c test_functions.c -L. -lradixsort -o a.out
  *
+ *     ili preko Makefile-a (optimizovana biblioteka, testovi, PGO/LTO varijante):
+ *     make && make check
+ *
  * TESTIRANJE:
- *     Program automatski izvršava 15 test slučajeva:
+ *     Program automatski izvršava 37 test slučajeva:
  *     1. Pozitivni brojevi
  *     2. Negativni brojevi
  *     3. Mešoviti (pozitivni i negativni)
@@ -123,6 +127,28 @@
  *     13. Jedan element (dodatni granični slučaj)
  *     14. Već sortiran niz sa negativima (testira stabilnost transformacije)
  *     15. Svi isti elementi (testira stabilnost algoritma)
+ *     16. Milion elemenata (performanse)
+ *     17. Huge stranice za scratch bafere (statistika alokacije)
+ *     18. Višenitno sortiranje (sa i bez NUMA pinovanja)
+ *     19. Batch sortiranje mnogo malih nizova
+ *     20. Segmentirano sortiranje (niz + tabela pozicija)
+ *     21. Uzak opseg vrednosti (umanjenje za min, counting sort)
+ *     22. Malo različitih vrednosti (hash brojanje)
+ *     23. Izbacivanje duplikata i brojači (radixSortUnique, radixSortCounts)
+ *     24. Keš-blokirano sortiranje velikog niza (MSD + LSD po bucket-u)
+ *     25. Sortiranje u drugi niz (radixSortCopy)
+ *     26. Kontekst sa trajnim pool-om thread-ova (RadixSortContext)
+ *     27. Asinhrono sortiranje (radixSortAsync / Wait / Poll)
+ *     28. Zapakovan sortiran izlaz (delta + pakovanje bitova)
+ *     29. Ulaz od nekoliko sortiranih delova (k-way spajanje)
+ *     30. Sortiranje više kolona (radixSortColumns / radixGather)
+ *     31. Sortiranje zapisa po int32_t polju (radixSortRecords)
+ *     32. Sortiranje sa limitom pomoćne memorije (radixSortBudget)
+ *     33. Kvantili iz histograma bez sortiranja (radixQuantiles)
+ *     34. Keš pomoćnih bafera po thread-u (threadCacheBytes)
+ *     35. Sortiranje stringova, MSD po bajtovima (radixSortStrings)
+ *     36. Ključevi fiksne dužine, LSD / MSD (radixSortKeysN)
+ *     37. Profil mašine (radixSortLoadProfile / radixsort_tune)
  * 
  * Svrha testova je kompletna verifikacija:
  * - Korektnost sortiranja u različitim scenarijima
@@ -149,6 +175,11 @@ int32_t main(void)
 
 	printf("Pokretanje test slučajeva...\n\n");
 
+	/* Očekivane strategije važe za ugrađene pragove, ne za profil ove mašine */
+	SortProfile defaults;
+	radixSortDefaultProfile(&defaults);
+	(void)radixSortSetProfile(&defaults);
+
 	testPositiveNumbers();
 	testNegativeNumbers();
 	testMixedNumbers();
@@ -170,6 +201,69 @@ int32_t main(void)
 	/* Test za milion elemenata */
 	testMillionElements();
 
+	/* Scratch baferi sa huge stranicama */
+	testHugePageScratch();
+
+	/* Višenitno sortiranje */
+	testParallelSort();
+
+	/* Mnogo malih nizova u jednom pozivu */
+	testBatchSort();
+
+	/* Segmenti jednog niza (CSR) */
+	testSegmentedSort();
+
+	/* Uzak opseg vrednosti */
+	testNarrowRange();
+
+	/* Malo različitih vrednosti */
+	testLowCardinality();
+
+	/* Sortiranje sa izbacivanjem duplikata i brojanjem */
+	testUniqueCounts();
+
+	/* Veliki niz: MSD + LSD po bucket-u u kešu */
+	testCacheBlockedSort();
+
+	/* Sortiranje u drugi niz, ulaz ostaje neizmenjen */
+	testSortCopy();
+
+	/* Kontekst sa trajnim pool-om thread-ova */
+	testSortContext();
+
+	/* Asinhrono sortiranje u pozadinskom pool-u */
+	testSortAsync();
+
+	/* Zapakovan sortiran izlaz */
+	testPackedSort();
+
+	/* Ulaz od nekoliko sortiranih delova */
+	testSortedRuns();
+
+	/* Sortiranje više kolona (permutacija) */
+	testSortColumns();
+
+	/* Sortiranje zapisa po int32_t polju */
+	testSortRecords();
+
+	/* Sortiranje sa limitom pomoćne memorije */
+	testSortBudget();
+
+	/* Kvantili iz histograma, bez sortiranja */
+	testQuantiles();
+
+	/* Keš pomoćnih bafera po thread-u */
+	testThreadCache();
+
+	/* Sortiranje stringova promenljive dužine */
+	testStringSort();
+
+	/* Široki ključevi fiksne dužine (UUID, IPv6) */
+	testKeysN();
+
+	/* Profil mašine iz datoteke (radixsort_tune) */
+	testSortProfile();
+
 	printf("Svi testovi uspešno završeni!\n");
 
 	return 0;
@@ -12,6 +12,10 @@
  *   - Byte-by-byte pristup (baza 256) - sortira 4 bajta za int32_t
  *   - Transformacija za negativne brojeve: XOR sa 0x80000000
  *     (pretvara int32_t u uint32_t gde je sortiranje trivijalno)
+ *   - Scratch baferi poravnati na 2 MB sa huge stranicama kada je moguće
+ *     (manje dTLB promašaja pri nasumičnom 256-way rasipanju)
+ *   - Višenitna varijanta: MSD raspodela po najvišem bajtu koji se menja,
+ *     zatim LSD po bucket-ima, NUMA-svesno pinovanje i first-touch
  *
  * SLOŽENOST:
  *   - Vremenska: O(d * n) = O(4 * n) = O(n) za int32_t
@@ -20,166 +24,6064 @@
  * ============================================================================
  */
 
+#if defined(__linux__)
+#define _GNU_SOURCE /* MAP_HUGETLB, MADV_HUGEPAGE, CPU_SET nisu deo -std=c23 -pedantic */
+#endif
+
 #include "radix_sort.h"
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdatomic.h>
 #include <assert.h>
 #include <string.h>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sched.h>
+#define RADIX_HAVE_HUGEPAGES 1
+#define RADIX_HAVE_AFFINITY 1
+#else
+#define RADIX_HAVE_HUGEPAGES 0
+#define RADIX_HAVE_AFFINITY 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#define RADIX_HAVE_THREADS 1
+#else
+#define RADIX_HAVE_THREADS 0
+#endif
+
+#if defined(__GNUC__)
+#define RADIX_PREFETCH(address) __builtin_prefetch(address) /* nasumična čitanja kod gather-a */
+#else
+#define RADIX_PREFETCH(address) ((void)(address))
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define RADIX_HAVE_SSE2 1 /* dekodiranje zapakovanih blokova, 4 trake odjednom */
+#else
+#define RADIX_HAVE_SSE2 0
+#endif
+
+
+#define RADIX_BITS 8
+#define RADIX_SIZE 256/* 2^8 CPU je građen oko 8-bitnih blokova*/
+#define NUM_PASSES 4 /*int32_t je 4 bajta pa 4 prolaza, svaki prolaz sortira jedan bajt*/
+
+#define HUGE_PAGE_SIZE ((size_t)2U * 1024U * 1024U) /* 2 MB huge stranica (x86-64, ARM64) */
+#define SIGN_BIT 0x80000000U
+
+#define SMALL_SORT_THRESHOLD 32U /* ispod ovoga insertion sort je brži od 256 bucket-a (podrazumevano u profilu) */
+#define PARALLEL_MIN_PER_THREAD ((size_t)1U << 16) /* manje od 64K elemenata po thread-u ne isplati pokretanje thread-a (podrazumevano) */
+#define POOL_MIN_PER_THREAD ((size_t)1U << 14) /* thread iz pool-a se samo budi, pa se isplati i ranije (podrazumevano) */
+#define SEGMENT_BLOCK 16384U /* kratki segmenti se sortiraju zajedno u blokovima koji staju u L2 */
+#define LOWCARD_MIN_SIZE 8192U           /* ispod ovoga uzorkovanje ne isplati */
+#define LOWCARD_SAMPLE 1024U             /* broj elemenata u uzorku */
+#define LOWCARD_SAMPLE_MAX_DISTINCT 384U /* više različitih u uzorku = visoka kardinalnost */
+#define LOWCARD_MAX_DISTINCT 1024U       /* prekid hash brojanja preko ovoga */
+#define LOWCARD_TABLE_BITS 11U
+#define LOWCARD_TABLE_SIZE (1U << LOWCARD_TABLE_BITS) /* popunjenost najviše 50% */
+#define LOWCARD_TABLE_BYTES (LOWCARD_TABLE_SIZE * (sizeof(size_t) + sizeof(uint32_t)))
+#define LOWCARD_SCRATCH_BYTES (LOWCARD_TABLE_BYTES + (2U * LOWCARD_MAX_DISTINCT * sizeof(uint32_t)))
+#define MERGE_MAX_RUNS 16U /* do ovoliko sortiranih delova k-way spajanje je brže od radix prolaza */
+#define DEFAULT_L2_BYTES ((size_t)1024U * 1024U) /* kada se veličina L2 keša ne može pročitati */
+#define PACK_BLOCK 128U       /* elemenata po zapakovanom bloku */
+#define PACK_LANES 4U         /* trake vertikalnog rasporeda (širina SSE2 registra) */
+#define PACK_MAGIC 0x31505852U /* "RXP1" */
+#define PACK_HEADER_BYTES 24U /* magic, veličina bloka, broj elemenata, broj reči */
+#define PACK_ENTRY_BYTES 8U   /* direktorijum: prvi element + pomeraj bloka u rečima */
+#define RECORD_GATHER_MIN_STRIDE 32U /* od ovoliko bajtova zapis se ne pomera u prolazima, već (ključ, index) */
+#define RECORD_CYCLE_MIN_STRIDE 128U /* od ovoliko bajtova permutacija se primenjuje u mestu (ciklusi) */
+#define GATHER_PREFETCH_DISTANCE 16U /* koliko elemenata unapred se najavljuje nasumično čitanje */
+#define BUDGET_MIN_BYTES (2U * SMALL_SORT_THRESHOLD * sizeof(uint32_t)) /* manji region ne vredi alocirati */
+#define QUANTILE_BITS 16U /* prvi prolaz broji gornjih, drugi donjih 16 bita */
+#define QUANTILE_BUCKETS (1U << QUANTILE_BITS)
+#define QUANTILE_GROUP 8U /* ciljnih bucket-a po drugom prolazu (8 histograma od 256 KB) */
+#define QUANTILE_LANES 4U /* kopija histograma u prvom prolazu */
+#define QUANTILE_COPY_MAX_SIZE 65536U /* do ovoliko elemenata kvantili se čitaju iz sortirane kopije */
+#define QUANTILE_NO_SLOT 0xFFU
+#define QUANTILE_DONE UINT32_MAX /* kvantil je već izračunat */
+#define SCRATCH_CACHE_SLOTS 3U        /* najviše bafera istovremeno u jednom pozivu (radixSortRecords) */
+#define SCRATCH_CACHE_TRIM_CALLS 64U  /* prozor za high-water mark keša */
+#define STRING_CACHE_CHARS 7U        /* znakova u keš reči stringa, najniži bajt je broj preostalih */
+#define STRING_SMALL_THRESHOLD 64U    /* manja grupa stringova ide u multikey quicksort */
+#define STRING_INSERTION_THRESHOLD 12U /* manja grupa u multikey quicksort-u ide u insertion sort */
+#define KEYS_HISTOGRAM_MAX_BYTES 16U  /* do ovoliko bajtova ključa svi histogrami se broje u jednom čitanju */
+#define KEYS_LSD_MAX_PASSES 6U        /* više bajtova koji se menjaju: MSD (2-3 nivoa + insertion sort) je brži */
+#define KEYS_LSD_CACHED_PASSES 8U     /* dok ključevi i temp staju u L2, LSD je brži i sa ovoliko prolaza */
+#define WIDE_RADIX_BITS 11U           /* široka cifra: 3 prolaza za 32-bitni ključ umesto 4 */
+#define WIDE_RADIX_SIZE (1U << WIDE_RADIX_BITS)
+#define WIDE_NUM_PASSES 3U
+#define COMBINE_LINE (64U / sizeof(uint32_t)) /* elemenata u baferu bucket-a (jedna keš linija) */
+#define PROFILE_VERSION 1U
+#define PROFILE_SMALL_SORT_MAX 512U   /* insertion sort je O(n^2) - veći prag iz profila se odbija */
+#define PROFILE_MIN_PER_THREAD 1024U  /* manji prag po thread-u se odbija */
+#define PROFILE_LINE_MAX 512U
+#define PROFILE_PATH_MAX 4096U
+#define PROFILE_UNLOADED 0
+#define PROFILE_LOADING 1
+#define PROFILE_READY 2
+#define MAX_THREADS 256U
+#define MAX_NUMA_NODES 64U
+#define MAX_CPUS 1024U
+#define PAGE_TOUCH_STRIDE (4096U / sizeof(uint32_t)) /* jedan upis po 4 KB stranici je dovoljan za first-touch */
+
+/*
+ * Pomoćni bafer zajedno sa informacijom kako je alociran,
+ * jer se hugetlbfs mapiranje oslobađa sa munmap(), a ostalo sa free().
+ */
+typedef struct
+{
+	void* ptr;
+	size_t bytes;       /* zahtevana veličina */
+	size_t mappedBytes; /* veličina zaokružena na HUGE_PAGE_SIZE */
+	SortPageKind pages;
+	bool cached;        /* pripada kešu thread-a: scratchFree ga vraća, ne oslobađa */
+} ScratchBuffer;
+
+/*
+ * Keš pomoćnih bafera jednog thread-a (SortConfig.threadCacheBytes > 0).
+ * Instancu koristi samo thread vlasnik, pa nema zaključavanja ni atomika.
+ */
+typedef struct
+{
+	ScratchBuffer slots[SCRATCH_CACHE_SLOTS]; /* ptr == NULL: prazan slot, bytes je kapacitet */
+	bool inUse[SCRATCH_CACHE_SLOTS];
+	size_t calls;     /* alokacija u tekućem prozoru */
+	size_t highWater; /* najveći zahtev u tekućem prozoru */
+	bool registered;  /* destruktor za kraj thread-a je prijavljen */
+} ScratchCache;
+
+/*
+ * Rezultat prvog čitanja ulaza: opseg i histogrami transformisanih ključeva
+ */
+typedef struct
+{
+	uint32_t min;
+	uint32_t max;
+	size_t hist[NUM_PASSES][RADIX_SIZE];
+	size_t runs; /* broj prirodnih rastućih delova (1 = već sortiran) */
+} KeyScan;
+
+/*
+ * Izlaz za radixSortUnique / radixSortCounts: različite vrednosti se
+ * upisuju na početak niza u poslednjem prolazu, bez posebnog prolaza
+ * posle sortiranja.
+ */
+typedef struct
+{
+	size_t* counts;/*NULL = samo jedinstvene vrednosti, bez brojača*/
+	size_t length;/*broj različitih vrednosti*/
+} DistinctOutput;
+
+/*
+ * Mala hash tabela sa otvorenim adresiranjem: različita vrednost -> broj
+ * pojavljivanja. counts[slot] == 0 označava prazan slot, pa ceo opseg
+ * uint32_t ključeva ostaje upotrebljiv.
+ */
+typedef struct
+{
+	size_t* counts;
+	uint32_t* keys;
+	size_t distinct;
+} CountTable;
+
+/*
+ * Deo batch-a koji sortira jedan thread: nizovi [first, last)
+ */
+typedef struct
+{
+	int32_t** arrays;
+	const size_t* sizes;
+	size_t first;
+	size_t last;
+	ScratchBuffer scratch;
+	SortResult result;
+} BatchTask;
+
+/*
+ * Grupa susednih segmenata koju sortira jedan thread: [firstSeg, lastSeg)
+ */
+typedef struct
+{
+	int32_t* data;
+	const size_t* offsets;
+	size_t firstSeg;
+	size_t lastSeg;
+	ScratchBuffer scratch;
+	SortResult result;
+} SegmentTask;
+
+/*
+ * String u MSD sortiranju: keš reč sa sledećih 7 znakova (big-endian, od
+ * najvišeg bajta) i min(preostalo, 7) u najnižem bajtu, pa se keš reči
+ * porede kao brojevi. index je početna pozicija (stabilnost, permutacija).
+ */
+typedef struct
+{
+	uint64_t cache;
+	const uint8_t* text;
+	uint32_t length;
+	uint32_t index;
+} StringEntry;
+
+static SortConfig g_config = { SORT_HUGEPAGES_AUTO, true, 0U };
+static SortProfile g_profile = { SMALL_SORT_THRESHOLD, 0U, 0U, 0U, 0U, PARALLEL_MIN_PER_THREAD, POOL_MIN_PER_THREAD };
+static atomic_int g_profileState = PROFILE_UNLOADED;/*datoteka profila se čita jednom, pri prvom sortiranju*/
+static _Thread_local SortStats g_lastStats = { 0U, SORT_PAGES_NONE, 1U, 0U, SORT_STRATEGY_NONE, 0U };/*statistika je po thread-u, radixSort ostaje reentrantan*/
+
+static bool scratchAlloc(ScratchBuffer* buffer, size_t bytes);
+static void scratchFree(ScratchBuffer* buffer);
+static bool scratchAllocSystem(ScratchBuffer* buffer, size_t bytes);
+static void scratchFreeSystem(ScratchBuffer* buffer);
+static bool cacheAcquire(ScratchBuffer* buffer, size_t bytes);
+static void cacheRelease(const ScratchBuffer* buffer);
+static void cacheTrim(ScratchCache* cache, size_t limit);
+static bool transparentHugePagesEnabled(void);
+static void recordScratch(const ScratchBuffer* buffer);
+static void resetStats(void);
+static void histogramAllBytes(const uint32_t* arr, size_t size, size_t count[NUM_PASSES][RADIX_SIZE]);
+static void scatterByByte(const uint32_t* arr, size_t size, uint32_t* output, size_t shift, size_t offsets[RADIX_SIZE]);
+static void scatterToInt32(const uint32_t* arr, size_t size, int32_t* output, size_t shift, size_t offsets[RADIX_SIZE], uint32_t base);
+static void scatterFromInt32(const int32_t* arr, size_t size, uint32_t* output, size_t shift, size_t offsets[RADIX_SIZE]);
+static void scatterInt32(const int32_t* arr, size_t size, int32_t* output, size_t shift, size_t offsets[RADIX_SIZE]);
+static void scanKeys(const int32_t* arr, size_t size, KeyScan* scan);
+static void findRuns(const int32_t* arr, size_t size, size_t* starts, size_t runs);
+static void mergeRuns(const int32_t* input, int32_t* output, size_t size, const size_t* starts, size_t runs);
+static size_t significantBytes(uint32_t range);
+static void countingSortRange(const int32_t* input, int32_t* output, size_t size, uint32_t min, uint32_t range, uint32_t* counts, DistinctOutput* distinct);
+static size_t lsdSortKeys(const int32_t* input, int32_t* output, size_t size, const KeyScan* scan, uint32_t* temp1, uint32_t* temp2, DistinctOutput* distinct);
+static size_t scatterToInt32Distinct(const uint32_t* arr, size_t size, int32_t* output, size_t shift, size_t offsets[RADIX_SIZE], uint32_t base, size_t* counts);
+static size_t copyToInt32Distinct(const uint32_t* arr, size_t size, int32_t* output, uint32_t base, size_t* counts);
+static SortResult sortArray(const int32_t* input, int32_t* arr, size_t size, DistinctOutput* distinct);
+static void sortWithBuffers(const int32_t* input, int32_t* arr, size_t size, DistinctOutput* distinct, uint32_t* temp1, uint32_t* temp2);
+static size_t privateCacheBytes(void);
+static bool useCacheBlocked(size_t size, const KeyScan* scan, size_t* partitionByte);
+static void cacheBlockedSort(int32_t* arr, size_t size, const KeyScan* scan, size_t partitionByte, uint32_t* temp1, uint32_t* temp2);
+static void countTableInit(CountTable* table, void* memory);
+static size_t countTableSlot(uint32_t key);
+static bool countTableAdd(CountTable* table, uint32_t key, size_t limit);
+static size_t countTableFind(const CountTable* table, uint32_t key);
+static void lsdSortU32(uint32_t* arr, uint32_t* tmp, size_t size);
+static bool lowCardinalitySort(const int32_t* input, int32_t* output, size_t size, void* scratch, DistinctOutput* distinct);
+static void insertionSortU32(uint32_t* arr, size_t size);
+static void copyToInt32(const uint32_t* arr, size_t size, int32_t* output);
+static void lsdSortToInt32(uint32_t* src, uint32_t* tmp, int32_t* dst, size_t size, size_t numBytes);
+static void insertionSortI32(int32_t* arr, size_t size);
+static void sortWithScratch(int32_t* arr, size_t size, uint32_t* scratch);
+static void sortBatchRange(BatchTask* task);
+static void sortBatchTask(void* context, size_t index);
+static void sortSegmentsGlobal(SegmentTask* task, uint64_t* keys, uint64_t* tmp, size_t* positions);
+static void sortSegmentRange(SegmentTask* task);
+static void sortSegmentTask(void* context, size_t index);
+static size_t chunkStart(size_t size, size_t numThreads, size_t index);
+static void touchPages(uint32_t* buffer, size_t count);
+static void contextFaultTask(void* arg, size_t index);
+static bool contextReserve(RadixSortContext* context, size_t size);
+static void asyncRun(RadixSortHandle* handle);
+static uint32_t bitWidth(uint32_t value);
+static void scatterEntries(const uint64_t* entries, size_t size, uint64_t* output, size_t shift, size_t offsets[RADIX_SIZE]);
+static size_t lsdSortEntries(uint64_t** entries, uint64_t** other, size_t n, size_t count[NUM_PASSES][RADIX_SIZE], uint32_t min, uint32_t max);
+static uint32_t recordKey(const uint8_t* record);
+static void moveRecord(uint8_t* output, const uint8_t* input, size_t stride);
+static SortResult sortRecordsMoving(uint8_t* base, size_t n, size_t stride, size_t keyOffset);
+static SortResult sortRecordsByIndex(uint8_t* base, size_t n, size_t stride, size_t keyOffset);
+static void packBlock(const uint32_t* deltas, uint32_t width, uint32_t* words);
+static void unpackBlock(const uint32_t* words, uint32_t width, int32_t first, int32_t* out);
+static bool packedHeader(const uint8_t* packed, size_t bytes, size_t* count, size_t* numBlocks);
+static uint32_t packedBlock(const uint8_t* packed, size_t numBlocks, size_t block, int32_t* first, const uint32_t** words);
+static void asyncFree(RadixSortHandle* handle);
+static size_t budgetFootprint(size_t bytes);
+static size_t lowerBound(const int32_t* arr, size_t size, int32_t value);
+static size_t upperBound(const int32_t* arr, size_t size, int32_t value);
+static void rotateBlocks(int32_t* arr, size_t len1, size_t len2, int32_t* buf, size_t bufLen);
+static void mergeInPlace(int32_t* arr, size_t len1, size_t len2, int32_t* buf, size_t bufLen);
+static SortResult selectQuantiles(const int32_t* data, size_t n, const double* qs, size_t numQs, double epsilon, int32_t* out, double* mean);
+static uint64_t stringCache(const StringEntry* entry, size_t depth);
+static uint64_t loadStringCaches(StringEntry* entries, size_t n, size_t depth);
+static void insertionSortStrings(StringEntry* entries, size_t n);
+static void multikeyQuicksort(StringEntry* entries, size_t n, size_t depth, bool loaded);
+static void msdSortStrings(StringEntry* entries, StringEntry* temp, size_t n, size_t depth, size_t byteIndex, size_t* refills);
+static void sortStringEntries(StringEntry* entries, StringEntry* temp, size_t n);
+static uint64_t keyWord(const uint8_t* key, size_t rest);
+static bool keyGreater(const uint8_t* a, const uint8_t* b, size_t rest);
+static void insertionSortKeys(uint8_t* keys, uint8_t* temp, size_t n, size_t keyBytes, size_t depth);
+static void lsdSortKeysN(uint8_t* keys, uint8_t* temp, size_t n, size_t keyBytes, size_t (*count)[RADIX_SIZE], const size_t* active, size_t numActive);
+static void msdSortKeysN(uint8_t* keys, uint8_t* temp, size_t n, size_t keyBytes, size_t depth, size_t level, size_t* maxLevel);
+static const SortProfile* activeProfile(void);
+static bool profileValid(const SortProfile* profile);
+static bool profilePath(const char* path, char* buffer, size_t capacity);
+static void hostCpuModel(char* buffer, size_t capacity);
+static char* trimSpaces(char* text);
+static SortResult profileRead(const char* path, SortProfile* profile);
+static void scatterByByteCombined(const uint32_t* arr, size_t size, uint32_t* output, size_t shift, size_t offsets[RADIX_SIZE]);
+static bool useWideDigits(size_t size, const KeyScan* scan);
+static size_t lsdSortWide(const int32_t* input, int32_t* output, size_t size, uint32_t base, uint32_t* temp1, uint32_t* temp2);
+
+/*
+ * Pomoćna funkcija: Da li kernel uopšte daje transparentne huge stranice
+ *
+ * Čita /sys/kernel/mm/transparent_hugepage/enabled jednom i pamti rezultat.
+ * Ako je THP isključen ("[never]"), madvise() uspeva ali ne menja ništa,
+ * pa se u statistici ne sme prijaviti da su huge stranice dobijene.
+ */
+static bool transparentHugePagesEnabled(void)
+{
+	static atomic_int cached = -1;/*-1 = još nije pročitano*/
+
+	int state = atomic_load(&cached);
+	if (state < 0)
+	{
+		state = 0;
+#if RADIX_HAVE_HUGEPAGES
+		FILE* file = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+		if (file != NULL)
+		{
+			char line[128] = {0};
+			if (fgets(line, (int)sizeof(line), file) != NULL)
+			{
+				state = (strstr(line, "[never]") == NULL) ? 1 : 0;
+			}
+			(void)fclose(file);
+		}
+#endif
+		atomic_store(&cached, state);
+	}
+
+	return state == 1;
+}
+
+/*
+ * Pomoćna funkcija: Alokacija scratch bafera
+ *
+ * Sa uključenim kešom (SortConfig.threadCacheBytes) bafer do te veličine
+ * se uzima iz keša tekućeg thread-a; inače, ili kada su svi slotovi
+ * zauzeti, alocira se novi (scratchAllocSystem).
+ */
+static bool scratchAlloc(ScratchBuffer* buffer, size_t bytes)
+{
+	assert(buffer != NULL);
+
+	size_t cacheBytes = g_config.threadCacheBytes;
+	if ((cacheBytes > 0U) && (bytes <= cacheBytes) && cacheAcquire(buffer, bytes))
+	{
+		return true;
+	}
+	return scratchAllocSystem(buffer, bytes);
+}
+
+/*
+ * Pomoćna funkcija: Oslobađanje scratch bafera
+ *
+ * Bafer iz keša se vraća u keš. Bezbedno za bafer čija alokacija nije
+ * uspela (ptr == NULL).
+ */
+static void scratchFree(ScratchBuffer* buffer)
+{
+	assert(buffer != NULL);
+
+	if (buffer->cached)
+	{
+		cacheRelease(buffer);
+		buffer->ptr = NULL;
+		buffer->cached = false;
+		return;
+	}
+	scratchFreeSystem(buffer);
+}
+
+/*
+ * Pomoćna funkcija: Nova alokacija scratch bafera (bez keša)
+ *
+ * Za bafere od bar HUGE_PAGE_SIZE bajtova, po politici iz g_config:
+ *   1. mmap(MAP_HUGETLB)  - uspeva samo ako admin rezerviše huge stranice
+ *   2. aligned_alloc(2 MB) + madvise(MADV_HUGEPAGE) - transparentne huge stranice
+ *   3. malloc()           - rezervna varijanta, uvek dostupna
+ * Mali baferi idu direktno na malloc(), huge stranica bi bila čisto rasipanje.
+ */
+static bool scratchAllocSystem(ScratchBuffer* buffer, size_t bytes)
+{
+	assert(buffer != NULL);
+
+	buffer->ptr = NULL;
+	buffer->bytes = bytes;
+	buffer->mappedBytes = 0U;
+	buffer->pages = SORT_PAGES_NORMAL;
+	buffer->cached = false;
+
+#if RADIX_HAVE_HUGEPAGES
+	SortHugePagePolicy policy = g_config.hugePages;
+
+	if ((policy != SORT_HUGEPAGES_OFF) && (bytes >= HUGE_PAGE_SIZE) && (bytes <= (SIZE_MAX - HUGE_PAGE_SIZE)))
+	{
+		size_t rounded = (bytes + HUGE_PAGE_SIZE - 1U) & ~(HUGE_PAGE_SIZE - 1U);
+
+		if (policy == SORT_HUGEPAGES_AUTO)
+		{
+			void* mapped = mmap(NULL, rounded, PROT_READ | PROT_WRITE,
+			                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (mapped != MAP_FAILED)
+			{
+				buffer->ptr = mapped;
+				buffer->mappedBytes = rounded;
+				buffer->pages = SORT_PAGES_HUGETLB;
+				return true;
+			}
+		}
+
+		/* aligned_alloc zahteva da veličina bude umnožak poravnanja - rounded jeste */
+		void* aligned = aligned_alloc(HUGE_PAGE_SIZE, rounded);
+		if (aligned != NULL)
+		{
+			if ((madvise(aligned, rounded, MADV_HUGEPAGE) == 0) && transparentHugePagesEnabled())
+			{
+				buffer->pages = SORT_PAGES_TRANSPARENT;
+			}
+			buffer->ptr = aligned;
+			return true;
+		}
+	}
+#endif
+
+	buffer->ptr = malloc(bytes);
+	return buffer->ptr != NULL;
+}
+
+/*
+ * Pomoćna funkcija: Oslobađanje bafera iz scratchAllocSystem
+ *
+ * Bezbedno za bafer čija alokacija nije uspela (ptr == NULL).
+ */
+static void scratchFreeSystem(ScratchBuffer* buffer)
+{
+	assert(buffer != NULL);
+
+	if (buffer->ptr == NULL)
+	{
+		return;
+	}
+
+#if RADIX_HAVE_HUGEPAGES
+	if (buffer->pages == SORT_PAGES_HUGETLB)
+	{
+		(void)munmap(buffer->ptr, buffer->mappedBytes);
+		buffer->ptr = NULL;
+		return;
+	}
+#endif
+
+	free(buffer->ptr);
+	buffer->ptr = NULL;
+}
+
+static _Thread_local ScratchCache g_scratchCache;/*keš tekućeg thread-a; zauzeće vidi samo on*/
+
+#if RADIX_HAVE_THREADS
+static pthread_key_t g_cacheKey;
+static pthread_once_t g_cacheKeyOnce = PTHREAD_ONCE_INIT;
+
+/*
+ * Pomoćna funkcija: Oslobađanje keša na kraju thread-a
+ *
+ * Destruktori pthread ključeva se izvršavaju pre oslobađanja
+ * _Thread_local promenljivih, pa je cache još ispravan.
+ */
+static void cacheThreadExit(void* cache)
+{
+	cacheTrim((ScratchCache*)cache, 0U);
+}
+
+static void cacheKeyCreate(void)
+{
+	(void)pthread_key_create(&g_cacheKey, cacheThreadExit);
+}
+#endif /* RADIX_HAVE_THREADS */
+
+/*
+ * Pomoćna funkcija: Bafer od bar bytes bajtova iz keša tekućeg thread-a
+ *
+ * Uzima najmanji slobodan bafer koji je dovoljno velik. Ako takvog nema,
+ * najmanji slobodan slot se oslobađa i alocira na bytes - keš tako raste
+ * do najvećeg zahteva (high-water mark). Na kraju svakog prozora od
+ * SCRATCH_CACHE_TRIM_CALLS alokacija oslobađaju se slobodni baferi veći
+ * od dvostrukog najvećeg zahteva u prozoru, pa jedan izuzetno veliki niz
+ * ne drži memoriju zauvek. Vraća false kada su svi slotovi zauzeti ili
+ * alokacija ne uspe; tada pozivalac alocira mimo keša.
+ */
+static bool cacheAcquire(ScratchBuffer* buffer, size_t bytes)
+{
+	ScratchCache* cache = &g_scratchCache;
+
+	/* Kraj prozora: prvi bafer poziva, pa su baferi prethodnih poziva slobodni */
+	if (cache->calls >= SCRATCH_CACHE_TRIM_CALLS)
+	{
+		cacheTrim(cache, (cache->highWater <= (SIZE_MAX / 2U)) ? (2U * cache->highWater) : SIZE_MAX);
+		cache->calls = 0U;
+		cache->highWater = 0U;
+	}
+
+	cache->calls++;
+	if (bytes > cache->highWater)
+	{
+		cache->highWater = bytes;
+	}
+
+	/* best: najmanji dovoljno velik slobodan bafer; victim: najmanji slobodan slot (prazan ima kapacitet 0) */
+	size_t best = SCRATCH_CACHE_SLOTS;
+	size_t bestCapacity = SIZE_MAX;
+	size_t victim = SCRATCH_CACHE_SLOTS;
+	size_t victimCapacity = SIZE_MAX;
+	for (size_t s = 0; s < SCRATCH_CACHE_SLOTS; s++)
+	{
+		if (cache->inUse[s])
+		{
+			continue;
+		}
+
+		size_t capacity = (cache->slots[s].ptr != NULL) ? cache->slots[s].bytes : 0U;
+		if ((capacity >= bytes) && (cache->slots[s].ptr != NULL) && (capacity < bestCapacity))
+		{
+			best = s;
+			bestCapacity = capacity;
+		}
+		if ((victim == SCRATCH_CACHE_SLOTS) || (capacity < victimCapacity))
+		{
+			victim = s;
+			victimCapacity = capacity;
+		}
+	}
+
+	if (best == SCRATCH_CACHE_SLOTS)
+	{
+		if (victim == SCRATCH_CACHE_SLOTS)
+		{
+			return false;
+		}
+
+		scratchFreeSystem(&cache->slots[victim]);
+		if (!scratchAllocSystem(&cache->slots[victim], bytes))
+		{
+			return false;
+		}
+
+#if RADIX_HAVE_THREADS
+		if (!cache->registered)
+		{
+			(void)pthread_once(&g_cacheKeyOnce, cacheKeyCreate);
+			cache->registered = (pthread_setspecific(g_cacheKey, cache) == 0);
+		}
+#endif
+		best = victim;
+	}
+
+	cache->inUse[best] = true;
+	*buffer = cache->slots[best];
+	buffer->bytes = bytes;
+	buffer->cached = true;
+	return true;
+}
+
+/*
+ * Pomoćna funkcija: Vraćanje bafera u keš
+ */
+static void cacheRelease(const ScratchBuffer* buffer)
+{
+	ScratchCache* cache = &g_scratchCache;
+
+	for (size_t s = 0; s < SCRATCH_CACHE_SLOTS; s++)
+	{
+		if (cache->inUse[s] && (cache->slots[s].ptr == buffer->ptr))
+		{
+			cache->inUse[s] = false;
+			return;
+		}
+	}
+}
+
+/*
+ * Pomoćna funkcija: Oslobađanje slobodnih bafera keša većih od limit bajtova
+ */
+static void cacheTrim(ScratchCache* cache, size_t limit)
+{
+	assert(cache != NULL);
+
+	for (size_t s = 0; s < SCRATCH_CACHE_SLOTS; s++)
+	{
+		if (!cache->inUse[s] && (cache->slots[s].ptr != NULL) && (cache->slots[s].bytes > limit))
+		{
+			scratchFreeSystem(&cache->slots[s]);
+		}
+	}
+}
+
+/*
+ * Pomoćna funkcija: Upis scratch bafera u statistiku tekućeg thread-a
+ *
+ * Kada poziv koristi više bafera, prijavljuje se najslabija vrsta stranica
+ * (ako jedan bafer nije dobio huge stranice, efekat na TLB je delimičan).
+ */
+static void recordScratch(const ScratchBuffer* buffer)
+{
+	assert(buffer != NULL);
+
+	g_lastStats.scratchBytes += buffer->bytes;
+	if ((g_lastStats.pages == SORT_PAGES_NONE) || (buffer->pages < g_lastStats.pages))
+	{
+		g_lastStats.pages = buffer->pages;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Početno stanje statistike za novi poziv
+ */
+static void resetStats(void)
+{
+	g_lastStats.scratchBytes = 0U;
+	g_lastStats.pages = SORT_PAGES_NONE;
+	g_lastStats.threads = 1U;
+	g_lastStats.numaNodes = 0U;
+	g_lastStats.strategy = SORT_STRATEGY_NONE;
+	g_lastStats.passes = 0U;
+}
+
+/*
+ * Pomoćna funkcija: Histogrami sva 4 bajta u jednom čitanju niza
+ *
+ * Umesto da svaki prolaz posebno broji svoj bajt, jedno čitanje puni
+ * sva 4 histograma. Po histogramu se odmah vidi i koji bajt je isti za
+ * sve elemente - takav prolaz ne menja redosled i preskače se.
+ */
+static void histogramAllBytes(const uint32_t* arr, size_t size, size_t count[NUM_PASSES][RADIX_SIZE])
+{
+	assert(arr != NULL);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = arr[i];
+		count[0][value & 0xFFU]++;
+		count[1][(value >> 8) & 0xFFU]++;
+		count[2][(value >> 16) & 0xFFU]++;
+		count[3][value >> 24]++;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Stabilno rasipanje po bajtu sa unapred poznatim pozicijama
+ *
+ * offsets[d] je pozicija prvog elementa sa cifrom d u output nizu
+ * (ekskluzivna prefiksna suma histograma). Niz offsets se menja.
+ * Ide unapred, pa je stabilnost očuvana bez obrnutog prolaza.
+ */
+static void scatterByByte(const uint32_t* arr, size_t size, uint32_t* output, size_t shift, size_t offsets[RADIX_SIZE])
+{
+	assert(arr != NULL);
+	assert(output != NULL);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = arr[i];
+		size_t digit = (value >> shift) & 0xFFU;
+		output[offsets[digit]] = value;
+		offsets[digit]++;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Rasipanje po bajtu kroz bafere po bucket-u
+ *
+ * Isto kao scatterByByte, ali svaki bucket ima bafer od jedne keš linije;
+ * pun bafer se kopira u output odjednom (softversko write-combining).
+ * Umesto 256 tokova pojedinačnih upisa u memoriju ide po jedna cela
+ * linija, poravnata na liniju u output-u - prvi bafer bucket-a se zato
+ * puni od pozicije na kojoj bucket počinje unutar linije.
+ */
+static void scatterByByteCombined(const uint32_t* arr, size_t size, uint32_t* output, size_t shift, size_t offsets[RADIX_SIZE])
+{
+	assert(arr != NULL);
+	assert(output != NULL);
+
+	_Alignas(64) uint32_t lines[RADIX_SIZE][COMBINE_LINE];
+	size_t fill[RADIX_SIZE];
+	size_t start[RADIX_SIZE];
+	for (size_t d = 0; d < RADIX_SIZE; d++)
+	{
+		start[d] = ((uintptr_t)&output[offsets[d]] / sizeof(uint32_t)) % COMBINE_LINE;
+		fill[d] = start[d];
+	}
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = arr[i];
+		size_t digit = (value >> shift) & 0xFFU;
+		lines[digit][fill[digit]] = value;
+		fill[digit]++;
+		if (fill[digit] == COMBINE_LINE)
+		{
+			size_t begin = start[digit];
+			if (begin == 0U)
+			{
+				(void)memcpy(&output[offsets[digit]], lines[digit], sizeof(lines[digit]));
+			}
+			else
+			{
+				(void)memcpy(&output[offsets[digit]], &lines[digit][begin], (COMBINE_LINE - begin) * sizeof(uint32_t));
+				start[digit] = 0U;
+			}
+			offsets[digit] += COMBINE_LINE - begin;
+			fill[digit] = 0U;
+		}
+	}
+
+	for (size_t d = 0; d < RADIX_SIZE; d++)
+	{
+		size_t count = fill[d] - start[d];
+		(void)memcpy(&output[offsets[d]], &lines[d][start[d]], count * sizeof(uint32_t));
+		offsets[d] += count;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Poslednje rasipanje, direktno u int32_t odredište
+ *
+ * Isto kao scatterByByte, ali usput vraća oduzetu bazu i sign bit
+ * ((value + base) XOR SIGN_BIT), pa posle poslednjeg prolaza nije
+ * potrebna posebna transformacija nazad.
+ */
+static void scatterToInt32(const uint32_t* arr, size_t size, int32_t* output, size_t shift, size_t offsets[RADIX_SIZE], uint32_t base)
+{
+	assert(arr != NULL);
+	assert(output != NULL);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = arr[i];
+		size_t digit = (value >> shift) & 0xFFU;
+		output[offsets[digit]] = (int32_t)((value + base) ^ SIGN_BIT);
+		offsets[digit]++;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Poslednje rasipanje koje odmah izbacuje duplikate
+ *
+ * U poslednjem prolazu elementi svakog bucket-a stižu već sortirani, pa je
+ * duplikat uvek jednak poslednjem upisanom elementu tog bucket-a. Umesto
+ * upisa povećava se njegov brojač (counts je indeksiran istim pozicijama
+ * kao output, NULL = bez brojača). Na kraju se bucket-i spoje; pomeraju
+ * se samo bucket-i posle prvog duplikata, ne ceo niz.
+ *
+ * Vraća broj različitih vrednosti, koje su na početku output-a.
+ */
+static size_t scatterToInt32Distinct(const uint32_t* arr, size_t size, int32_t* output, size_t shift, size_t offsets[RADIX_SIZE], uint32_t base, size_t* counts)
+{
+	assert(arr != NULL);
+	assert(output != NULL);
+
+	size_t starts[RADIX_SIZE];
+	(void)memcpy(starts, offsets, sizeof(starts));
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = arr[i];
+		size_t digit = (value >> shift) & 0xFFU;
+		int32_t key = (int32_t)((value + base) ^ SIGN_BIT);
+		size_t position = offsets[digit];
+
+		if ((position > starts[digit]) && (output[position - 1U] == key))
+		{
+			if (counts != NULL)
+			{
+				counts[position - 1U]++;
+			}
+			continue;
+		}
+
+		output[position] = key;
+		if (counts != NULL)
+		{
+			counts[position] = 1U;
+		}
+		offsets[digit] = position + 1U;
+	}
+
+	size_t length = 0;
+	for (size_t d = 0; d < RADIX_SIZE; d++)
+	{
+		size_t bucketLength = offsets[d] - starts[d];
+		if ((bucketLength > 0U) && (starts[d] != length))
+		{
+			(void)memmove(&output[length], &output[starts[d]], bucketLength * sizeof(int32_t));
+			if (counts != NULL)
+			{
+				(void)memmove(&counts[length], &counts[starts[d]], bucketLength * sizeof(size_t));
+			}
+		}
+		length += bucketLength;
+	}
+
+	return length;
+}
+
+/*
+ * Pomoćna funkcija: Kopija sortiranog niza u int32_t bez duplikata
+ *
+ * Za slučaj kada je jedini prolaz već upisao sortirane ključeve u scratch.
+ */
+static size_t copyToInt32Distinct(const uint32_t* arr, size_t size, int32_t* output, uint32_t base, size_t* counts)
+{
+	assert(arr != NULL);
+	assert(output != NULL);
+
+	size_t length = 0;
+	for (size_t i = 0; i < size; i++)
+	{
+		if ((i > 0U) && (arr[i] == arr[i - 1U]))
+		{
+			if (counts != NULL)
+			{
+				counts[length - 1U]++;
+			}
+			continue;
+		}
+
+		output[length] = (int32_t)((arr[i] + base) ^ SIGN_BIT);
+		if (counts != NULL)
+		{
+			counts[length] = 1U;
+		}
+		length++;
+	}
+
+	return length;
+}
+
+/*
+ * Pomoćna funkcija: Rasipanje iz int32_t ulaza u drugi int32_t niz
+ *
+ * Za jedini prolaz kada ulaz i izlaz nisu isti niz - vrednosti se
+ * upisuju neizmenjene, cifra se čita iz transformisanog ključa.
+ */
+static void scatterInt32(const int32_t* arr, size_t size, int32_t* output, size_t shift, size_t offsets[RADIX_SIZE])
+{
+	assert(arr != NULL);
+	assert(output != NULL);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		size_t digit = (((uint32_t)arr[i] ^ SIGN_BIT) >> shift) & 0xFFU;
+		output[offsets[digit]] = arr[i];
+		offsets[digit]++;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Prvo rasipanje, direktno iz int32_t ulaza
+ *
+ * Transformacija (XOR sa SIGN_BIT) se radi u letu, pa nije potreban
+ * poseban prolaz koji samo prepisuje ulaz u scratch bafer.
+ */
+static void scatterFromInt32(const int32_t* arr, size_t size, uint32_t* output, size_t shift, size_t offsets[RADIX_SIZE])
+{
+	assert(arr != NULL);
+	assert(output != NULL);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = (uint32_t)arr[i] ^ SIGN_BIT;
+		size_t digit = (value >> shift) & 0xFFU;
+		output[offsets[digit]] = value;
+		offsets[digit]++;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Insertion sort za male nizove transformisanih ključeva
+ *
+ * Za manje od SMALL_SORT_THRESHOLD elemenata histogrami od 256 bucket-a
+ * koštaju više od samog sortiranja.
+ */
+static void insertionSortU32(uint32_t* arr, size_t size)
+{
+	assert(arr != NULL);
+
+	for (size_t i = 1; i < size; i++)
+	{
+		uint32_t key = arr[i];
+		size_t j = i;
+		while ((j > 0U) && (arr[j - 1U] > key))
+		{
+			arr[j] = arr[j - 1U];
+			j--;
+		}
+		arr[j] = key;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Kopiranje transformisanih ključeva nazad u int32_t
+ */
+static void copyToInt32(const uint32_t* arr, size_t size, int32_t* output)
+{
+	assert(arr != NULL);
+	assert(output != NULL);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		output[i] = (int32_t)(arr[i] ^ SIGN_BIT);
+	}
+}
+
+/*
+ * Pomoćna funkcija: Insertion sort direktno nad int32_t
+ *
+ * Za male nizove koji se ne prebacuju u scratch (npr. u batch-u).
+ */
+static void insertionSortI32(int32_t* arr, size_t size)
+{
+	assert(arr != NULL);
+
+	for (size_t i = 1; i < size; i++)
+	{
+		int32_t key = arr[i];
+		size_t j = i;
+		while ((j > 0U) && (arr[j - 1U] > key))
+		{
+			arr[j] = arr[j - 1U];
+			j--;
+		}
+		arr[j] = key;
+	}
+}
+
+/*
+ * Pomoćna funkcija: First-touch - jedan upis po stranici
+ *
+ * Linux fizičku stranicu dodeljuje na čvoru thread-a koji je prvi upiše.
+ */
+static void touchPages(uint32_t* buffer, size_t count)
+{
+	for (size_t i = 0; i < count; i += PAGE_TOUCH_STRIDE)
+	{
+		buffer[i] = 0U;
+	}
+}
+
+/* Početak dela niza koji čita thread index (ravnomerna podela) */
+static size_t chunkStart(size_t size, size_t numThreads, size_t index)
+{
+	return (size / numThreads) * index + ((size % numThreads) * index) / numThreads;
+}
+
+/*
+ * Pomoćna funkcija: LSD sortiranje po nižih numBytes bajtova
+ *
+ * src sadrži transformisane ključeve, tmp je drugi bafer iste veličine,
+ * rezultat (vraćen u int32_t) ide u dst. Viši bajtovi moraju biti isti za
+ * sve elemente (npr. jedan bucket posle MSD raspodele). Prolazi po bajtovima
+ * koji su isti za sve elemente se preskaču, poslednji prolaz piše direktno
+ * u dst. Sadržaj src i tmp se menja.
+ */
+static void lsdSortToInt32(uint32_t* src, uint32_t* tmp, int32_t* dst, size_t size, size_t numBytes)
+{
+	assert(src != NULL);
+	assert(tmp != NULL);
+	assert(dst != NULL);
+	assert(numBytes <= NUM_PASSES);
+
+	if (size <= SMALL_SORT_THRESHOLD)
+	{
+		insertionSortU32(src, size);
+		copyToInt32(src, size, dst);
+		return;
+	}
+
+	size_t count[NUM_PASSES][RADIX_SIZE] = {{0}};
+	histogramAllBytes(src, size, count);
+
+	size_t active[NUM_PASSES];
+	size_t numActive = 0;
+	for (size_t b = 0; b < numBytes; b++)
+	{
+		size_t digit = (src[0] >> (b * RADIX_BITS)) & 0xFFU;
+		if (count[b][digit] != size)/*ako su svi u jednom bucket-u, prolaz ništa ne menja*/
+		{
+			active[numActive] = b;
+			numActive++;
+		}
+	}
+
+	if (numActive == 0U)
+	{
+		copyToInt32(src, size, dst);
+		return;
+	}
+
+	uint32_t* input = src;
+	uint32_t* output = tmp;
+
+	for (size_t p = 0; p < numActive; p++)
+	{
+		size_t b = active[p];
+		size_t offsets[RADIX_SIZE];
+		size_t sum = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			offsets[d] = sum;
+			sum += count[b][d];
+		}
+
+		if (p + 1U == numActive)
+		{
+			scatterToInt32(input, size, dst, b * RADIX_BITS, offsets, 0U);
+		}
+		else
+		{
+			scatterByByte(input, size, output, b * RADIX_BITS, offsets);
+			uint32_t* swap = input;
+			input = output;
+			output = swap;
+		}
+	}
+}
+
+/*
+ * Pomoćna funkcija: Da li LSD ide sa 11-bitnim ciframa (lsdSortWide)
+ *
+ * Samo za ključeve kojima se posle umanjenja za min menjaju sva 4 bajta
+ * (4 prolaza po bajtu postaju 3) i samo u opsegu veličina iz profila:
+ * 2048 bucket-a znači 2048 tokova upisa, pa se isplati tek kada ušteđen
+ * prolaz vredi više od promašaja u kešu i TLB-u, a to zavisi od mašine.
+ */
+static bool useWideDigits(size_t size, const KeyScan* scan)
+{
+	const SortProfile* profile = activeProfile();
+
+	return (profile->wideDigitMaxSize != 0U) && (size >= profile->wideDigitMinSize) &&
+	       (size <= profile->wideDigitMaxSize) && (significantBytes(scan->max - scan->min) == NUM_PASSES);
+}
+
+/*
+ * Pomoćna funkcija: LSD sa 11-bitnim ciframa
+ *
+ * Ključevi umanjeni za base staju u 32 bita, pa su dovoljna 3 prolaza
+ * (11 + 11 + 10 bita). Histogrami od 2048 bucket-a se broje u posebnom
+ * čitanju (scanKeys broji po bajtovima). Prvi prolaz čita input, poslednji
+ * piše u output, pa input i output smeju biti isti niz; jedan od
+ * temp1/temp2 sme biti sam output. Vraća broj prolaza.
+ */
+static size_t lsdSortWide(const int32_t* input, int32_t* output, size_t size, uint32_t base, uint32_t* temp1, uint32_t* temp2)
+{
+	assert(input != NULL);
+	assert(output != NULL);
+
+	/* Poslednji prolaz čita second, pa second ne sme biti output */
+	uint32_t* first = temp1;
+	uint32_t* second = temp2;
+	if ((void*)temp2 == (void*)output)
+	{
+		first = temp2;
+		second = temp1;
+	}
+
+	const uint32_t mask = WIDE_RADIX_SIZE - 1U;
+	size_t count[WIDE_NUM_PASSES][WIDE_RADIX_SIZE];
+	(void)memset(count, 0, sizeof(count));
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = ((uint32_t)input[i] ^ SIGN_BIT) - base;
+		count[0][value & mask]++;
+		count[1][(value >> WIDE_RADIX_BITS) & mask]++;
+		count[2][value >> (2U * WIDE_RADIX_BITS)]++;
+	}
+
+	for (size_t p = 0; p < WIDE_NUM_PASSES; p++)
+	{
+		size_t sum = 0;
+		for (size_t d = 0; d < WIDE_RADIX_SIZE; d++)
+		{
+			size_t bucket = count[p][d];
+			count[p][d] = sum;/*brojač postaje početak bucket-a*/
+			sum += bucket;
+		}
+	}
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = ((uint32_t)input[i] ^ SIGN_BIT) - base;
+		first[count[0][value & mask]] = value;
+		count[0][value & mask]++;
+	}
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = first[i];
+		size_t digit = (value >> WIDE_RADIX_BITS) & mask;
+		second[count[1][digit]] = value;
+		count[1][digit]++;
+	}
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = second[i];
+		size_t digit = value >> (2U * WIDE_RADIX_BITS);
+		output[count[2][digit]] = (int32_t)((value + base) ^ SIGN_BIT);
+		count[2][digit]++;
+	}
+
+	return WIDE_NUM_PASSES;
+}
+
+/*
+ * Pomoćna funkcija: Prvo čitanje ulaza
+ *
+ * Jedno čitanje daje minimum i maksimum transformisanih ključeva i
+ * histograme sva 4 bajta. Po opsegu (max - min) bira se strategija,
+ * a za pun opseg histogrami služe za sve prolaze bez ponovnog brojanja.
+ * Usput se broje prirodni rastući delovi (svaki pad započinje novi deo).
+ */
+static void scanKeys(const int32_t* arr, size_t size, KeyScan* scan)
+{
+	assert(arr != NULL);
+	assert(scan != NULL);
+	assert(size > 0U);
+
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+	uint32_t previous = 0;
+	size_t runs = 1;
+	(void)memset(scan->hist, 0, sizeof(scan->hist));
+
+	for (size_t i = 0; i < size; i++)
+	{
+		uint32_t value = (uint32_t)arr[i] ^ SIGN_BIT;
+		min = (value < min) ? value : min;
+		max = (value > max) ? value : max;
+		runs += (value < previous) ? 1U : 0U; /* bez grananja - za slučajan ulaz pad je u pola slučajeva */
+		previous = value;
+		scan->hist[0][value & 0xFFU]++;
+		scan->hist[1][(value >> 8) & 0xFFU]++;
+		scan->hist[2][(value >> 16) & 0xFFU]++;
+		scan->hist[3][value >> 24]++;
+	}
+
+	scan->min = min;
+	scan->max = max;
+	scan->runs = runs;
+}
+
+/*
+ * Pomoćna funkcija: Početci rastućih delova (starts ima runs + 1 mesta)
+ *
+ * Poziva se samo kada je scanKeys našao najviše MERGE_MAX_RUNS delova,
+ * pa je grana retka i predvidiva.
+ */
+static void findRuns(const int32_t* arr, size_t size, size_t* starts, size_t runs)
+{
+	size_t count = 1;
+	starts[0] = 0;
+	for (size_t i = 1; i < size; i++)
+	{
+		if (arr[i] < arr[i - 1U])
+		{
+			starts[count] = i;
+			count++;
+		}
+	}
+	assert(count == runs);
+	starts[runs] = size;
+}
+
+/*
+ * Pomoćna funkcija: k-way spajanje sortiranih delova turnirskim stablom
+ *
+ * Stablo gubitnika: unutrašnji čvor čuva deo koji je izgubio poređenje
+ * u tom čvoru, top je pobednik. Posle upisa pobednika ponavljaju se samo
+ * poređenja na putu od njegovog lista do korena - log2(k) po elementu,
+ * uvek sa istim čvorovima koji su u L1. Ključ pobednika ostaje u
+ * registru, pa je jedini serijski lanac poređenje + uslovni izbor po
+ * nivou. Iscrpljen deo ima glavu INT64_MAX, pa nikad ne pobeđuje.
+ * starts ima runs + 1 elemenata. Dva dela se spajaju bez stabla.
+ */
+static void mergeRuns(const int32_t* input, int32_t* output, size_t size, const size_t* starts, size_t runs)
+{
+	assert(runs >= 2U);
+	assert(runs <= MERGE_MAX_RUNS);
+
+	if (runs == 2U)
+	{
+		/* Dva dela: obično spajanje bez grananja, bez stabla */
+		const int32_t* left = input;
+		const int32_t* leftEnd = input + starts[1];
+		const int32_t* right = leftEnd;
+		const int32_t* rightEnd = input + size;
+		size_t i = 0;
+		while ((left < leftEnd) && (right < rightEnd))
+		{
+			bool takeRight = (*right < *left);
+			output[i] = takeRight ? *right : *left;
+			right += takeRight ? 1 : 0;
+			left += takeRight ? 0 : 1;
+			i++;
+		}
+		(void)memcpy(output + i, (left < leftEnd) ? left : right,
+		             (size - i) * sizeof(int32_t));
+		return;
+	}
+
+	size_t leaves = 1U;
+	while (leaves < runs)
+	{
+		leaves <<= 1;
+	}
+
+	const int32_t* cursor[MERGE_MAX_RUNS];
+	const int32_t* limit[MERGE_MAX_RUNS];
+	int64_t head[MERGE_MAX_RUNS];
+	for (size_t r = 0; r < leaves; r++)
+	{
+		cursor[r] = input + ((r < runs) ? starts[r] : 0U);
+		limit[r] = input + ((r < runs) ? starts[r + 1U] : 0U);
+		head[r] = (r < runs) ? (int64_t)*cursor[r] : INT64_MAX;
+	}
+
+	/* Izgradnja odozdo: winner[n] je pobednik podstabla n */
+	size_t tree[MERGE_MAX_RUNS];
+	size_t winner[2U * MERGE_MAX_RUNS];
+	for (size_t r = 0; r < leaves; r++)
+	{
+		winner[leaves + r] = r;
+	}
+	for (size_t n = leaves - 1U; n > 0U; n--)
+	{
+		size_t left = winner[2U * n];
+		size_t right = winner[(2U * n) + 1U];
+		bool leftWins = (head[left] <= head[right]);
+		winner[n] = leftWins ? left : right;
+		tree[n] = leftWins ? right : left;
+	}
+	size_t top = winner[1];
+	int64_t key = head[top];
+
+	for (size_t i = 0; i < size; i++)
+	{
+		output[i] = (int32_t)key;
+		cursor[top]++;
+		key = (cursor[top] < limit[top]) ? (int64_t)*cursor[top] : INT64_MAX;
+		head[top] = key;
+
+		/* Poređenja su nepredvidiva kada se delovi prepliću - bez grananja */
+		for (size_t n = (top + leaves) >> 1; n > 0U; n >>= 1)
+		{
+			size_t loser = tree[n];
+			int64_t loserKey = head[loser];
+			size_t mask = (size_t)0U - (size_t)(loserKey < key); /* maska, jer gcc ternarni izbor pretvara u skok */
+			size_t swapped = (top ^ loser) & mask;
+			tree[n] = loser ^ swapped;
+			top ^= swapped;
+			key ^= (key ^ loserKey) & (int64_t)mask;
+		}
+	}
+}
+
+/* Broj bajtova potrebnih za vrednosti [0, range] */
+static size_t significantBytes(uint32_t range)
+{
+	size_t bytes = 0;
+	while (range != 0U)
+	{
+		range >>= RADIX_BITS;
+		bytes++;
+	}
+	return bytes;
+}
+
+/*
+ * Pomoćna funkcija: Direktan counting sort za uzak opseg
+ *
+ * counts mora imati mesta za range + 1 brojača. Jedno brojanje i jedno
+ * sekvencijalno popunjavanje izlaza - za jednake int32_t vrednosti
+ * redosled nije vidljiv, pa stabilnost nije pitanje.
+ */
+static void countingSortRange(const int32_t* input, int32_t* output, size_t size, uint32_t min, uint32_t range, uint32_t* counts, DistinctOutput* distinct)
+{
+	assert(input != NULL);
+	assert(output != NULL);
+	assert(counts != NULL);
+
+	(void)memset(counts, 0, ((size_t)range + 1U) * sizeof(uint32_t));
+
+	for (size_t i = 0; i < size; i++)
+	{
+		counts[((uint32_t)input[i] ^ SIGN_BIT) - min]++;
+	}
+
+	size_t position = 0;
+	for (size_t v = 0; v <= (size_t)range; v++)
+	{
+		int32_t value = (int32_t)(((uint32_t)v + min) ^ SIGN_BIT);
+		if (distinct != NULL)
+		{
+			/* Brojači su već tu - jedna vrednost po brojaču različitom od 0 */
+			if (counts[v] != 0U)
+			{
+				output[position] = value;
+				if (distinct->counts != NULL)
+				{
+					distinct->counts[position] = counts[v];
+				}
+				position++;
+			}
+			continue;
+		}
+
+		for (uint32_t c = counts[v]; c > 0U; c--)
+		{
+			output[position] = value;
+			position++;
+		}
+	}
+
+	if (distinct != NULL)
+	{
+		distinct->length = position;
+	}
+}
+
+/*
+ * Pomoćna funkcija: LSD prolazi od int32_t ulaza do int32_t izlaza
+ *
+ * Ako opseg (max - min) staje u manje bajtova nego što ih se menja u
+ * sirovim ključevima, ključevi se prvo umanje za min - tada samo
+ * significantBytes(range) nižih bajtova može da se menja, bez obzira na
+ * to gde se opseg nalazi (npr. [1000000, 1000500] su 2 prolaza, ne 3).
+ * Bez umanjenja, prvi prolaz čita ulaz direktno i koristi histograme iz
+ * scanKeys. Prolazi po bajtovima koji su isti za sve se preskaču.
+ *
+ * Od profile.writeCombineMinSize elemenata prolazi između prvog i
+ * poslednjeg idu kroz scatterByByteCombined.
+ *
+ * Ako distinct nije NULL, poslednji prolaz izbacuje duplikate (vidi
+ * scatterToInt32Distinct). input i output smeju biti isti niz. Jedan od
+ * temp1/temp2 sme biti sam output (radixSortCopy ima samo jedan scratch
+ * bafer): uloge se tada zamene tako da poslednji prolaz ne čita iz
+ * output-a. Vraća broj obavljenih prolaza.
+ */
+static size_t lsdSortKeys(const int32_t* input, int32_t* output, size_t size, const KeyScan* scan, uint32_t* temp1, uint32_t* temp2, DistinctOutput* distinct)
+{
+	uint32_t range = scan->max - scan->min;
+	size_t rangeBytes = significantBytes(range);
+	size_t combineMinSize = activeProfile()->writeCombineMinSize;
+	bool combine = (combineMinSize != 0U) && (size >= combineMinSize);/*međuprolazi kroz bafere po bucket-u (profil)*/
+
+	size_t rawActive = 0;
+	for (size_t b = 0; b < NUM_PASSES; b++)
+	{
+		size_t digit = (scan->min >> (b * RADIX_BITS)) & 0xFFU;
+		rawActive += (scan->hist[b][digit] != size) ? 1U : 0U;
+	}
+
+	const size_t (*hist)[RADIX_SIZE] = scan->hist;
+	size_t rebasedHist[NUM_PASSES][RADIX_SIZE];
+	uint32_t base = 0;
+	uint32_t* current = NULL;/*NULL = podaci su još u input nizu*/
+	size_t numBytes = NUM_PASSES;
+	bool outputIsTemp = ((void*)temp1 == (void*)output) || ((void*)temp2 == (void*)output);
+
+	if (rangeBytes < rawActive)
+	{
+		/* Umanjenje za min: ključevi u temp1, novi histogrami u istom čitanju */
+		/* Posle rangeBytes prolaza poslednji čita iz temp1 ako je rangeBytes neparan */
+		if (outputIsTemp && (((rangeBytes % 2U) == 1U) == ((void*)temp1 == (void*)output)))
+		{
+			uint32_t* swap = temp1;
+			temp1 = temp2;
+			temp2 = swap;
+		}
+		base = scan->min;
+		numBytes = rangeBytes;
+		(void)memset(rebasedHist, 0, sizeof(rebasedHist));
+		for (size_t i = 0; i < size; i++)
+		{
+			uint32_t value = ((uint32_t)input[i] ^ SIGN_BIT) - base;
+			temp1[i] = value;
+			rebasedHist[0][value & 0xFFU]++;
+			rebasedHist[1][(value >> 8) & 0xFFU]++;
+			rebasedHist[2][(value >> 16) & 0xFFU]++;
+			rebasedHist[3][value >> 24]++;
+		}
+		hist = (const size_t (*)[RADIX_SIZE])rebasedHist;
+		current = temp1;
+	}
+
+	size_t active[NUM_PASSES];
+	size_t numActive = 0;
+	for (size_t b = 0; b < numBytes; b++)
+	{
+		size_t digit = ((scan->min - base) >> (b * RADIX_BITS)) & 0xFFU;
+		if (hist[b][digit] != size)
+		{
+			active[numActive] = b;
+			numActive++;
+		}
+	}
+
+	if (outputIsTemp && (current != NULL) && (numActive > 0U) && ((numActive % 2U) != (numBytes % 2U)))
+	{
+		/*
+		 * Umanjeni ključevi su u temp1 upisani po pretpostavci da su aktivni
+		 * svi bajtovi opsega. Ako parnost ne odgovara, poslednji prolaz bi
+		 * čitao iz output-a - dodaje se prolaz po bajtu koji je isti za sve
+		 * (stabilna kopija), na početak da ostali ostanu rastući.
+		 */
+		size_t skipped = 0;
+		while ((skipped < numActive) && (active[skipped] == skipped))
+		{
+			skipped++;
+		}
+		for (size_t p = numActive; p > 0U; p--)
+		{
+			active[p] = active[p - 1U];
+		}
+		active[0] = skipped;
+		numActive++;
+	}
+
+	if (outputIsTemp && (current == NULL) && (numActive > 0U))
+	{
+		/* Bez umanjenja prvi prolaz piše u temp1, pa poslednji čita iz temp1 za paran broj prolaza (jedini prolaz se kopira iz temp1) */
+		bool lastFromTemp1 = (numActive == 1U) || ((numActive % 2U) == 0U);
+		if (lastFromTemp1 == ((void*)temp1 == (void*)output))
+		{
+			uint32_t* swap = temp1;
+			temp1 = temp2;
+			temp2 = swap;
+		}
+	}
+
+	for (size_t p = 0; p < numActive; p++)
+	{
+		size_t b = active[p];
+		size_t shift = b * RADIX_BITS;
+		size_t offsets[RADIX_SIZE];
+		size_t sum = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			offsets[d] = sum;
+			sum += hist[b][d];
+		}
+
+		uint32_t* next = (current == temp1) ? temp2 : temp1;
+
+		if ((current == NULL) && (numActive == 1U) && (input != output) && (distinct == NULL))
+		{
+			scatterInt32(input, size, output, shift, offsets);/*jedini prolaz, direktno u output*/
+		}
+		else if (current == NULL)
+		{
+			scatterFromInt32(input, size, next, shift, offsets);
+			current = next;
+			if ((p + 1U == numActive) && (distinct != NULL))
+			{
+				distinct->length = copyToInt32Distinct(current, size, output, base, distinct->counts);
+			}
+			else if (p + 1U == numActive)
+			{
+				copyToInt32(current, size, output);/*jedini prolaz - ulaz i izlaz mogu biti isti niz*/
+			}
+		}
+		else if ((p + 1U == numActive) && (distinct != NULL))
+		{
+			distinct->length = scatterToInt32Distinct(current, size, output, shift, offsets, base, distinct->counts);
+		}
+		else if (p + 1U == numActive)
+		{
+			scatterToInt32(current, size, output, shift, offsets, base);
+		}
+		else if (combine)
+		{
+			scatterByByteCombined(current, size, next, shift, offsets);
+			current = next;
+		}
+		else
+		{
+			scatterByByte(current, size, next, shift, offsets);
+			current = next;
+		}
+	}
+
+	if ((numActive == 0U) && (current != NULL))
+	{
+		/* Ne može se desiti za range > 0, ali izlaz mora biti popunjen */
+		if (distinct != NULL)
+		{
+			distinct->length = copyToInt32Distinct(current, size, output, base, distinct->counts);
+		}
+		else
+		{
+			for (size_t i = 0; i < size; i++)
+			{
+				output[i] = (int32_t)((current[i] + base) ^ SIGN_BIT);
+			}
+		}
+	}
+
+	return numActive;
+}
+
+/*
+ * Pomoćna funkcija: Veličina keša jednog jezgra (L2) u bajtovima
+ *
+ * sysconf(_SC_LEVEL2_CACHE_SIZE) (glibc), zatim sysfs, zatim
+ * DEFAULT_L2_BYTES. Čita se jednom i pamti. L3 se ne koristi: deli ga
+ * više jezgara (u VM-u i ceo host), pa prijavljena veličina ne govori
+ * koliko podataka jedno jezgro zaista drži u kešu.
+ */
+static size_t privateCacheBytes(void)
+{
+	static atomic_size_t cached = 0U;/*0 = još nije pročitano*/
+
+	size_t bytes = atomic_load(&cached);
+	if (bytes == 0U)
+	{
+		long value = -1;
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+		value = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+#if defined(__linux__)
+		if (value <= 0)
+		{
+			FILE* file = fopen("/sys/devices/system/cpu/cpu0/cache/index2/size", "r");
+			if (file != NULL)
+			{
+				char unit = '\0';
+				if (fscanf(file, "%ld%c", &value, &unit) >= 1)
+				{
+					value *= (unit == 'M') ? (1024L * 1024L) : ((unit == 'K') ? 1024L : 1L);
+				}
+				(void)fclose(file);
+			}
+		}
+#endif
+		bytes = (value > 0) ? (size_t)value : DEFAULT_L2_BYTES;
+		atomic_store(&cached, bytes);
+	}
+
+	return bytes;
+}
+
+/*
+ * Pomoćna funkcija: Da li ide keš-blokirana varijanta (MSD + LSD po bucket-u)
+ *
+ * Isplati se kada:
+ *   - niz je bar dvostruko veći od L2, pa LSD prolazi preko celog niza
+ *     idu kroz L3/DRAM (merenje: 300K elemenata još je brže bez MSD-a,
+ *     1M i više je brže sa njim); profil mašine može da zada drugi prag
+ *     (profile.cacheBlockedMinSize)
+ *   - i posle umanjenja za min ostaju bar 3 bajta, tj. bar 3 prolaza
+ *     koje blokiranje zamenjuje
+ *   - najveći bucket (ključevi + pomoćni bafer) staje u pola L2, inače
+ *     dodatni MSD prolaz ne donosi ništa
+ * partitionByte je najviši bajt koji se menja.
+ */
+static bool useCacheBlocked(size_t size, const KeyScan* scan, size_t* partitionByte)
+{
+	size_t cache = privateCacheBytes();
+	size_t minSize = activeProfile()->cacheBlockedMinSize;
+	if (minSize == 0U)
+	{
+		minSize = (2U * cache) / sizeof(uint32_t);
+	}
+
+	if ((size < minSize) || (significantBytes(scan->max - scan->min) < 3U))
+	{
+		return false;
+	}
+
+	size_t b = NUM_PASSES - 1U;
+	while (scan->hist[b][(scan->min >> (b * RADIX_BITS)) & 0xFFU] == size)
+	{
+		b--;/*range >= 2^16, pa se neki bajt >= 2 sigurno menja*/
+	}
+
+	size_t largest = 0;
+	for (size_t d = 0; d < RADIX_SIZE; d++)
+	{
+		largest = (scan->hist[b][d] > largest) ? scan->hist[b][d] : largest;
+	}
+
+	*partitionByte = b;
+	return largest <= (cache / (4U * sizeof(uint32_t)));
+}
+
+/*
+ * Pomoćna funkcija: Keš-blokirano sortiranje velikog niza
+ *
+ * 1. Jedan MSD prolaz po partitionByte rasipa niz u 256 bucket-a u temp1
+ *    (histogram je već iz scanKeys)
+ * 2. Svaki bucket se LSD-om sortira po nižim bajtovima dok je u kešu;
+ *    poslednji prolaz piše nazad u arr
+ *
+ * Van keša idu samo MSD prolaz i po jedno čitanje i pisanje bucket-a,
+ * umesto svih LSD prolaza preko celog niza.
+ */
+static void cacheBlockedSort(int32_t* arr, size_t size, const KeyScan* scan, size_t partitionByte, uint32_t* temp1, uint32_t* temp2)
+{
+	size_t bucketStart[RADIX_SIZE + 1U];
+	size_t offsets[RADIX_SIZE];
+	size_t sum = 0;
+	for (size_t d = 0; d < RADIX_SIZE; d++)
+	{
+		bucketStart[d] = sum;
+		offsets[d] = sum;
+		sum += scan->hist[partitionByte][d];
+	}
+	bucketStart[RADIX_SIZE] = sum;
+	assert(sum == size);
+
+	scatterFromInt32(arr, size, temp1, partitionByte * RADIX_BITS, offsets);
+
+	for (size_t d = 0; d < RADIX_SIZE; d++)
+	{
+		size_t start = bucketStart[d];
+		size_t length = bucketStart[d + 1U] - start;
+		if (length > 0U)
+		{
+			lsdSortToInt32(temp1 + start, temp2 + start, arr + start, length, partitionByte);
+		}
+	}
+}
+
+/*
+ * Pomoćna funkcija: Prazna tabela u memoriji od LOWCARD_TABLE_SIZE slotova
+ *
+ * memory mora imati mesta za LOWCARD_TABLE_BYTES.
+ */
+static void countTableInit(CountTable* table, void* memory)
+{
+	assert(table != NULL);
+	assert(memory != NULL);
+
+	table->counts = (size_t*)memory;
+	table->keys = (uint32_t*)(table->counts + LOWCARD_TABLE_SIZE);
+	table->distinct = 0;
+	(void)memset(table->counts, 0, LOWCARD_TABLE_SIZE * sizeof(size_t));
+}
+
+/*
+ * Indeks slota: završno mešanje iz MurmurHash3 (fmix32). Čist
+ * multiplikativni hash pravi duge lance za ključeve koji su i sami
+ * umnošci iste konstante.
+ */
+static size_t countTableSlot(uint32_t key)
+{
+	key ^= key >> 16;
+	key *= 0x85EBCA6BU;
+	key ^= key >> 13;
+	key *= 0xC2B2AE35U;
+	key ^= key >> 16;
+	return (size_t)(key >> (32U - LOWCARD_TABLE_BITS));
+}
+
+/*
+ * Pomoćna funkcija: Dodaje jedno pojavljivanje ključa
+ *
+ * Vraća false ako bi broj različitih ključeva prešao limit - tada
+ * pozivalac odustaje od brojanja.
+ */
+static bool countTableAdd(CountTable* table, uint32_t key, size_t limit)
+{
+	size_t slot = countTableSlot(key);
+
+	while (table->counts[slot] != 0U)
+	{
+		if (table->keys[slot] == key)
+		{
+			table->counts[slot]++;
+			return true;
+		}
+		slot = (slot + 1U) & (LOWCARD_TABLE_SIZE - 1U);
+	}
+
+	if (table->distinct >= limit)
+	{
+		return false;
+	}
+
+	table->keys[slot] = key;
+	table->counts[slot] = 1U;
+	table->distinct++;
+	return true;
+}
+
+/* Broj pojavljivanja ključa, 0 ako ga nema u tabeli */
+static size_t countTableFind(const CountTable* table, uint32_t key)
+{
+	size_t slot = countTableSlot(key);
+
+	while (table->counts[slot] != 0U)
+	{
+		if (table->keys[slot] == key)
+		{
+			return table->counts[slot];
+		}
+		slot = (slot + 1U) & (LOWCARD_TABLE_SIZE - 1U);
+	}
+
+	return 0U;
+}
+
+/*
+ * Pomoćna funkcija: LSD sortiranje uint32_t niza, rezultat ostaje u arr
+ *
+ * Za male nizove (npr. različite vrednosti iz hash tabele), tmp je
+ * drugi bafer iste veličine.
+ */
+static void lsdSortU32(uint32_t* arr, uint32_t* tmp, size_t size)
+{
+	if (size <= SMALL_SORT_THRESHOLD)
+	{
+		insertionSortU32(arr, size);
+		return;
+	}
+
+	size_t count[NUM_PASSES][RADIX_SIZE] = {{0}};
+	histogramAllBytes(arr, size, count);
+
+	uint32_t* input = arr;
+	uint32_t* output = tmp;
+	for (size_t b = 0; b < NUM_PASSES; b++)
+	{
+		if (count[b][(arr[0] >> (b * RADIX_BITS)) & 0xFFU] == size)
+		{
+			continue;
+		}
+
+		size_t offsets[RADIX_SIZE];
+		size_t sum = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			offsets[d] = sum;
+			sum += count[b][d];
+		}
+		scatterByByte(input, size, output, b * RADIX_BITS, offsets);
+
+		uint32_t* swap = input;
+		input = output;
+		output = swap;
+	}
+
+	if (input != arr)
+	{
+		(void)memcpy(arr, input, size * sizeof(uint32_t));
+	}
+}
+
+/*
+ * Pomoćna funkcija: Sortiranje ulaza sa malo različitih vrednosti
+ *
+ * 1. Uzorak od LOWCARD_SAMPLE elemenata: ako ima previše različitih
+ *    vrednosti, ili je opseg uzorka uzak (counting sort je tada brži od
+ *    hash-a), odustaje se odmah; niz jednakih vrednosti uvek ide ovuda
+ *    (jedno čitanje + popunjavanje)
+ * 2. Jedno čitanje celog niza broji različite vrednosti u hash tabeli;
+ *    prekida se ako ih bude više od LOWCARD_MAX_DISTINCT
+ * 3. Sortiraju se samo različite vrednosti (najviše 1024)
+ * 4. Niz se popunjava nizovima jednakih vrednosti
+ *
+ * Vraća false ako ulaz nema nisku kardinalnost - output tada nije menjan.
+ * Sa distinct != NULL upisuje se samo po jedna vrednost sa brojačem.
+ * scratch drži tabelu, a iza nje 2 * LOWCARD_MAX_DISTINCT ključeva
+ * (LOWCARD_SCRATCH_BYTES ukupno). input i output smeju biti isti niz.
+ */
+static bool lowCardinalitySort(const int32_t* input, int32_t* output, size_t size, void* scratch, DistinctOutput* distinct)
+{
+	assert(size >= LOWCARD_SAMPLE);
+
+	CountTable table;
+	countTableInit(&table, scratch);
+	uint32_t* work = (uint32_t*)((unsigned char*)scratch + LOWCARD_TABLE_BYTES);
+
+	size_t stride = size / LOWCARD_SAMPLE;
+	uint32_t sampleMin = UINT32_MAX;
+	uint32_t sampleMax = 0;
+	for (size_t i = 0; i < LOWCARD_SAMPLE; i++)
+	{
+		uint32_t key = (uint32_t)input[i * stride] ^ SIGN_BIT;
+		sampleMin = (key < sampleMin) ? key : sampleMin;
+		sampleMax = (key > sampleMax) ? key : sampleMax;
+		if (!countTableAdd(&table, key, LOWCARD_SAMPLE_MAX_DISTINCT))
+		{
+			return false;
+		}
+	}
+
+	if ((table.distinct > 1U) && ((size_t)(sampleMax - sampleMin) < size))
+	{
+		return false;/*uzak opseg - direktan counting sort bez hash-a*/
+	}
+
+	countTableInit(&table, scratch);
+	for (size_t i = 0; i < size; i++)
+	{
+		if (!countTableAdd(&table, (uint32_t)input[i] ^ SIGN_BIT, LOWCARD_MAX_DISTINCT))
+		{
+			return false;
+		}
+	}
+
+	uint32_t* keys = work;
+	size_t numKeys = 0;
+	for (size_t slot = 0; slot < LOWCARD_TABLE_SIZE; slot++)
+	{
+		if (table.counts[slot] != 0U)
+		{
+			keys[numKeys] = table.keys[slot];
+			numKeys++;
+		}
+	}
+	lsdSortU32(keys, work + LOWCARD_MAX_DISTINCT, numKeys);
+
+	if (distinct != NULL)
+	{
+		for (size_t k = 0; k < numKeys; k++)
+		{
+			output[k] = (int32_t)(keys[k] ^ SIGN_BIT);
+			if (distinct->counts != NULL)
+			{
+				distinct->counts[k] = countTableFind(&table, keys[k]);
+			}
+		}
+		distinct->length = numKeys;
+		return true;
+	}
+
+	size_t position = 0;
+	for (size_t k = 0; k < numKeys; k++)
+	{
+		int32_t value = (int32_t)(keys[k] ^ SIGN_BIT);
+		for (size_t c = countTableFind(&table, keys[k]); c > 0U; c--)
+		{
+			output[position] = value;
+			position++;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Radix Sort LSD implementacija
+ *
+ * Koraci:
+ * 0. Nizovi do profile.smallSortThreshold elemenata: insertion sort, bez
+ *    scratch bafera
+ * 1. Transformiše int32_t u uint32_t (XOR sa 0x80000000)
+ *    - Ovo mapira negativne brojeve u manji opseg od pozitivnih
+ * 2. Veliki nizovi sa malo različitih vrednosti (po uzorku): hash brojanje
+ *    različitih vrednosti i popunjavanje, bez prolaza rasipanja
+ * 3. Prvo čitanje: min, max i histogrami svih bajtova
+ * 4. Po opsegu (max - min):
+ *    - 0: svi su isti, nema posla
+ *    - manji od broja elemenata: direktan counting sort
+ *    - niz mnogo veći od keša: MSD po najvišem bajtu, pa LSD po bucket-u
+ *    - sva 4 bajta se menjaju, veličina u opsegu iz profila: LSD sa
+ *      11-bitnim ciframa (3 prolaza)
+ *    - inače: LSD samo po bajtovima koji se menjaju u (ključ - min)
+ * 5. Transformiše nazad u int32_t (u poslednjem prolazu)
+ *
+ * Sa distinct != NULL (radixSortUnique, radixSortCounts) svaka putanja
+ * upisuje samo različite vrednosti tamo gde ionako piše izlaz.
+ *
+ * Ako input nije isti niz kao arr (radixSortCopy), input se samo čita, a
+ * arr služi kao drugi bafer za prolaze - alocira se jedan scratch bafer.
+ */
+static SortResult sortArray(const int32_t* input, int32_t* arr, size_t size, DistinctOutput* distinct)
+{
+	if ((input == NULL) || (arr == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (size == 0)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	resetStats();
+
+	if (size == 1)
+	{
+		arr[0] = input[0];
+		if (distinct != NULL)
+		{
+			distinct->length = 1U;
+			if (distinct->counts != NULL)
+			{
+				distinct->counts[0] = 1U;
+			}
+		}
+		return SORT_SUCCESS;
+	}
+
+	if ((distinct == NULL) && (size <= activeProfile()->smallSortThreshold))
+	{
+		/* Mali niz: histogrami i scratch bafer koštaju više od samog sortiranja */
+		if (input != arr)
+		{
+			(void)memcpy(arr, input, size * sizeof(int32_t));
+		}
+		insertionSortI32(arr, size);
+		g_lastStats.strategy = SORT_STRATEGY_INSERTION;
+		return SORT_SUCCESS;
+	}
+
+	bool inPlace = (input == arr);
+
+	/*
+	* DVE ODVOJENE ALOKACIJE:
+	* 
+	* Ovo nije propust!
+	* 
+	* 1. Eksplicitno pokazuje Radix Sort swapping koncept
+	*    - Dva odvojena bafera jasno prikazuju naizmenično korišćenje
+	*    - Swap operacija je transparentna i lako se prati
+	* 
+	* 2. Povećava bezbednost protiv memory grešaka  
+	*    - Odvojeni memory regioni sprečavaju slučajni buffer overflow
+	*    - Jasne granice između input/output bafera
+	* 
+	* 3.
+	*    - Kod ostaje čitljiv i razumljiv bez "magičnih" optimizacija
+	*    - Fokus na algoritam, ne na sistemske detalje
+	* 
+	* 4. Ima zanemarljiv performance impact na O(n) algoritmu
+	*    - Dodatna alokacija ≈0.1ms u odnosu na ~100ms sortiranja
+	*    - Asimptotska složenost O(n) ostaje nepromenjena
+	* 
+	* 5. Olakšava buduće modifikacije i proširenja
+	*    - Jednostavna promena na druge tipove podataka
+	*    - Debug-friendly separacija bafera
+	* 
+	* Oba bafera idu kroz scratchAlloc(), pa za velike nizove dobijaju
+	* huge stranice - 256-way rasipanje po stotinama MB inače troši
+	* većinu vremena na dTLB promašaje sa 4 KB stranicama.
+	*
+	* Kod sortiranja u drugi niz (radixSortCopy) odredišni niz je drugi
+	* bafer, pa se alocira samo scratch1.
+	*/
+
+	ScratchBuffer scratch1;
+	if (!scratchAlloc(&scratch1, size * sizeof(uint32_t)))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+
+
+	/*MISRA-C:2004 Rule 20.4, prekrseno*/
+	ScratchBuffer scratch2 = { NULL, 0U, 0U, SORT_PAGES_NONE, false };
+	if (inPlace && !scratchAlloc(&scratch2, size * sizeof(uint32_t)))
+	{
+		scratchFree(&scratch1);
+		return SORT_ERROR_MEMORY;
+	}
+
+	recordScratch(&scratch1);
+	if (inPlace)
+	{
+		recordScratch(&scratch2);
+	}
+
+	sortWithBuffers(input, arr, size, distinct, (uint32_t*)scratch1.ptr, inPlace ? (uint32_t*)scratch2.ptr : NULL);
+
+	scratchFree(&scratch1);
+	scratchFree(&scratch2);
+
+	return SORT_SUCCESS;
+}
+
+/*
+ * Pomoćna funkcija: Izbor strategije i sortiranje sa gotovim baferima
+ *
+ * temp1 i temp2 imaju po size elemenata; temp2 == NULL znači da se
+ * sortira u drugi niz (input != arr) i da je arr drugi bafer. size >= 2.
+ * Strategija i broj prolaza se upisuju u statistiku tekućeg thread-a.
+ */
+static void sortWithBuffers(const int32_t* input, int32_t* arr, size_t size, DistinctOutput* distinct, uint32_t* temp1, uint32_t* temp2)
+{
+	bool inPlace = (temp2 != NULL);
+	if (!inPlace)
+	{
+		temp2 = (uint32_t*)arr;
+	}
+
+	/* Transformacija: int32_t -> uint32_t */
+	/* XOR sa 0x80000000 flip-uje sign bit, tako da negativni postaju manji */
+	/*Casting uint32_t u = (uint32_t)i; samo interpretira iste bitove kao unsigned.
+	Problem: negativni brojevi i dalje imaju najviši bit 1 → sortiranje po bajtu bi stavilo negativne brojeve na kraj.*/
+	/* Transformacija se radi u letu (scanKeys, prvi i poslednji prolaz), bez posebnih prolaza */
+
+	/* Malo različitih vrednosti: jedno čitanje sa hash brojanjem + popunjavanje */
+	/* LOWCARD_MIN_SIZE * 4 B scratch-a je tačno LOWCARD_SCRATCH_BYTES (tabela + ključevi) */
+	if ((size >= LOWCARD_MIN_SIZE) && lowCardinalitySort(input, arr, size, temp1, distinct))
+	{
+		g_lastStats.strategy = SORT_STRATEGY_LOW_CARDINALITY;
+		g_lastStats.passes = 1U;
+		return;
+	}
+
+	KeyScan scan;
+	scanKeys(input, size, &scan);
+
+	uint32_t range = scan.max - scan.min;
+	size_t partitionByte = 0;
+
+	if (range == 0U)
+	{
+		/* Svi elementi su isti - niz je već sortiran */
+		g_lastStats.strategy = SORT_STRATEGY_NONE;
+		if (!inPlace)
+		{
+			(void)memcpy(arr, input, ((distinct != NULL) ? 1U : size) * sizeof(int32_t));
+		}
+		if (distinct != NULL)
+		{
+			distinct->length = 1U;
+			if (distinct->counts != NULL)
+			{
+				distinct->counts[0] = size;
+			}
+		}
+	}
+	else if ((scan.runs == 1U) && (distinct == NULL))
+	{
+		/* Ulaz je već sortiran */
+		g_lastStats.strategy = SORT_STRATEGY_NONE;
+		if (!inPlace)
+		{
+			(void)memcpy(arr, input, size * sizeof(int32_t));
+		}
+	}
+	else if ((range < size) && (size <= (size_t)UINT32_MAX))
+	{
+		/* Opseg manji od broja elemenata: brojači staju u temp1, jedno brojanje + popunjavanje */
+		countingSortRange(input, arr, size, scan.min, range, temp1, distinct);
+		g_lastStats.strategy = SORT_STRATEGY_COUNTING;
+		g_lastStats.passes = 1U;
+	}
+	else if ((scan.runs <= MERGE_MAX_RUNS) && (distinct == NULL))
+	{
+		/* Nekoliko sortiranih delova (npr. spojeni sortirani segmenti): jedno spajanje umesto prolaza */
+		size_t starts[MERGE_MAX_RUNS + 1U];
+		findRuns(input, size, starts, scan.runs);
+		if (inPlace)
+		{
+			mergeRuns(input, (int32_t*)temp1, size, starts, scan.runs);
+			(void)memcpy(arr, temp1, size * sizeof(int32_t));
+		}
+		else
+		{
+			mergeRuns(input, arr, size, starts, scan.runs);
+		}
+		g_lastStats.strategy = SORT_STRATEGY_MERGE_RUNS;
+	}
+	else if (inPlace && (distinct == NULL) && useCacheBlocked(size, &scan, &partitionByte))
+	{
+		/* Niz mnogo veći od keša: jedan MSD prolaz, pa LSD po bucket-u u kešu */
+		cacheBlockedSort(arr, size, &scan, partitionByte, temp1, temp2);
+		g_lastStats.strategy = SORT_STRATEGY_CACHE_BLOCKED;
+		g_lastStats.passes = 1U + partitionByte;
+	}
+	else if ((distinct == NULL) && useWideDigits(size, &scan))
+	{
+		/* Sva 4 bajta se menjaju: 3 prolaza sa 11-bitnim ciframa (profil) */
+		g_lastStats.passes = lsdSortWide(input, arr, size, scan.min, temp1, temp2);
+		g_lastStats.strategy = SORT_STRATEGY_LSD;
+	}
+	else
+	{
+		g_lastStats.passes = lsdSortKeys(input, arr, size, &scan, temp1, temp2, distinct);
+		g_lastStats.strategy = SORT_STRATEGY_LSD;
+	}
+}
+
+SortResult radixSort(int32_t* arr, size_t size)
+{
+	return sortArray(arr, arr, size, NULL);
+}
+
+SortResult radixSortCopy(const int32_t* in, int32_t* out, size_t size)
+{
+	return sortArray(in, out, size, NULL);
+}
+
+SortResult radixSortUnique(int32_t* arr, size_t size, size_t* newSize)
+{
+	if (newSize == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	DistinctOutput distinct = { NULL, 0U };
+	SortResult result = sortArray(arr, arr, size, &distinct);
+	if (result == SORT_SUCCESS)
+	{
+		*newSize = distinct.length;
+	}
+	return result;
+}
+
+SortResult radixSortCounts(int32_t* arr, size_t size, size_t* counts, size_t* numDistinct)
+{
+	if ((counts == NULL) || (numDistinct == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	DistinctOutput distinct = { counts, 0U };
+	SortResult result = sortArray(arr, arr, size, &distinct);
+	if (result == SORT_SUCCESS)
+	{
+		*numDistinct = distinct.length;
+	}
+	return result;
+}
+
+#if RADIX_HAVE_THREADS
+
+/*
+ * NUMA topologija: CPU-ovi poređani po čvorovima, tako da susedni
+ * thread-ovi (i susedne grupe bucket-a) padaju na isti čvor.
+ */
+typedef struct
+{
+	size_t numCpus;
+	size_t numNodes;
+	int cpus[MAX_CPUS];
+	size_t nodeOfCpu[MAX_CPUS];
+} NumaTopology;
+
+/*
+ * Barijera za fiksan broj thread-ova (pthread_barrier_t nije obavezan deo POSIX-a)
+ */
+typedef struct
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	size_t count;
+	size_t waiting;
+	size_t generation;
+} WorkerBarrier;
+
+/*
+ * Stanje zajedničko za sve thread-ove jednog radixSortParallel poziva
+ */
+typedef struct
+{
+	int32_t* arr;
+	size_t size;
+	uint32_t* primary;   /* rezultat MSD raspodele */
+	uint32_t* secondary; /* drugi bafer za LSD unutar bucket-a */
+	size_t numThreads;
+	bool numaAware;
+
+	size_t (*hist)[NUM_PASSES][RADIX_SIZE]; /* histogrami po thread-u */
+	size_t (*offsets)[RADIX_SIZE];          /* pozicije rasipanja po thread-u */
+	size_t* groupStart;                     /* numThreads + 1 granica grupa bucket-a */
+	size_t bucketStart[RADIX_SIZE + 1U];
+	size_t partitionByte;
+	bool allEqual;
+
+	WorkerBarrier barrier;
+	pthread_mutex_t gateMutex;
+	pthread_cond_t gateCond;
+	int gateState; /* 0 = čekaj, 1 = kreni, 2 = odustani */
+} ParallelShared;
+
+typedef struct
+{
+	ParallelShared* shared;
+	size_t index;
+} ParallelWorker;
+
+/*
+ * Pomoćni thread iz pool-a RadixSortContext-a
+ */
+typedef struct
+{
+	RadixSortContext* context;
+	size_t index;
+} ContextWorker;
+
+static NumaTopology g_topology;
+static pthread_once_t g_topologyOnce = PTHREAD_ONCE_INIT;
+
+static void loadTopology(void);
+static size_t parseCpuList(const char* text, int* cpus, size_t capacity);
+static void barrierInit(WorkerBarrier* barrier, size_t count);
+static void barrierDestroy(WorkerBarrier* barrier);
+static bool barrierWait(WorkerBarrier* barrier);
+static bool waitStartGate(ParallelShared* shared);
+static void openStartGate(ParallelShared* shared, int state);
+static void parallelPlan(ParallelShared* shared);
+static void* parallelWorker(void* arg);
+static void parallelSortBody(ParallelShared* shared, size_t t);
+static void* contextWorker(void* arg);
+static void contextRun(RadixSortContext* context, size_t active, void (*task)(void* arg, size_t index), void* arg);
+static void contextEnter(RadixSortContext* context);
+static void contextLeave(RadixSortContext* context);
+static void contextSortTask(void* arg, size_t index);
+static void asyncStart(void);
+static void* asyncWorker(void* arg);
+
+/*
+ * Pomoćna funkcija: Parsiranje Linux cpulist formata ("0-3,8-11")
+ */
+static size_t parseCpuList(const char* text, int* cpus, size_t capacity)
+{
+	assert(text != NULL);
+	assert(cpus != NULL);
+
+	size_t count = 0;
+	const char* p = text;
+
+	while ((*p != '\0') && (*p != '\n'))
+	{
+		char* end = NULL;
+		long first = strtol(p, &end, 10);
+		if (end == p)
+		{
+			break;
+		}
+		long last = first;
+		p = end;
+		if (*p == '-')
+		{
+			p++;
+			last = strtol(p, &end, 10);
+			p = end;
+		}
+		for (long cpu = first; (cpu <= last) && (count < capacity); cpu++)
+		{
+			cpus[count] = (int)cpu;
+			count++;
+		}
+		if (*p == ',')
+		{
+			p++;
+		}
+	}
+
+	return count;
+}
+
+/*
+ * Pomoćna funkcija: Učitavanje NUMA topologije (jednom po procesu)
+ *
+ * Čita /sys/devices/system/node/nodeN/cpulist i zadržava samo CPU-ove
+ * dozvoljene procesu (kontejneri i taskset ograničavaju affinity masku).
+ * Bez sysfs-a ceo sistem je jedan čvor; bez affinity podrške pinovanja nema.
+ */
+static void loadTopology(void)
+{
+	g_topology.numCpus = 0;
+	g_topology.numNodes = 0;
+
+#if RADIX_HAVE_AFFINITY
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+	{
+		return;
+	}
+
+	for (size_t node = 0; node < MAX_NUMA_NODES; node++)
+	{
+		char path[64];
+		(void)snprintf(path, sizeof(path), "/sys/devices/system/node/node%zu/cpulist", node);
+
+		FILE* file = fopen(path, "r");
+		if (file == NULL)
+		{
+			continue;/*čvorovi ne moraju biti numerisani bez rupa*/
+		}
+
+		char line[512] = {0};
+		int nodeCpus[MAX_CPUS];
+		size_t found = 0;
+		if (fgets(line, (int)sizeof(line), file) != NULL)
+		{
+			found = parseCpuList(line, nodeCpus, MAX_CPUS);
+		}
+		(void)fclose(file);
+
+		bool nodeUsed = false;
+		for (size_t i = 0; (i < found) && (g_topology.numCpus < MAX_CPUS); i++)
+		{
+			if ((nodeCpus[i] >= 0) && (nodeCpus[i] < CPU_SETSIZE) && CPU_ISSET(nodeCpus[i], &allowed))
+			{
+				g_topology.cpus[g_topology.numCpus] = nodeCpus[i];
+				g_topology.nodeOfCpu[g_topology.numCpus] = g_topology.numNodes;
+				g_topology.numCpus++;
+				nodeUsed = true;
+			}
+		}
+		if (nodeUsed)
+		{
+			g_topology.numNodes++;
+		}
+	}
+
+	if (g_topology.numCpus == 0U)
+	{
+		/* Nema sysfs NUMA informacija - svi dozvoljeni CPU-ovi su jedan čvor */
+		for (int cpu = 0; (cpu < CPU_SETSIZE) && (g_topology.numCpus < MAX_CPUS); cpu++)
+		{
+			if (CPU_ISSET(cpu, &allowed))
+			{
+				g_topology.cpus[g_topology.numCpus] = cpu;
+				g_topology.nodeOfCpu[g_topology.numCpus] = 0;
+				g_topology.numCpus++;
+			}
+		}
+		g_topology.numNodes = (g_topology.numCpus > 0U) ? 1U : 0U;
+	}
+#endif
+}
+
+static void barrierInit(WorkerBarrier* barrier, size_t count)
+{
+	(void)pthread_mutex_init(&barrier->mutex, NULL);
+	(void)pthread_cond_init(&barrier->cond, NULL);
+	barrier->count = count;
+	barrier->waiting = 0;
+	barrier->generation = 0;
+}
+
+static void barrierDestroy(WorkerBarrier* barrier)
+{
+	(void)pthread_cond_destroy(&barrier->cond);
+	(void)pthread_mutex_destroy(&barrier->mutex);
+}
+
+/*
+ * Pomoćna funkcija: Čekanje na barijeri
+ *
+ * Vraća true tačno jednom thread-u (poslednjem koji je stigao) - on
+ * obavlja serijski deo posla između dve barijere.
+ */
+static bool barrierWait(WorkerBarrier* barrier)
+{
+	bool last = false;
+
+	(void)pthread_mutex_lock(&barrier->mutex);
+	size_t generation = barrier->generation;
+	barrier->waiting++;
+	if (barrier->waiting == barrier->count)
+	{
+		barrier->waiting = 0;
+		barrier->generation++;
+		last = true;
+		(void)pthread_cond_broadcast(&barrier->cond);
+	}
+	else
+	{
+		while (generation == barrier->generation)
+		{
+			(void)pthread_cond_wait(&barrier->cond, &barrier->mutex);
+		}
+	}
+	(void)pthread_mutex_unlock(&barrier->mutex);
+
+	return last;
+}
+
+/*
+ * Pomoćna funkcija: Kapija na startu
+ *
+ * Thread-ovi ne ulaze u barijere dok svi nisu uspešno kreirani; ako
+ * pthread_create ne uspe, već kreirani thread-ovi izlaze bez rada.
+ */
+static bool waitStartGate(ParallelShared* shared)
+{
+	(void)pthread_mutex_lock(&shared->gateMutex);
+	while (shared->gateState == 0)
+	{
+		(void)pthread_cond_wait(&shared->gateCond, &shared->gateMutex);
+	}
+	int state = shared->gateState;
+	(void)pthread_mutex_unlock(&shared->gateMutex);
+
+	return state == 1;
+}
+
+static void openStartGate(ParallelShared* shared, int state)
+{
+	(void)pthread_mutex_lock(&shared->gateMutex);
+	shared->gateState = state;
+	(void)pthread_cond_broadcast(&shared->gateCond);
+	(void)pthread_mutex_unlock(&shared->gateMutex);
+}
+
+/*
+ * Pomoćna funkcija: Serijski plan između histograma i rasipanja
+ *
+ * 1. Sabira histograme svih thread-ova
+ * 2. Bira najviši bajt koji se menja kao MSD cifru (za uski opseg
+ *    vrednosti najviši bajt je isti za sve i ne bi podelio posao)
+ * 3. Računa početke bucket-a i pozicije rasipanja po thread-u
+ * 4. Deli bucket-e u susedne grupe od oko size/numThreads elemenata
+ */
+static void parallelPlan(ParallelShared* shared)
+{
+	size_t total[NUM_PASSES][RADIX_SIZE] = {{0}};
+
+	for (size_t t = 0; t < shared->numThreads; t++)
+	{
+		for (size_t b = 0; b < NUM_PASSES; b++)
+		{
+			for (size_t d = 0; d < RADIX_SIZE; d++)
+			{
+				total[b][d] += shared->hist[t][b][d];
+			}
+		}
+	}
+
+	shared->allEqual = true;
+	shared->partitionByte = 0;
+	for (size_t b = NUM_PASSES; b > 0U; b--)
+	{
+		size_t nonEmpty = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			nonEmpty += (total[b - 1U][d] != 0U) ? 1U : 0U;
+		}
+		if (nonEmpty > 1U)
+		{
+			shared->partitionByte = b - 1U;
+			shared->allEqual = false;
+			break;
+		}
+	}
+
+	if (shared->allEqual)
+	{
+		return;
+	}
+
+	size_t p = shared->partitionByte;
+	size_t sum = 0;
+	for (size_t d = 0; d < RADIX_SIZE; d++)
+	{
+		shared->bucketStart[d] = sum;
+		size_t position = sum;
+		for (size_t t = 0; t < shared->numThreads; t++)
+		{
+			shared->offsets[t][d] = position;
+			position += shared->hist[t][p][d];
+		}
+		sum += total[p][d];
+	}
+	shared->bucketStart[RADIX_SIZE] = sum;
+
+	size_t bucket = 0;
+	shared->groupStart[0] = 0;
+	for (size_t t = 1; t < shared->numThreads; t++)
+	{
+		size_t target = chunkStart(shared->size, shared->numThreads, t);
+		while ((bucket < RADIX_SIZE) && (shared->bucketStart[bucket] < target))
+		{
+			bucket++;
+		}
+		shared->groupStart[t] = bucket;
+	}
+	shared->groupStart[shared->numThreads] = RADIX_SIZE;
+}
+
+static void* parallelWorker(void* arg)
+{
+	ParallelWorker* worker = (ParallelWorker*)arg;
+
+	if (waitStartGate(worker->shared))
+	{
+		parallelSortBody(worker->shared, worker->index);
+	}
+
+	return NULL;
+}
+
+/*
+ * Pomoćna funkcija: Posao thread-a t u paralelnom sortiranju
+ *
+ * Svih shared->numThreads thread-ova mora da je pozove, inače barijera
+ * nikad ne pusti ostale.
+ */
+static void parallelSortBody(ParallelShared* shared, size_t t)
+{
+	size_t lo = chunkStart(shared->size, shared->numThreads, t);
+	size_t hi = chunkStart(shared->size, shared->numThreads, t + 1U);
+
+	/* Faza 1: histogrami svih bajtova za svoj deo niza */
+	for (size_t i = lo; i < hi; i++)
+	{
+		uint32_t value = (uint32_t)shared->arr[i] ^ SIGN_BIT;
+		shared->hist[t][0][value & 0xFFU]++;
+		shared->hist[t][1][(value >> 8) & 0xFFU]++;
+		shared->hist[t][2][(value >> 16) & 0xFFU]++;
+		shared->hist[t][3][value >> 24]++;
+	}
+
+	if (barrierWait(&shared->barrier))
+	{
+		parallelPlan(shared);
+	}
+	(void)barrierWait(&shared->barrier);
+
+	if (shared->allEqual)
+	{
+		return;/*svi elementi su isti, niz je već sortiran*/
+	}
+
+	size_t groupLo = shared->bucketStart[shared->groupStart[t]];
+	size_t groupHi = shared->bucketStart[shared->groupStart[t + 1U]];
+
+	/* Faza 2: first-touch dela scratch bafera koji ovaj thread sortira u fazi 4 */
+	if (shared->numaAware)
+	{
+		touchPages(shared->primary + groupLo, groupHi - groupLo);
+		touchPages(shared->secondary + groupLo, groupHi - groupLo);
+		(void)barrierWait(&shared->barrier);
+	}
+
+	/* Faza 3: MSD rasipanje svog dela niza po izabranom bajtu */
+	size_t shift = shared->partitionByte * RADIX_BITS;
+	size_t* offsets = shared->offsets[t];
+	for (size_t i = lo; i < hi; i++)
+	{
+		uint32_t value = (uint32_t)shared->arr[i] ^ SIGN_BIT;
+		size_t digit = (value >> shift) & 0xFFU;
+		shared->primary[offsets[digit]] = value;
+		offsets[digit]++;
+	}
+
+	(void)barrierWait(&shared->barrier);
+
+	/* Faza 4: LSD po nižim bajtovima, samo unutar svoje grupe bucket-a */
+	for (size_t d = shared->groupStart[t]; d < shared->groupStart[t + 1U]; d++)
+	{
+		size_t start = shared->bucketStart[d];
+		size_t length = shared->bucketStart[d + 1U] - start;
+		if (length > 0U)
+		{
+			lsdSortToInt32(shared->primary + start, shared->secondary + start,
+			               shared->arr + start, length, shared->partitionByte);
+		}
+	}
+}
+
+#endif /* RADIX_HAVE_THREADS */
+
+SortResult radixSortParallel(int32_t* arr, size_t size, size_t numThreads)
+{
+#if RADIX_HAVE_THREADS
+	if (arr == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (size == 0)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	if (numThreads == 0U)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		numThreads = (online > 0) ? (size_t)online : 1U;
+	}
+	if (numThreads > MAX_THREADS)
+	{
+		numThreads = MAX_THREADS;
+	}
+	size_t minPerThread = activeProfile()->parallelMinPerThread;
+	if (numThreads > size / minPerThread)
+	{
+		numThreads = size / minPerThread;
+	}
+	if (numThreads <= 1U)
+	{
+		return radixSort(arr, size);
+	}
+
+	resetStats();
+
+	/* Baferi se samo alociraju - stranice dobijaju tek pri prvom upisu */
+	ScratchBuffer scratch1;
+	if (!scratchAlloc(&scratch1, size * sizeof(uint32_t)))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	ScratchBuffer scratch2;
+	if (!scratchAlloc(&scratch2, size * sizeof(uint32_t)))
+	{
+		scratchFree(&scratch1);
+		return SORT_ERROR_MEMORY;
+	}
+
+	ParallelShared shared;
+	shared.arr = arr;
+	shared.size = size;
+	shared.primary = (uint32_t*)scratch1.ptr;
+	shared.secondary = (uint32_t*)scratch2.ptr;
+	shared.numThreads = numThreads;
+	shared.numaAware = g_config.numaAware;
+	shared.hist = calloc(numThreads, sizeof(*shared.hist));
+	shared.offsets = calloc(numThreads, sizeof(*shared.offsets));
+	shared.groupStart = calloc(numThreads + 1U, sizeof(size_t));
+	ParallelWorker* workers = calloc(numThreads, sizeof(ParallelWorker));
+	pthread_t* threads = calloc(numThreads, sizeof(pthread_t));
+
+	if ((shared.hist == NULL) || (shared.offsets == NULL) || (shared.groupStart == NULL) ||
+	    (workers == NULL) || (threads == NULL))
+	{
+		free(shared.hist);
+		free(shared.offsets);
+		free(shared.groupStart);
+		free(workers);
+		free(threads);
+		scratchFree(&scratch1);
+		scratchFree(&scratch2);
+		return SORT_ERROR_MEMORY;
+	}
+
+	barrierInit(&shared.barrier, numThreads);
+	(void)pthread_mutex_init(&shared.gateMutex, NULL);
+	(void)pthread_cond_init(&shared.gateCond, NULL);
+	shared.gateState = 0;
+
+	(void)pthread_once(&g_topologyOnce, loadTopology);
+	bool pin = shared.numaAware && (g_topology.numCpus > 0U);
+	bool nodeUsed[MAX_NUMA_NODES] = {false};
+
+	size_t created = 0;
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		workers[t].shared = &shared;
+		workers[t].index = t;
+
+		pthread_attr_t attr;
+		(void)pthread_attr_init(&attr);
+#if RADIX_HAVE_AFFINITY
+		if (pin)
+		{
+			/* Thread-ovi u blokovima po čvorovima: susedne grupe bucket-a na istom čvoru */
+			size_t slot = (t * g_topology.numCpus) / numThreads;
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(g_topology.cpus[slot], &cpuSet);
+			(void)pthread_attr_setaffinity_np(&attr, sizeof(cpuSet), &cpuSet);
+			nodeUsed[g_topology.nodeOfCpu[slot]] = true;
+		}
+#endif
+		int rc = pthread_create(&threads[t], &attr, parallelWorker, &workers[t]);
+		(void)pthread_attr_destroy(&attr);
+		if (rc != 0)
+		{
+			break;
+		}
+		created++;
+	}
+
+	openStartGate(&shared, (created == numThreads) ? 1 : 2);
+	for (size_t t = 0; t < created; t++)
+	{
+		(void)pthread_join(threads[t], NULL);
+	}
+
+	barrierDestroy(&shared.barrier);
+	(void)pthread_cond_destroy(&shared.gateCond);
+	(void)pthread_mutex_destroy(&shared.gateMutex);
+	free(shared.hist);
+	free(shared.offsets);
+	free(shared.groupStart);
+	free(workers);
+	free(threads);
+
+	if (created != numThreads)
+	{
+		/* Nisu dobijeni svi thread-ovi - sortiraj u tekućem thread-u */
+		scratchFree(&scratch1);
+		scratchFree(&scratch2);
+		return radixSort(arr, size);
+	}
+
+	recordScratch(&scratch1);
+	recordScratch(&scratch2);
+	g_lastStats.strategy = SORT_STRATEGY_PARALLEL;
+	g_lastStats.threads = numThreads;
+	g_lastStats.numaNodes = 0;
+	if (pin)
+	{
+		for (size_t node = 0; node < MAX_NUMA_NODES; node++)
+		{
+			g_lastStats.numaNodes += nodeUsed[node] ? 1U : 0U;
+		}
+	}
+
+	scratchFree(&scratch1);
+	scratchFree(&scratch2);
+
+	return SORT_SUCCESS;
+#else
+	(void)numThreads;
+	return radixSort(arr, size);
+#endif
+}
+
+#if RADIX_HAVE_THREADS
+
+typedef struct
+{
+	void (*fn)(void* context, size_t index);
+	void* context;
+	size_t index;
+} TaskSlot;
+
+static void* taskTrampoline(void* arg)
+{
+	TaskSlot* slot = (TaskSlot*)arg;
+	slot->fn(slot->context, slot->index);
+	return NULL;
+}
+
+/*
+ * Pomoćna funkcija: Izvršavanje nezavisnih zadataka na numTasks thread-ova
+ *
+ * Zadatak 0 radi tekući thread. Zadaci ne čekaju jedan drugog, pa ako
+ * pthread_create ne uspe, tekući thread taj zadatak odradi sam.
+ */
+static void runTasks(size_t numTasks, void (*fn)(void* context, size_t index), void* context)
+{
+	assert(numTasks <= MAX_THREADS);
+
+	TaskSlot slots[MAX_THREADS];
+	pthread_t threads[MAX_THREADS];
+	bool started[MAX_THREADS] = {false};
+
+	for (size_t t = 1; t < numTasks; t++)
+	{
+		slots[t].fn = fn;
+		slots[t].context = context;
+		slots[t].index = t;
+		started[t] = (pthread_create(&threads[t], NULL, taskTrampoline, &slots[t]) == 0);
+	}
+
+	fn(context, 0U);
+
+	for (size_t t = 1; t < numTasks; t++)
+	{
+		if (started[t])
+		{
+			(void)pthread_join(threads[t], NULL);
+		}
+		else
+		{
+			fn(context, t);
+		}
+	}
+}
+
+#endif /* RADIX_HAVE_THREADS */
+
+/*
+ * Pomoćna funkcija: Sortiranje jednog niza sa već alociranim scratch-om
+ *
+ * scratch mora imati mesta za 2 * size elemenata. Mali nizovi idu na
+ * insertion sort direktno nad int32_t, ostali kroz LSD sa preskakanjem
+ * bajtova koji su isti za sve elemente (kod malih nizova česti su viši
+ * bajtovi koji se ne menjaju).
+ */
+static void sortWithScratch(int32_t* arr, size_t size, uint32_t* scratch)
+{
+	assert(arr != NULL);
+
+	if (size <= SMALL_SORT_THRESHOLD)
+	{
+		insertionSortI32(arr, size);
+		return;
+	}
+
+	assert(scratch != NULL);
+
+	for (size_t i = 0; i < size; i++)
+	{
+		scratch[i] = (uint32_t)arr[i] ^ SIGN_BIT;
+	}
+	lsdSortToInt32(scratch, scratch + size, arr, size, NUM_PASSES);
+}
+
+/*
+ * Pomoćna funkcija: Sortiranje dela batch-a [first, last) sa jednim scratch-om
+ *
+ * Scratch se alocira jednom, za najveći niz u opsegu koji ne staje u
+ * insertion sort, i deli se između svih nizova opsega.
+ */
+static void sortBatchRange(BatchTask* task)
+{
+	assert(task != NULL);
+
+	size_t maxSize = 0;
+	for (size_t i = task->first; i < task->last; i++)
+	{
+		if ((task->sizes[i] > SMALL_SORT_THRESHOLD) && (task->sizes[i] > maxSize))
+		{
+			maxSize = task->sizes[i];
+		}
+	}
+
+	task->result = SORT_SUCCESS;
+	task->scratch.ptr = NULL;
+	task->scratch.bytes = 0U;
+	task->scratch.pages = SORT_PAGES_NONE;
+	task->scratch.cached = false;
+
+	if ((maxSize > 0U) && !scratchAlloc(&task->scratch, 2U * maxSize * sizeof(uint32_t)))
+	{
+		task->result = SORT_ERROR_MEMORY;
+		return;
+	}
+
+	for (size_t i = task->first; i < task->last; i++)
+	{
+		if (task->sizes[i] > 1U)
+		{
+			sortWithScratch(task->arrays[i], task->sizes[i], (uint32_t*)task->scratch.ptr);
+		}
+	}
+
+	scratchFree(&task->scratch);
+}
+
+static void sortBatchTask(void* context, size_t index)
+{
+	BatchTask* tasks = (BatchTask*)context;
+	sortBatchRange(&tasks[index]);
+}
+
+SortResult radixSortBatch(int32_t** arrays, const size_t* sizes, size_t count)
+{
+	return radixSortBatchParallel(arrays, sizes, count, 1U);
+}
+
+SortResult radixSortBatchParallel(int32_t** arrays, const size_t* sizes, size_t count, size_t numThreads)
+{
+	if ((arrays == NULL) || (sizes == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (count == 0)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	/* Provera pre sortiranja - greška ne sme da ostavi batch delimično sortiran */
+	size_t total = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if ((arrays[i] == NULL) && (sizes[i] > 0U))
+		{
+			return SORT_ERROR_NULL;
+		}
+		total += sizes[i];
+	}
+
+	resetStats();
+
+#if RADIX_HAVE_THREADS
+	if (numThreads == 0U)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		numThreads = (online > 0) ? (size_t)online : 1U;
+	}
+#endif
+	if (numThreads > MAX_THREADS)
+	{
+		numThreads = MAX_THREADS;
+	}
+	if (numThreads > count)
+	{
+		numThreads = count;
+	}
+	size_t minPerThread = activeProfile()->parallelMinPerThread;
+	if (numThreads > total / minPerThread)
+	{
+		numThreads = total / minPerThread;
+	}
+	if (numThreads == 0U)
+	{
+		numThreads = 1U;
+	}
+
+	/* Susedni opsezi nizova sa približno jednakim brojem elemenata */
+	BatchTask tasks[MAX_THREADS];
+	size_t first = 0;
+	size_t done = 0;
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		size_t target = chunkStart(total, numThreads, t + 1U);
+		size_t last = first;
+		while ((last < count) && ((done < target) || (t + 1U == numThreads)))
+		{
+			done += sizes[last];
+			last++;
+		}
+		tasks[t].arrays = arrays;
+		tasks[t].sizes = sizes;
+		tasks[t].first = first;
+		tasks[t].last = last;
+		first = last;
+	}
+
+#if RADIX_HAVE_THREADS
+	runTasks(numThreads, sortBatchTask, tasks);
+#else
+	sortBatchTask(tasks, 0U);
+#endif
+
+	SortResult result = SORT_SUCCESS;
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		if (tasks[t].scratch.bytes > 0U)
+		{
+			recordScratch(&tasks[t].scratch);
+		}
+		if (tasks[t].result != SORT_SUCCESS)
+		{
+			result = tasks[t].result;
+		}
+	}
+	g_lastStats.threads = numThreads;
+	g_lastStats.strategy = SORT_STRATEGY_BATCH;
+
+	return result;
+}
+
+/*
+ * Pomoćna funkcija: Segmenti [firstSeg, lastSeg) kroz zajedničke globalne prolaze
+ *
+ * Svaki element dobija kompozitni 64-bitni ključ (segment << 32 | ključ).
+ * LSD prolazi idu samo po 4 bajta ključa (preskaču se bajtovi isti za
+ * sve), a završni prolaz je stabilno raspoređivanje po segmentu - pozicije
+ * segmenata su već poznate iz offsets, pa histogram nije potreban.
+ * Ukupno najviše 5 prolaza bez obzira na broj segmenata u bloku.
+ */
+static void sortSegmentsGlobal(SegmentTask* task, uint64_t* keys, uint64_t* tmp, size_t* positions)
+{
+	const size_t* offsets = task->offsets;
+	size_t lo = offsets[task->firstSeg];
+	size_t n = offsets[task->lastSeg] - lo;
+	int32_t* data = task->data + lo;
+
+	size_t count[NUM_PASSES][RADIX_SIZE] = {{0}};
+	for (size_t s = task->firstSeg; s < task->lastSeg; s++)
+	{
+		uint64_t segment = (uint64_t)(s - task->firstSeg) << 32;
+		for (size_t i = offsets[s]; i < offsets[s + 1U]; i++)
+		{
+			uint32_t value = (uint32_t)task->data[i] ^ SIGN_BIT;
+			keys[i - lo] = segment | value;
+			count[0][value & 0xFFU]++;
+			count[1][(value >> 8) & 0xFFU]++;
+			count[2][(value >> 16) & 0xFFU]++;
+			count[3][value >> 24]++;
+		}
+	}
+
+	uint64_t* input = keys;
+	uint64_t* output = tmp;
+	size_t passes = 0;
+
+	for (size_t b = 0; b < NUM_PASSES; b++)
+	{
+		size_t shift = b * RADIX_BITS;
+		if (count[b][(input[0] >> shift) & 0xFFU] == n)
+		{
+			continue;/*bajt je isti za sve elemente*/
+		}
+
+		size_t pos[RADIX_SIZE];
+		size_t sum = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			pos[d] = sum;
+			sum += count[b][d];
+		}
+		for (size_t i = 0; i < n; i++)
+		{
+			uint64_t key = input[i];
+			size_t digit = (size_t)(key >> shift) & 0xFFU;
+			output[pos[digit]] = key;
+			pos[digit]++;
+		}
+
+		uint64_t* swap = input;
+		input = output;
+		output = swap;
+		passes++;
+	}
+
+	if (passes == 0U)
+	{
+		return;/*svi ključevi su isti, svaki segment je već sortiran*/
+	}
+
+	/* Završni prolaz: stabilno po segmentu, direktno nazad u data */
+	for (size_t s = task->firstSeg; s < task->lastSeg; s++)
+	{
+		positions[s - task->firstSeg] = offsets[s] - lo;
+	}
+	for (size_t i = 0; i < n; i++)
+	{
+		uint64_t key = input[i];
+		size_t segment = (size_t)(key >> 32);
+		data[positions[segment]] = (int32_t)((uint32_t)key ^ SIGN_BIT);
+		positions[segment]++;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Sortiranje jedne grupe segmenata
+ *
+ * Uzastopni kratki segmenti se skupljaju u blokove do SEGMENT_BLOCK
+ * elemenata i svaki blok ide kroz zajedničke prolaze - hiljade posebnih
+ * sortiranja bi svako plaćalo svoje histograme, a blok ostaje u L2 kešu
+ * tokom svih prolaza. Segmenti duži od bloka sortiraju se pojedinačno sa
+ * istim scratch baferom, jer svaki ionako puni histograme.
+ */
+static void sortSegmentRange(SegmentTask* task)
+{
+	assert(task != NULL);
+
+	const size_t* offsets = task->offsets;
+
+	task->result = SORT_SUCCESS;
+	task->scratch.ptr = NULL;
+	task->scratch.bytes = 0U;
+	task->scratch.pages = SORT_PAGES_NONE;
+	task->scratch.cached = false;
+
+	size_t maxLong = 0;
+	for (size_t s = task->firstSeg; s < task->lastSeg; s++)
+	{
+		size_t length = offsets[s + 1U] - offsets[s];
+		maxLong = ((length > SEGMENT_BLOCK) && (length > maxLong)) ? length : maxLong;
+	}
+
+	size_t blockBytes = (2U * SEGMENT_BLOCK * sizeof(uint64_t)) + (SEGMENT_BLOCK * sizeof(size_t));
+	size_t longBytes = 2U * maxLong * sizeof(uint32_t);
+	if (offsets[task->lastSeg] - offsets[task->firstSeg] <= 1U)
+	{
+		return;
+	}
+	if (!scratchAlloc(&task->scratch, (longBytes > blockBytes) ? longBytes : blockBytes))
+	{
+		task->result = SORT_ERROR_MEMORY;
+		return;
+	}
+
+	uint64_t* keys = (uint64_t*)task->scratch.ptr;
+	size_t* positions = (size_t*)(keys + (2U * SEGMENT_BLOCK));
+
+	size_t s = task->firstSeg;
+	while (s < task->lastSeg)
+	{
+		size_t length = offsets[s + 1U] - offsets[s];
+		if (length > SEGMENT_BLOCK)
+		{
+			sortWithScratch(task->data + offsets[s], length, (uint32_t*)task->scratch.ptr);
+			s++;
+			continue;
+		}
+
+		/* Najduži niz kratkih segmenata koji staje u blok (i elementima i brojem segmenata) */
+		SegmentTask block = *task;
+		block.firstSeg = s;
+		while ((s < task->lastSeg) && (s - block.firstSeg < SEGMENT_BLOCK) &&
+		       (offsets[s + 1U] - offsets[block.firstSeg] <= SEGMENT_BLOCK))
+		{
+			s++;
+		}
+		block.lastSeg = s;
+
+		if (offsets[block.lastSeg] - offsets[block.firstSeg] > 1U)
+		{
+			sortSegmentsGlobal(&block, keys, keys + SEGMENT_BLOCK, positions);
+		}
+	}
+
+	scratchFree(&task->scratch);
+}
+
+static void sortSegmentTask(void* context, size_t index)
+{
+	SegmentTask* tasks = (SegmentTask*)context;
+	sortSegmentRange(&tasks[index]);
+}
+
+SortResult radixSortSegmented(int32_t* data, const size_t* offsets, size_t numSegments)
+{
+	return radixSortSegmentedParallel(data, offsets, numSegments, 1U);
+}
+
+SortResult radixSortSegmentedParallel(int32_t* data, const size_t* offsets, size_t numSegments, size_t numThreads)
+{
+	if ((data == NULL) || (offsets == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (numSegments == 0)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	for (size_t s = 0; s < numSegments; s++)
+	{
+		if (offsets[s + 1U] < offsets[s])
+		{
+			return SORT_ERROR_ARGUMENT;
+		}
+	}
+
+	resetStats();
+
+	size_t base = offsets[0];
+	size_t total = offsets[numSegments] - base;
+
+#if RADIX_HAVE_THREADS
+	if (numThreads == 0U)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		numThreads = (online > 0) ? (size_t)online : 1U;
+	}
+#endif
+	if (numThreads > MAX_THREADS)
+	{
+		numThreads = MAX_THREADS;
+	}
+	if (numThreads > numSegments)
+	{
+		numThreads = numSegments;
+	}
+	size_t minPerThread = activeProfile()->parallelMinPerThread;
+	if (numThreads > total / minPerThread)
+	{
+		numThreads = total / minPerThread;
+	}
+	if (numThreads == 0U)
+	{
+		numThreads = 1U;
+	}
+
+	/* Susedne grupe segmenata sa približno jednakim brojem elemenata */
+	SegmentTask tasks[MAX_THREADS];
+	size_t first = 0;
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		size_t target = base + chunkStart(total, numThreads, t + 1U);
+		size_t last = first;
+		while ((last < numSegments) && ((offsets[last] < target) || (t + 1U == numThreads)))
+		{
+			last++;
+		}
+		tasks[t].data = data;
+		tasks[t].offsets = offsets;
+		tasks[t].firstSeg = first;
+		tasks[t].lastSeg = last;
+		first = last;
+	}
+
+#if RADIX_HAVE_THREADS
+	runTasks(numThreads, sortSegmentTask, tasks);
+#else
+	sortSegmentTask(tasks, 0U);
+#endif
+
+	SortResult result = SORT_SUCCESS;
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		if (tasks[t].scratch.bytes > 0U)
+		{
+			recordScratch(&tasks[t].scratch);
+		}
+		if (tasks[t].result != SORT_SUCCESS)
+		{
+			result = tasks[t].result;
+		}
+	}
+	g_lastStats.threads = numThreads;
+	g_lastStats.strategy = SORT_STRATEGY_BATCH;
+
+	return result;
+}
+
+/*
+ * Kontekst sa trajnim pool-om thread-ova i scratch baferima
+ *
+ * Thread koji poziva sortiranje je uvek zadatak 0, pomoćni thread-ovi
+ * čekaju novu generaciju posla na workCond. Pozivi iz više thread-ova
+ * čekaju red na ticket lock-u (FIFO), pa jedan posao koristi ceo pool.
+ */
+struct RadixSortContext
+{
+	ScratchBuffer scratch1;
+	ScratchBuffer scratch2;
+	size_t capacity;   /* elemenata po baferu */
+	bool faulted;      /* stranice bafera su već dodeljene */
+	size_t numThreads; /* uključujući thread koji poziva */
+	size_t numaNodes;
+#if RADIX_HAVE_THREADS
+	pthread_t* threads;
+	ContextWorker* workers;
+	size_t (*hist)[NUM_PASSES][RADIX_SIZE];
+	size_t (*offsets)[RADIX_SIZE];
+	size_t* groupStart;
+
+	pthread_mutex_t mutex;
+	pthread_cond_t workCond;
+	pthread_cond_t doneCond;
+	size_t generation;
+	size_t active;  /* broj zadataka tekuće generacije */
+	size_t pending; /* pomoćni thread-ovi koji još rade */
+	bool stop;
+	void (*task)(void* arg, size_t index);
+	void* taskArg;
+
+	pthread_mutex_t queueMutex;
+	pthread_cond_t queueCond;
+	size_t nextTicket;
+	size_t serving;
+#endif
+};
+
+#if RADIX_HAVE_THREADS
+
+/*
+ * Pomoćna funkcija: Petlja pomoćnog thread-a iz pool-a
+ */
+static void* contextWorker(void* arg)
+{
+	ContextWorker* worker = (ContextWorker*)arg;
+	RadixSortContext* context = worker->context;
+	size_t seen = 0;
+
+	(void)pthread_mutex_lock(&context->mutex);
+	for (;;)
+	{
+		while ((context->generation == seen) && !context->stop)
+		{
+			(void)pthread_cond_wait(&context->workCond, &context->mutex);
+		}
+		if (context->stop)
+		{
+			break;
+		}
+		seen = context->generation;
+
+		if (worker->index < context->active)
+		{
+			void (*task)(void* taskArg, size_t index) = context->task;
+			void* taskArg = context->taskArg;
+			(void)pthread_mutex_unlock(&context->mutex);
+
+			task(taskArg, worker->index);
+
+			(void)pthread_mutex_lock(&context->mutex);
+			context->pending--;
+			if (context->pending == 0U)
+			{
+				(void)pthread_cond_signal(&context->doneCond);
+			}
+		}
+	}
+	(void)pthread_mutex_unlock(&context->mutex);
+
+	return NULL;
+}
+
+/*
+ * Pomoćna funkcija: Izvršava task(arg, 0..active-1) na pool-u
+ *
+ * Zadatak 0 radi thread koji poziva; vraća se kada su svi gotovi.
+ */
+static void contextRun(RadixSortContext* context, size_t active, void (*task)(void* arg, size_t index), void* arg)
+{
+	assert(active <= context->numThreads);
+
+	(void)pthread_mutex_lock(&context->mutex);
+	context->task = task;
+	context->taskArg = arg;
+	context->active = active;
+	context->pending = active - 1U;
+	context->generation++;
+	(void)pthread_cond_broadcast(&context->workCond);
+	(void)pthread_mutex_unlock(&context->mutex);
+
+	task(arg, 0U);
+
+	(void)pthread_mutex_lock(&context->mutex);
+	while (context->pending > 0U)
+	{
+		(void)pthread_cond_wait(&context->doneCond, &context->mutex);
+	}
+	(void)pthread_mutex_unlock(&context->mutex);
+}
+
+/* Ticket lock: pozivi iz više thread-ova dobijaju kontekst redom kojim su stigli */
+static void contextEnter(RadixSortContext* context)
+{
+	(void)pthread_mutex_lock(&context->queueMutex);
+	size_t ticket = context->nextTicket;
+	context->nextTicket++;
+	while (ticket != context->serving)
+	{
+		(void)pthread_cond_wait(&context->queueCond, &context->queueMutex);
+	}
+	(void)pthread_mutex_unlock(&context->queueMutex);
+}
+
+static void contextLeave(RadixSortContext* context)
+{
+	(void)pthread_mutex_lock(&context->queueMutex);
+	context->serving++;
+	(void)pthread_cond_broadcast(&context->queueCond);
+	(void)pthread_mutex_unlock(&context->queueMutex);
+}
+
+static void contextSortTask(void* arg, size_t index)
+{
+	parallelSortBody((ParallelShared*)arg, index);
+}
+
+#endif /* RADIX_HAVE_THREADS */
+
+/*
+ * Pomoćna funkcija: Prvi upis u deo index scratch bafera konteksta
+ *
+ * Svaki thread iz pool-a dodiruje svoj deo, pa sa pinovanjem stranice
+ * završe na njegovom NUMA čvoru.
+ */
+static void contextFaultTask(void* arg, size_t index)
+{
+	RadixSortContext* context = (RadixSortContext*)arg;
+	size_t lo = chunkStart(context->capacity, context->numThreads, index);
+	size_t hi = chunkStart(context->capacity, context->numThreads, index + 1U);
+
+	touchPages((uint32_t*)context->scratch1.ptr + lo, hi - lo);
+	touchPages((uint32_t*)context->scratch2.ptr + lo, hi - lo);
+}
+
+/*
+ * Pomoćna funkcija: Scratch baferi konteksta za bar size elemenata
+ *
+ * Posle povećanja stranice nisu dodeljene; prvi paralelni posao ih tada
+ * dodeljuje first-touch-om po grupama bucket-a.
+ */
+static bool contextReserve(RadixSortContext* context, size_t size)
+{
+	if (size <= context->capacity)
+	{
+		return true;
+	}
+
+	scratchFree(&context->scratch1);
+	scratchFree(&context->scratch2);
+	context->capacity = 0U;
+	context->faulted = false;
+
+	/* Kontekst živi duže od poziva i može se uništiti iz drugog thread-a: mimo keša */
+	if (!scratchAllocSystem(&context->scratch1, size * sizeof(uint32_t)))
+	{
+		return false;
+	}
+	if (!scratchAllocSystem(&context->scratch2, size * sizeof(uint32_t)))
+	{
+		scratchFree(&context->scratch1);
+		return false;
+	}
+
+	context->capacity = size;
+	return true;
+}
+
+SortResult radixSortContextCreate(RadixSortContext** context, size_t numThreads, size_t capacity)
+{
+	if (context == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+	*context = NULL;
+
+	RadixSortContext* created = (RadixSortContext*)calloc(1U, sizeof(RadixSortContext));
+	if (created == NULL)
+	{
+		return SORT_ERROR_MEMORY;
+	}
+
+#if RADIX_HAVE_THREADS
+	if (numThreads == 0U)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		numThreads = (online > 0) ? (size_t)online : 1U;
+	}
+	numThreads = (numThreads > MAX_THREADS) ? MAX_THREADS : numThreads;
+#else
+	numThreads = 1U;
+#endif
+	created->numThreads = numThreads;
+
+	if ((capacity > 0U) && !contextReserve(created, capacity))
+	{
+		free(created);
+		return SORT_ERROR_MEMORY;
+	}
+
+#if RADIX_HAVE_THREADS
+	created->threads = (pthread_t*)calloc(numThreads, sizeof(pthread_t));
+	created->workers = (ContextWorker*)calloc(numThreads, sizeof(ContextWorker));
+	created->hist = calloc(numThreads, sizeof(*created->hist));
+	created->offsets = calloc(numThreads, sizeof(*created->offsets));
+	created->groupStart = (size_t*)calloc(numThreads + 1U, sizeof(size_t));
+	if ((created->threads == NULL) || (created->workers == NULL) || (created->hist == NULL) ||
+	    (created->offsets == NULL) || (created->groupStart == NULL))
+	{
+		free(created->threads);
+		free(created->workers);
+		free(created->hist);
+		free(created->offsets);
+		free(created->groupStart);
+		scratchFree(&created->scratch1);
+		scratchFree(&created->scratch2);
+		free(created);
+		return SORT_ERROR_MEMORY;
+	}
+
+	(void)pthread_mutex_init(&created->mutex, NULL);
+	(void)pthread_cond_init(&created->workCond, NULL);
+	(void)pthread_cond_init(&created->doneCond, NULL);
+	(void)pthread_mutex_init(&created->queueMutex, NULL);
+	(void)pthread_cond_init(&created->queueCond, NULL);
+
+	(void)pthread_once(&g_topologyOnce, loadTopology);
+	bool pin = g_config.numaAware && (g_topology.numCpus > 0U);
+	bool nodeUsed[MAX_NUMA_NODES] = {false};
+
+	/* Pomoćni thread-ovi 1..numThreads-1; ako neki ne uspe, pool je manji */
+	size_t started = 1U;
+	for (size_t t = 1; t < numThreads; t++)
+	{
+		created->workers[t].context = created;
+		created->workers[t].index = t;
+
+		pthread_attr_t attr;
+		(void)pthread_attr_init(&attr);
+#if RADIX_HAVE_AFFINITY
+		if (pin)
+		{
+			size_t slot = (t * g_topology.numCpus) / numThreads;
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(g_topology.cpus[slot], &cpuSet);
+			(void)pthread_attr_setaffinity_np(&attr, sizeof(cpuSet), &cpuSet);
+			nodeUsed[g_topology.nodeOfCpu[slot]] = true;
+		}
+#endif
+		int rc = pthread_create(&created->threads[t], &attr, contextWorker, &created->workers[t]);
+		(void)pthread_attr_destroy(&attr);
+		if (rc != 0)
+		{
+			break;
+		}
+		started++;
+	}
+	created->numThreads = started;
+
+	for (size_t node = 0; pin && (node < MAX_NUMA_NODES); node++)
+	{
+		created->numaNodes += nodeUsed[node] ? 1U : 0U;
+	}
+
+	if (created->capacity > 0U)
+	{
+		contextRun(created, created->numThreads, contextFaultTask, created);
+		created->faulted = true;
+	}
+#else
+	if (created->capacity > 0U)
+	{
+		contextFaultTask(created, 0U);
+		created->faulted = true;
+	}
+#endif
+
+	*context = created;
+	return SORT_SUCCESS;
+}
+
+void radixSortContextDestroy(RadixSortContext* context)
+{
+	if (context == NULL)
+	{
+		return;
+	}
+
+#if RADIX_HAVE_THREADS
+	(void)pthread_mutex_lock(&context->mutex);
+	context->stop = true;
+	(void)pthread_cond_broadcast(&context->workCond);
+	(void)pthread_mutex_unlock(&context->mutex);
+
+	for (size_t t = 1; t < context->numThreads; t++)
+	{
+		(void)pthread_join(context->threads[t], NULL);
+	}
+
+	(void)pthread_cond_destroy(&context->queueCond);
+	(void)pthread_mutex_destroy(&context->queueMutex);
+	(void)pthread_cond_destroy(&context->doneCond);
+	(void)pthread_cond_destroy(&context->workCond);
+	(void)pthread_mutex_destroy(&context->mutex);
+	free(context->threads);
+	free(context->workers);
+	free(context->hist);
+	free(context->offsets);
+	free(context->groupStart);
+#endif
+
+	scratchFree(&context->scratch1);
+	scratchFree(&context->scratch2);
+	free(context);
+}
+
+SortResult radixSortWithContext(RadixSortContext* context, int32_t* arr, size_t size)
+{
+	if ((context == NULL) || (arr == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (size == 0)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+#if RADIX_HAVE_THREADS
+	contextEnter(context);
+#endif
+
+	resetStats();
+	SortResult result = SORT_SUCCESS;
+
+	if (size == 1U)
+	{
+		/* Jedan element je već sortiran */
+	}
+	else if (!contextReserve(context, size))
+	{
+		result = SORT_ERROR_MEMORY;
+	}
+	else
+	{
+		recordScratch(&context->scratch1);
+		recordScratch(&context->scratch2);
+
+		uint32_t* temp1 = (uint32_t*)context->scratch1.ptr;
+		uint32_t* temp2 = (uint32_t*)context->scratch2.ptr;
+
+		size_t numThreads = size / activeProfile()->poolMinPerThread;
+		numThreads = (numThreads > context->numThreads) ? context->numThreads : numThreads;
+
+#if RADIX_HAVE_THREADS
+		if (numThreads > 1U)
+		{
+			ParallelShared shared;
+			shared.arr = arr;
+			shared.size = size;
+			shared.primary = temp1;
+			shared.secondary = temp2;
+			shared.numThreads = numThreads;
+			shared.numaAware = g_config.numaAware && !context->faulted;/*dodeljene stranice se ne sele*/
+			shared.hist = context->hist;
+			shared.offsets = context->offsets;
+			shared.groupStart = context->groupStart;
+			(void)memset(shared.hist, 0, numThreads * sizeof(*shared.hist));
+			barrierInit(&shared.barrier, numThreads);
+
+			contextRun(context, numThreads, contextSortTask, &shared);
+
+			barrierDestroy(&shared.barrier);
+			g_lastStats.strategy = SORT_STRATEGY_PARALLEL;
+			g_lastStats.threads = numThreads;
+			g_lastStats.numaNodes = context->numaNodes;
+		}
+		else
+#endif
+		{
+			sortWithBuffers(arr, arr, size, NULL, temp1, temp2);
+		}
+
+		context->faulted = true;
+	}
+
+#if RADIX_HAVE_THREADS
+	contextLeave(context);
+#endif
+
+	return result;
+}
+
+/*
+ * Asinhrono sortiranje: jedan posao u redu pozadinskog pool-a
+ *
+ * Stanje (done, detached, result) se čita i menja samo pod
+ * g_async.mutex; svaki handle ima svoj cond da čekanje jednog posla ne
+ * budi sve ostale.
+ */
+struct RadixSortHandle
+{
+	int32_t* arr;
+	size_t size;
+	RadixSortCallback callback;
+	void* userdata;
+	SortResult result;
+	bool done;
+	bool detached;
+	RadixSortHandle* next; /* red poslova */
+#if RADIX_HAVE_THREADS
+	pthread_cond_t cond;
+#endif
+};
+
+#if RADIX_HAVE_THREADS
+
+/*
+ * Pozadinski pool za radixSortAsync: pravi se pri prvom pozivu i živi do
+ * kraja procesa. Svaki posao sortira jedan thread, pa više predatih
+ * nizova ide istovremeno na različitim jezgrima.
+ */
+typedef struct
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	RadixSortHandle* head;
+	RadixSortHandle* tail;
+	size_t numThreads;
+} AsyncPool;
+
+static AsyncPool g_async = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, NULL, 0U };
+static pthread_once_t g_asyncOnce = PTHREAD_ONCE_INIT;
+
+/*
+ * Pomoćna funkcija: Pokretanje pozadinskih thread-ova (jednom)
+ *
+ * Po jedan thread na dostupan CPU. Ako nijedan ne uspe, radixSortAsync
+ * sortira odmah u thread-u koji poziva.
+ */
+static void asyncStart(void)
+{
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t numThreads = (online > 0) ? (size_t)online : 1U;
+	numThreads = (numThreads > MAX_THREADS) ? MAX_THREADS : numThreads;
+
+	for (size_t t = 0; t < numThreads; t++)
+	{
+		pthread_t thread;
+		if (pthread_create(&thread, NULL, asyncWorker, NULL) != 0)
+		{
+			break;
+		}
+		(void)pthread_detach(thread);
+		g_async.numThreads++;
+	}
+}
+
+static void* asyncWorker(void* arg)
+{
+	(void)arg;
+
+	for (;;)
+	{
+		(void)pthread_mutex_lock(&g_async.mutex);
+		while (g_async.head == NULL)
+		{
+			(void)pthread_cond_wait(&g_async.cond, &g_async.mutex);
+		}
+		RadixSortHandle* handle = g_async.head;
+		g_async.head = handle->next;
+		if (g_async.head == NULL)
+		{
+			g_async.tail = NULL;
+		}
+		(void)pthread_mutex_unlock(&g_async.mutex);
+
+		asyncRun(handle);
+	}
+
+	return NULL;
+}
+
+#endif /* RADIX_HAVE_THREADS */
+
+/*
+ * Pomoćna funkcija: Izvršavanje jednog posla i objava završetka
+ *
+ * Callback se poziva pre nego što posao postane završen, pa posle
+ * radixSortWait callback je sigurno završio.
+ */
+static void asyncRun(RadixSortHandle* handle)
+{
+	SortResult result = handle->result;
+	if (result == SORT_SUCCESS)
+	{
+		result = radixSort(handle->arr, handle->size);
+	}
+
+	if (handle->callback != NULL)
+	{
+		handle->callback(handle->arr, handle->size, result, handle->userdata);
+	}
+
+#if RADIX_HAVE_THREADS
+	(void)pthread_mutex_lock(&g_async.mutex);
+	handle->result = result;
+	handle->done = true;
+	bool release = handle->detached;
+	(void)pthread_cond_signal(&handle->cond);
+	(void)pthread_mutex_unlock(&g_async.mutex);
+
+	if (release)
+	{
+		asyncFree(handle);
+	}
+#else
+	handle->result = result;
+	handle->done = true;
+#endif
+}
+
+static void asyncFree(RadixSortHandle* handle)
+{
+#if RADIX_HAVE_THREADS
+	(void)pthread_cond_destroy(&handle->cond);
+#endif
+	free(handle);
+}
+
+RadixSortHandle* radixSortAsync(int32_t* arr, size_t size, RadixSortCallback callback, void* userdata)
+{
+	RadixSortHandle* handle = (RadixSortHandle*)calloc(1U, sizeof(RadixSortHandle));
+	if (handle == NULL)
+	{
+		return NULL;
+	}
+
+	handle->arr = arr;
+	handle->size = size;
+	handle->callback = callback;
+	handle->userdata = userdata;
+	/* Greške argumenata se javljaju kroz rezultat posla, kao i sve ostalo */
+	handle->result = (arr == NULL) ? SORT_ERROR_NULL : ((size == 0U) ? SORT_ERROR_SIZE : SORT_SUCCESS);
+
+#if RADIX_HAVE_THREADS
+	(void)pthread_cond_init(&handle->cond, NULL);
+	(void)pthread_once(&g_asyncOnce, asyncStart);
+
+	if (g_async.numThreads > 0U)
+	{
+		(void)pthread_mutex_lock(&g_async.mutex);
+		if (g_async.tail == NULL)
+		{
+			g_async.head = handle;
+		}
+		else
+		{
+			g_async.tail->next = handle;
+		}
+		g_async.tail = handle;
+		(void)pthread_cond_signal(&g_async.cond);
+		(void)pthread_mutex_unlock(&g_async.mutex);
+		return handle;
+	}
+#endif
+
+	/* Nema pozadinskih thread-ova - posao se završava odmah */
+	asyncRun(handle);
+	return handle;
+}
+
+SortResult radixSortWait(RadixSortHandle* handle)
+{
+	if (handle == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+#if RADIX_HAVE_THREADS
+	(void)pthread_mutex_lock(&g_async.mutex);
+	while (!handle->done)
+	{
+		(void)pthread_cond_wait(&handle->cond, &g_async.mutex);
+	}
+	(void)pthread_mutex_unlock(&g_async.mutex);
+#endif
+
+	SortResult result = handle->result;
+	asyncFree(handle);
+	return result;
+}
+
+bool radixSortPoll(RadixSortHandle* handle, SortResult* result)
+{
+	if ((handle == NULL) || (result == NULL))
+	{
+		return false;
+	}
+
+#if RADIX_HAVE_THREADS
+	(void)pthread_mutex_lock(&g_async.mutex);
+	bool done = handle->done;
+	(void)pthread_mutex_unlock(&g_async.mutex);
+#else
+	bool done = handle->done;
+#endif
+
+	if (done)
+	{
+		*result = handle->result;
+		asyncFree(handle);
+	}
+	return done;
+}
+
+void radixSortDetach(RadixSortHandle* handle)
+{
+	if (handle == NULL)
+	{
+		return;
+	}
+
+#if RADIX_HAVE_THREADS
+	(void)pthread_mutex_lock(&g_async.mutex);
+	bool done = handle->done;
+	handle->detached = true;
+	(void)pthread_mutex_unlock(&g_async.mutex);
+#else
+	bool done = handle->done;
+#endif
+
+	if (done)
+	{
+		asyncFree(handle);
+	}
+}
+
+/*
+ * Zapakovan sortiran niz: delta + pakovanje bitova po blokovima
+ *
+ * Raspored (nativni redosled bajtova, bafer poravnat na 8):
+ *   zaglavlje  - uint32 magic, uint32 PACK_BLOCK, uint64 broj elemenata,
+ *                uint64 ukupno reči u podacima
+ *   direktor.  - po bloku: int32 prvi element, uint32 pomeraj u rečima
+ *   podaci     - po bloku 128 razlika uzastopnih elemenata (prva je 0) u
+ *                širini w bitova = tačno 4*w uint32 reči
+ *
+ * Razlika i-tog elementa ide u traku i % 4 na poziciju i / 4, a reč k
+ * trake t stoji na indeksu k*4 + t. Tako dekoder istim pomeranjem vadi
+ * 4 uzastopna elementa iz jednog SSE2 registra, bez grananja po elementu.
+ * Širina bloka se ne čuva: to je (pomeraj sledećeg - pomeraj) / 4.
+ */
+
+/*
+ * Pomoćna funkcija: Broj bitova potreban za vrednost (0 za 0)
+ */
+static uint32_t bitWidth(uint32_t value)
+{
+	uint32_t width = 0U;
+	while (value != 0U)
+	{
+		width++;
+		value >>= 1;
+	}
+	return width;
+}
+
+/*
+ * Pomoćna funkcija: Pakovanje 128 razlika u 4*width reči (vertikalno)
+ */
+static void packBlock(const uint32_t* deltas, uint32_t width, uint32_t* words)
+{
+	for (uint32_t lane = 0; lane < PACK_LANES; lane++)
+	{
+		uint64_t buffer = 0U;
+		uint32_t bits = 0U;
+		uint32_t k = 0U;
+
+		for (uint32_t j = 0; j < (PACK_BLOCK / PACK_LANES); j++)
+		{
+			buffer |= (uint64_t)deltas[(j * PACK_LANES) + lane] << bits;
+			bits += width;
+			if (bits >= 32U)
+			{
+				words[(k * PACK_LANES) + lane] = (uint32_t)buffer;
+				buffer >>= 32;
+				bits -= 32U;
+				k++;
+			}
+		}
+	}
+}
+
+/*
+ * Pomoćna funkcija: Raspakivanje bloka i prefiksna suma (128 elemenata)
+ *
+ * SSE2: registar drži reč k sve 4 trake, pa jedno pomeranje daje 4
+ * uzastopna elementa. Prefiksna suma unutar registra ide sa dva
+ * pomeranja bajtova, a prenos između registara je poslednja traka.
+ */
+static void unpackBlock(const uint32_t* words, uint32_t width, int32_t first, int32_t* out)
+{
+#if RADIX_HAVE_SSE2
+	__m128i carry = _mm_set1_epi32(first);
+
+	if (width == 0U)
+	{
+		for (uint32_t j = 0; j < (PACK_BLOCK / PACK_LANES); j++)
+		{
+			_mm_storeu_si128((__m128i*)(void*)(out + (j * PACK_LANES)), carry);
+		}
+		return;
+	}
+
+	const __m128i mask = (width == 32U) ? _mm_set1_epi32(-1) : _mm_set1_epi32((int32_t)((1U << width) - 1U));
+	const __m128i* source = (const __m128i*)(const void*)words;
+	__m128i current = _mm_loadu_si128(source);
+	uint32_t bits = 0U;
+	uint32_t k = 0U;
+
+	for (uint32_t j = 0; j < (PACK_BLOCK / PACK_LANES); j++)
+	{
+		__m128i value = _mm_srl_epi32(current, _mm_cvtsi32_si128((int)bits));
+		bits += width;
+		if (bits >= 32U)
+		{
+			k++;
+			bits -= 32U;
+			if (k < width)
+			{
+				current = _mm_loadu_si128(source + k);
+				if (bits > 0U)
+				{
+					/* Vrednost prelazi granicu reči: donji deo je već u value */
+					value = _mm_or_si128(value, _mm_sll_epi32(current, _mm_cvtsi32_si128((int)(width - bits))));
+				}
+			}
+		}
+		value = _mm_and_si128(value, mask);
+
+		value = _mm_add_epi32(value, _mm_slli_si128(value, 4));
+		value = _mm_add_epi32(value, _mm_slli_si128(value, 8));
+		value = _mm_add_epi32(value, carry);
+		_mm_storeu_si128((__m128i*)(void*)(out + (j * PACK_LANES)), value);
+		carry = _mm_shuffle_epi32(value, 0xFF);
+	}
+#else
+	uint32_t deltas[PACK_BLOCK];
+	const uint32_t mask = (width == 32U) ? 0xFFFFFFFFU : ((1U << width) - 1U);
+
+	for (uint32_t lane = 0; lane < PACK_LANES; lane++)
+	{
+		uint64_t buffer = 0U;
+		uint32_t bits = 0U;
+		uint32_t k = 0U;
+
+		for (uint32_t j = 0; j < (PACK_BLOCK / PACK_LANES); j++)
+		{
+			if ((bits < width) && (k < width))
+			{
+				buffer |= (uint64_t)words[(k * PACK_LANES) + lane] << bits;
+				bits += 32U;
+				k++;
+			}
+			deltas[(j * PACK_LANES) + lane] = (uint32_t)buffer & mask;
+			buffer >>= width;
+			bits -= width;
+		}
+	}
+
+	uint32_t value = (uint32_t)first;
+	for (uint32_t i = 0; i < PACK_BLOCK; i++)
+	{
+		value += deltas[i];
+		out[i] = (int32_t)value;
+	}
+#endif
+}
+
+/*
+ * Pomoćna funkcija: Provera zaglavlja, dužine i direktorijuma zapakovanog bafera
+ *
+ * Bafer dolazi iz keša ili sa diska, pa se pre raspakivanja proverava i
+ * direktorijum: pomeraji blokova ne opadaju, poslednji ne prelazi broj
+ * reči, a svaki blok ima umnožak PACK_LANES reči i širinu do 32 bita.
+ * Posle ove provere packedBlock ne može da čita van bafera.
+ */
+static bool packedHeader(const uint8_t* packed, size_t bytes, size_t* count, size_t* numBlocks)
+{
+	if ((bytes < PACK_HEADER_BYTES) || (((uintptr_t)packed & 7U) != 0U))
+	{
+		return false;
+	}
+
+	const uint32_t* header = (const uint32_t*)(const void*)packed;
+	const uint64_t* sizes = (const uint64_t*)(const void*)(packed + 8U);
+	if ((header[0] != PACK_MAGIC) || (header[1] != PACK_BLOCK) || (sizes[0] > SIZE_MAX))
+	{
+		return false;
+	}
+
+	size_t blocks = ((size_t)sizes[0] + PACK_BLOCK - 1U) / PACK_BLOCK;
+	size_t dataOffset = PACK_HEADER_BYTES + (blocks * PACK_ENTRY_BYTES);
+	if ((blocks > ((SIZE_MAX - PACK_HEADER_BYTES) / PACK_ENTRY_BYTES)) || (dataOffset > bytes) ||
+	    (sizes[1] > ((bytes - dataOffset) / sizeof(uint32_t))))
+	{
+		return false;
+	}
+
+	const uint32_t* directory = (const uint32_t*)(const void*)(packed + PACK_HEADER_BYTES);
+	for (size_t b = 0; b < blocks; b++)
+	{
+		uint64_t start = directory[(b * 2U) + 1U];
+		uint64_t end = ((b + 1U) < blocks) ? directory[(b * 2U) + 3U] : sizes[1];
+		if ((start > end) || (end > sizes[1]) || (((end - start) % PACK_LANES) != 0U) ||
+		    (((end - start) / PACK_LANES) > 32U))
+		{
+			return false;
+		}
+	}
+
+	*count = (size_t)sizes[0];
+	*numBlocks = blocks;
+	return true;
+}
+
+/*
+ * Pomoćna funkcija: Prvi element, reči i širina jednog bloka
+ */
+static uint32_t packedBlock(const uint8_t* packed, size_t numBlocks, size_t block, int32_t* first, const uint32_t** words)
+{
+	const uint32_t* directory = (const uint32_t*)(const void*)(packed + PACK_HEADER_BYTES);
+	const uint32_t* data = directory + (numBlocks * 2U);
+	uint64_t totalWords = ((const uint64_t*)(const void*)(packed + 8U))[1];
+
+	uint64_t start = directory[(block * 2U) + 1U];
+	uint64_t end = ((block + 1U) < numBlocks) ? directory[(block * 2U) + 3U] : totalWords;
+
+	*first = (int32_t)directory[block * 2U];
+	*words = data + start;
+	return (uint32_t)((end - start) / PACK_LANES);
+}
+
+size_t radixPackedBound(size_t size)
+{
+	size_t blocks = (size + PACK_BLOCK - 1U) / PACK_BLOCK;
+	return PACK_HEADER_BYTES + (blocks * (PACK_ENTRY_BYTES + (PACK_BLOCK * sizeof(uint32_t))));
+}
+
+SortResult radixPackedEncode(const int32_t* sorted, size_t size, uint8_t* out, size_t capacity, size_t* bytes)
+{
+	if ((sorted == NULL) || (out == NULL) || (bytes == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (size == 0U)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	size_t blocks = (size + PACK_BLOCK - 1U) / PACK_BLOCK;
+	if (blocks > (UINT32_MAX / PACK_BLOCK))
+	{
+		return SORT_ERROR_SIZE; /* pomeraj bloka u rečima mora stati u uint32 */
+	}
+
+	size_t dataOffset = PACK_HEADER_BYTES + (blocks * PACK_ENTRY_BYTES);
+	if ((((uintptr_t)out & 7U) != 0U) || (capacity < dataOffset))
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	uint32_t* directory = (uint32_t*)(void*)(out + PACK_HEADER_BYTES);
+	uint32_t* data = directory + (blocks * 2U);
+	size_t capacityWords = (capacity - dataOffset) / sizeof(uint32_t);
+	size_t totalWords = 0U;
+	uint32_t deltas[PACK_BLOCK];
+
+	for (size_t b = 0; b < blocks; b++)
+	{
+		size_t start = b * PACK_BLOCK;
+		size_t length = ((size - start) < PACK_BLOCK) ? (size - start) : PACK_BLOCK;
+		uint32_t any = 0U;
+
+		/* Nesortiran ulaz bi dao "negativnu" razliku - proverava se usput */
+		deltas[0] = 0U;
+		for (size_t i = 1; i < length; i++)
+		{
+			if (sorted[start + i] < sorted[start + i - 1U])
+			{
+				return SORT_ERROR_ARGUMENT;
+			}
+			deltas[i] = (uint32_t)sorted[start + i] - (uint32_t)sorted[start + i - 1U];
+			any |= deltas[i];
+		}
+		for (size_t i = length; i < PACK_BLOCK; i++)
+		{
+			deltas[i] = 0U;
+		}
+		if ((b > 0U) && (sorted[start] < sorted[start - 1U]))
+		{
+			return SORT_ERROR_ARGUMENT;
+		}
+
+		uint32_t width = bitWidth(any);
+		size_t words = (size_t)width * PACK_LANES;
+		if (words > (capacityWords - totalWords))
+		{
+			return SORT_ERROR_ARGUMENT;
+		}
+
+		directory[b * 2U] = (uint32_t)sorted[start];
+		directory[(b * 2U) + 1U] = (uint32_t)totalWords;
+		packBlock(deltas, width, data + totalWords);
+		totalWords += words;
+	}
+
+	uint32_t* header = (uint32_t*)(void*)out;
+	uint64_t* sizes = (uint64_t*)(void*)(out + 8U);
+	header[0] = PACK_MAGIC;
+	header[1] = PACK_BLOCK;
+	sizes[0] = (uint64_t)size;
+	sizes[1] = (uint64_t)totalWords;
+
+	*bytes = dataOffset + (totalWords * sizeof(uint32_t));
+	return SORT_SUCCESS;
+}
+
+SortResult radixSortPacked(int32_t* arr, size_t size, uint8_t* out, size_t capacity, size_t* bytes)
+{
+	if ((out == NULL) || (bytes == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	SortResult result = radixSort(arr, size);
+	if (result != SORT_SUCCESS)
+	{
+		return result;
+	}
+
+	return radixPackedEncode(arr, size, out, capacity, bytes);
+}
+
+SortResult radixPackedDecode(const uint8_t* packed, size_t bytes, int32_t* out, size_t capacity, size_t* count)
+{
+	if ((packed == NULL) || (out == NULL) || (count == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	size_t size = 0U;
+	size_t blocks = 0U;
+	if (!packedHeader(packed, bytes, &size, &blocks))
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	*count = size;
+	if (capacity < size)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	int32_t tail[PACK_BLOCK];
+	for (size_t b = 0; b < blocks; b++)
+	{
+		int32_t first = 0;
+		const uint32_t* words = NULL;
+		uint32_t width = packedBlock(packed, blocks, b, &first, &words);
+		size_t start = b * PACK_BLOCK;
+
+		if ((size - start) >= PACK_BLOCK)
+		{
+			unpackBlock(words, width, first, out + start);
+		}
+		else
+		{
+			/* Poslednji blok je nepotpun - raspakuje se sa strane */
+			unpackBlock(words, width, first, tail);
+			memcpy(out + start, tail, (size - start) * sizeof(int32_t));
+		}
+	}
+
+	return SORT_SUCCESS;
+}
+
+SortResult radixPackedFind(const uint8_t* packed, size_t bytes, int32_t value, size_t* index)
+{
+	if ((packed == NULL) || (index == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	size_t size = 0U;
+	size_t blocks = 0U;
+	if (!packedHeader(packed, bytes, &size, &blocks))
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	/* Poslednji blok čiji je prvi element < value; posle njega su svi >= value */
+	const uint32_t* directory = (const uint32_t*)(const void*)(packed + PACK_HEADER_BYTES);
+	size_t low = 0U;
+	size_t high = blocks;
+	while (low < high)
+	{
+		size_t middle = low + ((high - low) / 2U);
+		if ((int32_t)directory[middle * 2U] < value)
+		{
+			low = middle + 1U;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	if (low == 0U)
+	{
+		*index = 0U;
+		return SORT_SUCCESS;
+	}
+
+	size_t block = low - 1U;
+	int32_t first = 0;
+	const uint32_t* words = NULL;
+	uint32_t width = packedBlock(packed, blocks, block, &first, &words);
+	int32_t values[PACK_BLOCK];
+	unpackBlock(words, width, first, values);
+
+	size_t start = block * PACK_BLOCK;
+	size_t length = ((size - start) < PACK_BLOCK) ? (size - start) : PACK_BLOCK;
+	size_t position = 1U; /* values[0] = first < value */
+	while ((position < length) && (values[position] < value))
+	{
+		position++;
+	}
+
+	*index = start + position;
+	return SORT_SUCCESS;
+}
+
+/*
+ * Pomoćna funkcija: Rasipanje parova (ključ << 32 | index) po bajtu ključa
+ */
+static void scatterEntries(const uint64_t* entries, size_t size, uint64_t* output, size_t shift, size_t offsets[RADIX_SIZE])
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		uint64_t entry = entries[i];
+		size_t digit = (size_t)(entry >> (32U + shift)) & 0xFFU;
+		output[offsets[digit]] = entry;
+		offsets[digit]++;
+	}
+}
+
+/*
+ * Pomoćna funkcija: LSD prolazi nad parovima (ključ << 32 | index)
+ *
+ * count su histogrami transformisanih ključeva, min i max njihov opseg.
+ * Kao u lsdSortKeys, uzak opseg oko granice bajta (npr. [-100, 100])
+ * menja sve bajtove, pa se ključevi tada umanje za min. Po završetku
+ * *entries pokazuje na sortirane parove (pokazivači se menjaju mestima).
+ * Vraća broj prolaza.
+ */
+static size_t lsdSortEntries(uint64_t** entries, uint64_t** other, size_t n, size_t count[NUM_PASSES][RADIX_SIZE], uint32_t min, uint32_t max)
+{
+	uint64_t* input = *entries;
+	uint64_t* output = *other;
+
+	size_t rawActive = 0;
+	for (size_t b = 0; b < NUM_PASSES; b++)
+	{
+		rawActive += (count[b][(min >> (b * RADIX_BITS)) & 0xFFU] != n) ? 1U : 0U;
+	}
+	if (significantBytes(max - min) < rawActive)
+	{
+		(void)memset(count, 0, NUM_PASSES * RADIX_SIZE * sizeof(size_t));
+		for (size_t i = 0; i < n; i++)
+		{
+			uint32_t key = (uint32_t)(input[i] >> 32) - min;
+			input[i] = ((uint64_t)key << 32) | (uint32_t)input[i];
+			count[0][key & 0xFFU]++;
+			count[1][(key >> 8) & 0xFFU]++;
+			count[2][(key >> 16) & 0xFFU]++;
+			count[3][key >> 24]++;
+		}
+	}
+
+	size_t passes = 0;
+	for (size_t b = 0; b < NUM_PASSES; b++)
+	{
+		size_t digit = (size_t)(input[0] >> (32U + (b * RADIX_BITS))) & 0xFFU;
+		if (count[b][digit] == n)
+		{
+			continue; /* bajt isti za sve - prolaz ne menja redosled */
+		}
+
+		size_t offsets[RADIX_SIZE];
+		size_t sum = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			offsets[d] = sum;
+			sum += count[b][d];
+		}
+
+		scatterEntries(input, n, output, b * RADIX_BITS, offsets);
+		uint64_t* swap = input;
+		input = output;
+		output = swap;
+		passes++;
+	}
+
+	*entries = input;
+	*other = output;
+	return passes;
+}
+
+SortResult radixSortColumns(const int32_t** cols, size_t numCols, size_t n, uint32_t* perm)
+{
+	if ((cols == NULL) || (perm == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (numCols == 0U)
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	for (size_t c = 0; c < numCols; c++)
+	{
+		if (cols[c] == NULL)
+		{
+			return SORT_ERROR_NULL;
+		}
+	}
+
+	if ((n == 0U) || (n > (size_t)UINT32_MAX))
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	resetStats();
+
+	if (n == 1U)
+	{
+		perm[0] = 0U;
+		g_lastStats.strategy = SORT_STRATEGY_NONE;
+		return SORT_SUCCESS;
+	}
+
+	/*
+	 * Par (ključ, index) u jednoj uint64 reči: rasipanje pomera 8 bajtova
+	 * jednim upisom, a index nosi permutaciju kroz sve kolone.
+	 */
+	ScratchBuffer scratch1;
+	if (!scratchAlloc(&scratch1, n * sizeof(uint64_t)))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	ScratchBuffer scratch2;
+	if (!scratchAlloc(&scratch2, n * sizeof(uint64_t)))
+	{
+		scratchFree(&scratch1);
+		return SORT_ERROR_MEMORY;
+	}
+	recordScratch(&scratch1);
+	recordScratch(&scratch2);
+
+	uint64_t* entries = (uint64_t*)scratch1.ptr;
+	uint64_t* other = (uint64_t*)scratch2.ptr;
+	size_t passes = 0;
+
+	/* LSD po kolonama: poslednja kolona prva, stabilni prolazi čuvaju redosled prethodnih */
+	for (size_t c = numCols; c > 0U; c--)
+	{
+		const int32_t* column = cols[c - 1U];
+		bool identity = (c == numCols);
+		size_t count[NUM_PASSES][RADIX_SIZE] = {{0}};
+		uint32_t min = UINT32_MAX;
+		uint32_t max = 0;
+
+		/* Ključevi kolone u tekućem redosledu; osim za prvu kolonu čitanje je nasumično */
+		for (size_t i = 0; i < n; i++)
+		{
+			uint32_t index = identity ? (uint32_t)i : (uint32_t)entries[i];
+			if (!identity && ((i + GATHER_PREFETCH_DISTANCE) < n))
+			{
+				RADIX_PREFETCH(&column[(uint32_t)entries[i + GATHER_PREFETCH_DISTANCE]]);
+			}
+			uint32_t key = (uint32_t)column[index] ^ SIGN_BIT;
+			min = (key < min) ? key : min;
+			max = (key > max) ? key : max;
+			entries[i] = ((uint64_t)key << 32) | index;
+			count[0][key & 0xFFU]++;
+			count[1][(key >> 8) & 0xFFU]++;
+			count[2][(key >> 16) & 0xFFU]++;
+			count[3][key >> 24]++;
+		}
+
+		passes += lsdSortEntries(&entries, &other, n, count, min, max);
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		perm[i] = (uint32_t)entries[i];
+	}
+
+	g_lastStats.strategy = SORT_STRATEGY_LSD;
+	g_lastStats.passes = passes;
+
+	scratchFree(&scratch1);
+	scratchFree(&scratch2);
+	return SORT_SUCCESS;
+}
+
+/*
+ * Pomoćna funkcija: Transformisan ključ zapisa (polje ne mora biti poravnato)
+ */
+static uint32_t recordKey(const uint8_t* record)
+{
+	int32_t key;
+	(void)memcpy(&key, record, sizeof(key));
+	return (uint32_t)key ^ SIGN_BIT;
+}
+
+/*
+ * Pomoćna funkcija: Kopiranje jednog zapisa
+ *
+ * Česte veličine idu kroz memcpy sa konstantnom dužinom, koji kompajler
+ * pretvara u nekoliko upisa umesto poziva funkcije.
+ */
+static void moveRecord(uint8_t* output, const uint8_t* input, size_t stride)
+{
+	switch (stride)
+	{
+		case 4U:
+			(void)memcpy(output, input, 4U);
+			break;
+		case 8U:
+			(void)memcpy(output, input, 8U);
+			break;
+		case 12U:
+			(void)memcpy(output, input, 12U);
+			break;
+		case 16U:
+			(void)memcpy(output, input, 16U);
+			break;
+		case 24U:
+			(void)memcpy(output, input, 24U);
+			break;
+		case 32U:
+			(void)memcpy(output, input, 32U);
+			break;
+		default:
+			(void)memcpy(output, input, stride);
+			break;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Mali zapisi - prolazi pomeraju cele zapise
+ *
+ * Isti izbor prolaza kao za int32_t niz (umanjenje za min kada štedi
+ * prolaze, preskakanje konstantnih bajtova). Posle neparnog broja
+ * prolaza rezultat se kopira nazad u base.
+ */
+static SortResult sortRecordsMoving(uint8_t* base, size_t n, size_t stride, size_t keyOffset)
+{
+	ScratchBuffer scratch;
+	if (!scratchAlloc(&scratch, n * stride))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	recordScratch(&scratch);
+
+	size_t count[NUM_PASSES][RADIX_SIZE] = {{0}};
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+	for (size_t i = 0; i < n; i++)
+	{
+		uint32_t key = recordKey(base + (i * stride) + keyOffset);
+		min = (key < min) ? key : min;
+		max = (key > max) ? key : max;
+		count[0][key & 0xFFU]++;
+		count[1][(key >> 8) & 0xFFU]++;
+		count[2][(key >> 16) & 0xFFU]++;
+		count[3][key >> 24]++;
+	}
+
+	size_t rawActive = 0;
+	for (size_t b = 0; b < NUM_PASSES; b++)
+	{
+		rawActive += (count[b][(min >> (b * RADIX_BITS)) & 0xFFU] != n) ? 1U : 0U;
+	}
+	uint32_t rebase = 0U;
+	if (significantBytes(max - min) < rawActive)
+	{
+		rebase = min;
+		(void)memset(count, 0, sizeof(count));
+		for (size_t i = 0; i < n; i++)
+		{
+			uint32_t key = recordKey(base + (i * stride) + keyOffset) - rebase;
+			count[0][key & 0xFFU]++;
+			count[1][(key >> 8) & 0xFFU]++;
+			count[2][(key >> 16) & 0xFFU]++;
+			count[3][key >> 24]++;
+		}
+	}
+
+	uint8_t* input = base;
+	uint8_t* output = (uint8_t*)scratch.ptr;
+	size_t passes = 0;
+	uint32_t firstKey = recordKey(base + keyOffset) - rebase;
+
+	for (size_t b = 0; b < NUM_PASSES; b++)
+	{
+		size_t shift = b * RADIX_BITS;
+		if (count[b][(firstKey >> shift) & 0xFFU] == n)
+		{
+			continue;
+		}
+
+		size_t offsets[RADIX_SIZE];
+		size_t sum = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			offsets[d] = sum;
+			sum += count[b][d];
+		}
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const uint8_t* record = input + (i * stride);
+			size_t digit = ((recordKey(record + keyOffset) - rebase) >> shift) & 0xFFU;
+			moveRecord(output + (offsets[digit] * stride), record, stride);
+			offsets[digit]++;
+		}
+
+		uint8_t* swap = input;
+		input = output;
+		output = swap;
+		passes++;
+	}
+
+	if (input != base)
+	{
+		(void)memcpy(base, input, n * stride);
+	}
+
+	g_lastStats.strategy = (passes == 0U) ? SORT_STRATEGY_NONE : SORT_STRATEGY_LSD;
+	g_lastStats.passes = passes;
+	scratchFree(&scratch);
+	return SORT_SUCCESS;
+}
+
+/*
+ * Pomoćna funkcija: Veći zapisi - sortiraju se (ključ, index) parovi
+ *
+ * Prolazi pomeraju 8 bajtova po zapisu umesto celog zapisa, a zapisi se
+ * na kraju premeštaju jednom:
+ *  - do RECORD_CYCLE_MIN_STRIDE gather u scratch (nezavisna nasumična
+ *    čitanja se preklapaju) pa kopija nazad
+ *  - za veće zapise praćenjem ciklusa permutacije u mestu: svaki zapis se
+ *    čita i upisuje tačno jednom, uz jedan privremeni zapis i bez
+ *    n * stride scratch-a. Čitanja su tada lanac zavisnih promašaja, ali
+ *    kod velikih zapisa dominira količina kopiranih bajtova.
+ *    Obrađen element permutacije se označi sa perm[j] = j.
+ */
+static SortResult sortRecordsByIndex(uint8_t* base, size_t n, size_t stride, size_t keyOffset)
+{
+	ScratchBuffer scratch1;
+	if (!scratchAlloc(&scratch1, n * sizeof(uint64_t)))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	ScratchBuffer scratch2;
+	if (!scratchAlloc(&scratch2, n * sizeof(uint64_t)))
+	{
+		scratchFree(&scratch1);
+		return SORT_ERROR_MEMORY;
+	}
+	bool inPlace = (stride >= RECORD_CYCLE_MIN_STRIDE);
+	ScratchBuffer records;
+	if (!scratchAlloc(&records, inPlace ? stride : (n * stride)))
+	{
+		scratchFree(&scratch1);
+		scratchFree(&scratch2);
+		return SORT_ERROR_MEMORY;
+	}
+	recordScratch(&scratch1);
+	recordScratch(&scratch2);
+	recordScratch(&records);
+
+	uint64_t* entries = (uint64_t*)scratch1.ptr;
+	uint64_t* other = (uint64_t*)scratch2.ptr;
+	size_t count[NUM_PASSES][RADIX_SIZE] = {{0}};
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+	for (size_t i = 0; i < n; i++)
+	{
+		uint32_t key = recordKey(base + (i * stride) + keyOffset);
+		min = (key < min) ? key : min;
+		max = (key > max) ? key : max;
+		entries[i] = ((uint64_t)key << 32) | (uint32_t)i;
+		count[0][key & 0xFFU]++;
+		count[1][(key >> 8) & 0xFFU]++;
+		count[2][(key >> 16) & 0xFFU]++;
+		count[3][key >> 24]++;
+	}
+
+	size_t passes = lsdSortEntries(&entries, &other, n, count, min, max);
+
+	uint32_t* perm = (uint32_t*)(void*)other;
+	for (size_t i = 0; i < n; i++)
+	{
+		perm[i] = (uint32_t)entries[i];
+	}
+
+	uint8_t* saved = (uint8_t*)records.ptr;
+	if (!inPlace)
+	{
+		(void)radixGather(base, stride, n, perm, saved);
+		(void)memcpy(base, saved, n * stride);
+	}
+
+	for (size_t i = 0; inPlace && (i < n); i++)
+	{
+		if (perm[i] == (uint32_t)i)
+		{
+			continue;
+		}
+
+		(void)memcpy(saved, base + (i * stride), stride);
+		size_t j = i;
+		for (;;)
+		{
+			size_t k = perm[j];
+			perm[j] = (uint32_t)j;
+			if (k == i)
+			{
+				(void)memcpy(base + (j * stride), saved, stride);
+				break;
+			}
+			(void)memcpy(base + (j * stride), base + (k * stride), stride);
+			j = k;
+		}
+	}
+
+	g_lastStats.strategy = (passes == 0U) ? SORT_STRATEGY_NONE : SORT_STRATEGY_LSD;
+	g_lastStats.passes = passes;
+	scratchFree(&records);
+	scratchFree(&scratch1);
+	scratchFree(&scratch2);
+	return SORT_SUCCESS;
+}
+
+SortResult radixSortRecords(void* base, size_t n, size_t stride, size_t keyOffset)
+{
+	if (base == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (n == 0U)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	if ((stride < sizeof(int32_t)) || (keyOffset > (stride - sizeof(int32_t))) || (n > (SIZE_MAX / stride)))
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	resetStats();
+
+	if (n == 1U)
+	{
+		g_lastStats.strategy = SORT_STRATEGY_NONE;
+		return SORT_SUCCESS;
+	}
+
+	if ((stride >= RECORD_GATHER_MIN_STRIDE) && (n <= (size_t)UINT32_MAX))
+	{
+		return sortRecordsByIndex((uint8_t*)base, n, stride, keyOffset);
+	}
+	return sortRecordsMoving((uint8_t*)base, n, stride, keyOffset);
+}
+
+SortResult radixGather(const void* src, size_t elemSize, size_t n, const uint32_t* perm, void* dst)
+{
+	if ((src == NULL) || (perm == NULL) || (dst == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (elemSize == 0U)
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	if (n == 0U)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	/*
+	 * Upisi su sekvencijalni, čitanja nasumična: čitanje GATHER_PREFETCH_DISTANCE
+	 * elemenata unapred se najavi, pa više promašaja keša čeka istovremeno.
+	 * Česte širine imaju svoju petlju da kopiranje ne ide kroz memcpy.
+	 */
+	if (elemSize == sizeof(uint32_t))
+	{
+		const uint32_t* source = (const uint32_t*)src;
+		uint32_t* target = (uint32_t*)dst;
+		for (size_t i = 0; i < n; i++)
+		{
+			if ((i + GATHER_PREFETCH_DISTANCE) < n)
+			{
+				RADIX_PREFETCH(&source[perm[i + GATHER_PREFETCH_DISTANCE]]);
+			}
+			target[i] = source[perm[i]];
+		}
+	}
+	else if (elemSize == sizeof(uint64_t))
+	{
+		const uint64_t* source = (const uint64_t*)src;
+		uint64_t* target = (uint64_t*)dst;
+		for (size_t i = 0; i < n; i++)
+		{
+			if ((i + GATHER_PREFETCH_DISTANCE) < n)
+			{
+				RADIX_PREFETCH(&source[perm[i + GATHER_PREFETCH_DISTANCE]]);
+			}
+			target[i] = source[perm[i]];
+		}
+	}
+	else
+	{
+		const uint8_t* source = (const uint8_t*)src;
+		uint8_t* target = (uint8_t*)dst;
+		for (size_t i = 0; i < n; i++)
+		{
+			if ((i + GATHER_PREFETCH_DISTANCE) < n)
+			{
+				RADIX_PREFETCH(source + ((size_t)perm[i + GATHER_PREFETCH_DISTANCE] * elemSize));
+			}
+			(void)memcpy(target + (i * elemSize), source + ((size_t)perm[i] * elemSize), elemSize);
+		}
+	}
+
+	return SORT_SUCCESS;
+}
+
+/*
+ * Pomoćna funkcija: Stvarno zauzeće scratch bafera od bytes bajtova
+ *
+ * scratchAlloc() zaokružuje velike bafere na huge stranicu, pa je to
+ * zauzeće koje se poredi sa limitom, ne tražena veličina.
+ */
+static size_t budgetFootprint(size_t bytes)
+{
+#if RADIX_HAVE_HUGEPAGES
+	if ((g_config.hugePages != SORT_HUGEPAGES_OFF) && (bytes >= HUGE_PAGE_SIZE))
+	{
+		if (bytes > (SIZE_MAX - HUGE_PAGE_SIZE))
+		{
+			return SIZE_MAX;
+		}
+		return (bytes + HUGE_PAGE_SIZE - 1U) & ~(HUGE_PAGE_SIZE - 1U);
+	}
+#endif
+	return bytes;
+}
+
+/*
+ * Pomoćna funkcija: Prvi index u sortiranom arr[0, size) sa arr[i] >= value
+ * (upperBound: arr[i] > value)
+ */
+static size_t lowerBound(const int32_t* arr, size_t size, int32_t value)
+{
+	const int32_t* base = arr;
+	while (size > 1U)
+	{
+		size_t half = size / 2U;
+		base = (base[half - 1U] < value) ? (base + half) : base;
+		size -= half;
+	}
+	return (size_t)(base - arr) + (((size == 1U) && (*base < value)) ? 1U : 0U);
+}
+
+static size_t upperBound(const int32_t* arr, size_t size, int32_t value)
+{
+	const int32_t* base = arr;
+	while (size > 1U)
+	{
+		size_t half = size / 2U;
+		base = (base[half - 1U] <= value) ? (base + half) : base;
+		size -= half;
+	}
+	return (size_t)(base - arr) + (((size == 1U) && (*base <= value)) ? 1U : 0U);
+}
+
+/*
+ * Pomoćna funkcija: Zamena susednih blokova arr[0, len1) i arr[len1, len1 + len2)
+ *
+ * Kraći blok staje u bafer: kopija + jedan memmove. Inače tri obrtanja
+ * u mestu (svaki element se pomera dva puta).
+ */
+static void rotateBlocks(int32_t* arr, size_t len1, size_t len2, int32_t* buf, size_t bufLen)
+{
+	if ((len1 == 0U) || (len2 == 0U))
+	{
+		return;
+	}
+
+	if ((len1 <= len2) && (len1 <= bufLen))
+	{
+		(void)memcpy(buf, arr, len1 * sizeof(int32_t));
+		(void)memmove(arr, arr + len1, len2 * sizeof(int32_t));
+		(void)memcpy(arr + len2, buf, len1 * sizeof(int32_t));
+		return;
+	}
+
+	if (len2 <= bufLen)
+	{
+		(void)memcpy(buf, arr + len1, len2 * sizeof(int32_t));
+		(void)memmove(arr + len2, arr, len1 * sizeof(int32_t));
+		(void)memcpy(arr, buf, len2 * sizeof(int32_t));
+		return;
+	}
+
+	size_t spans[3][2] = { { 0U, len1 }, { len1, len1 + len2 }, { 0U, len1 + len2 } };
+	for (size_t s = 0; s < 3U; s++)
+	{
+		size_t lo = spans[s][0];
+		size_t hi = spans[s][1];
+		while ((hi - lo) > 1U)
+		{
+			hi--;
+			int32_t tmp = arr[lo];
+			arr[lo] = arr[hi];
+			arr[hi] = tmp;
+			lo++;
+		}
+	}
+}
+
+/*
+ * Pomoćna funkcija: Spajanje arr[0, len1) i arr[len1, len1 + len2) u mestu
+ *
+ * Kada kraći deo staje u bafer, kopira se u bafer i spaja bez grananja
+ * (levi unapred, desni od kraja). Inače se duži deo polovi, njegova
+ * sredina se binarnom pretragom nađe u drugom delu, srednji blokovi
+ * zamene mesta i dva manja spajanja se rade posebno (kao
+ * std::inplace_merge). Sa baferom od 0 elemenata radi potpuno u mestu.
+ */
+static void mergeInPlace(int32_t* arr, size_t len1, size_t len2, int32_t* buf, size_t bufLen)
+{
+	while ((len1 != 0U) && (len2 != 0U))
+	{
+		/* Elementi levo od prvog desnog i desno od poslednjeg levog su već na mestu */
+		size_t skip = upperBound(arr, len1, arr[len1]);
+		arr += skip;
+		len1 -= skip;
+		if (len1 == 0U)
+		{
+			return;
+		}
+		len2 = lowerBound(arr + len1, len2, arr[len1 - 1U]);
+
+		/* Deo od jednog elementa: posle odsecanja ceo drugi deo ide ispred (iza) njega */
+		if ((len1 == 1U) || (len2 == 1U))
+		{
+			rotateBlocks(arr, len1, len2, buf, bufLen);
+			return;
+		}
+
+		if ((len1 <= len2) && (len1 <= bufLen))
+		{
+			(void)memcpy(buf, arr, len1 * sizeof(int32_t));
+			const int32_t* left = buf;
+			const int32_t* leftEnd = buf + len1;
+			const int32_t* right = arr + len1;
+			const int32_t* rightEnd = right + len2;
+			int32_t* out = arr;
+			while ((left < leftEnd) && (right < rightEnd))
+			{
+				bool takeRight = (*right < *left);
+				*out = takeRight ? *right : *left;
+				right += takeRight ? 1 : 0;
+				left += takeRight ? 0 : 1;
+				out++;
+			}
+			/* Ostatak desnog dela je već na mestu */
+			(void)memcpy(out, left, (size_t)(leftEnd - left) * sizeof(int32_t));
+			return;
+		}
+
+		if (len2 <= bufLen)
+		{
+			(void)memcpy(buf, arr + len1, len2 * sizeof(int32_t));
+			int32_t* left = arr + len1;
+			const int32_t* right = buf + len2;
+			int32_t* out = arr + len1 + len2;
+			while ((left > arr) && (right > buf))
+			{
+				bool takeLeft = (right[-1] < left[-1]);
+				out--;
+				*out = takeLeft ? left[-1] : right[-1];
+				left -= takeLeft ? 1 : 0;
+				right -= takeLeft ? 0 : 1;
+			}
+			/* Ostatak levog dela je već na mestu */
+			(void)memcpy(arr, buf, (size_t)(right - buf) * sizeof(int32_t));
+			return;
+		}
+
+		size_t cut1;
+		size_t cut2;
+		if (len1 > len2)
+		{
+			cut1 = len1 / 2U;
+			cut2 = lowerBound(arr + len1, len2, arr[cut1]);
+		}
+		else
+		{
+			cut2 = len2 / 2U;
+			cut1 = upperBound(arr, len1, arr[len1 + cut2]);
+		}
+		rotateBlocks(arr + cut1, len1 - cut1, cut2, buf, bufLen);
+
+		/* Manja polovina rekurzivno, veća u petlji: dubina ostaje O(log n) */
+		size_t headLen = cut1 + cut2;
+		size_t tailLen = (len1 + len2) - headLen;
+		if (headLen <= tailLen)
+		{
+			mergeInPlace(arr, cut1, cut2, buf, bufLen);
+			arr += headLen;
+			len1 -= cut1;
+			len2 -= cut2;
+		}
+		else
+		{
+			mergeInPlace(arr + headLen, len1 - cut1, len2 - cut2, buf, bufLen);
+			len1 = cut1;
+			len2 = cut2;
+		}
+	}
+}
+
+SortResult radixSortBudget(int32_t* arr, size_t n, size_t maxScratchBytes)
+{
+	if (arr == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (n == 0U)
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	/* Ceo scratch staje: obično sortiranje; ako alokacija ipak ne uspe, ide se na delove */
+	if ((n <= (SIZE_MAX / (2U * sizeof(uint32_t)))) &&
+	    (budgetFootprint(n * sizeof(uint32_t)) <= (maxScratchBytes / 2U)))
+	{
+		SortResult result = sortArray(arr, arr, n, NULL);
+		if (result != SORT_ERROR_MEMORY)
+		{
+			return result;
+		}
+	}
+
+	resetStats();
+
+	/* Jedan region u okviru limita; ako bi ga scratchAlloc() zaokružio preko limita, zaokružuje se naniže na huge stranicu */
+	size_t bytes = maxScratchBytes;
+	if ((n <= (SIZE_MAX / (2U * sizeof(uint32_t)))) && (bytes > (2U * n * sizeof(uint32_t))))
+	{
+		bytes = 2U * n * sizeof(uint32_t);
+	}
+
+	ScratchBuffer region = { NULL, 0U, 0U, SORT_PAGES_NONE, false };
+	while (bytes >= BUDGET_MIN_BYTES)
+	{
+		if (budgetFootprint(bytes) > maxScratchBytes)
+		{
+			bytes &= ~(HUGE_PAGE_SIZE - 1U);
+		}
+		bytes &= ~((2U * sizeof(uint32_t)) - 1U);
+		if (scratchAlloc(&region, bytes))
+		{
+			recordScratch(&region);
+			break;
+		}
+		bytes /= 2U;/*nema memorije ni za toliko: manji region, sporije, ali bez greške*/
+	}
+
+	uint32_t* temp = (uint32_t*)region.ptr;
+	size_t bufLen = (temp != NULL) ? (bytes / sizeof(uint32_t)) : 0U;
+
+	/* Delovi do pola regiona (sortiranje u mestu traži dva bafera veličine dela), svi približno jednaki */
+	size_t chunk = bufLen / 2U;
+	if (chunk <= SMALL_SORT_THRESHOLD)
+	{
+		chunk = SMALL_SORT_THRESHOLD;
+	}
+	else
+	{
+		size_t parts = (n / chunk) + (((n % chunk) != 0U) ? 1U : 0U);
+		chunk = (n / parts) + (((n % parts) != 0U) ? 1U : 0U);
+	}
+
+	for (size_t lo = 0; lo < n; lo += chunk)
+	{
+		size_t len = ((n - lo) < chunk) ? (n - lo) : chunk;
+		if (len <= SMALL_SORT_THRESHOLD)
+		{
+			insertionSortI32(arr + lo, len);
+			g_lastStats.strategy = SORT_STRATEGY_INSERTION;
+		}
+		else
+		{
+			sortWithBuffers(arr + lo, arr + lo, len, NULL, temp, temp + len);
+		}
+	}
+
+	size_t levels = 0;
+	for (size_t width = chunk; width < n; width *= 2U)
+	{
+		for (size_t lo = 0; (n - lo) > width; lo += 2U * width)
+		{
+			size_t len2 = ((n - lo - width) < width) ? (n - lo - width) : width;
+			mergeInPlace(arr + lo, width, len2, (int32_t*)temp, bufLen);
+			if ((n - lo) <= (2U * width))
+			{
+				break;
+			}
+		}
+		levels++;
+	}
+
+	if (levels > 0U)
+	{
+		g_lastStats.strategy = SORT_STRATEGY_CHUNKED;
+		g_lastStats.passes = levels;
+	}
+
+	scratchFree(&region);
+	return SORT_SUCCESS;
+}
+
+/*
+ * Pomoćna funkcija: Kvantili iz histograma, bez pomeranja podataka
+ *
+ * Prvi prolaz broji gornjih 16 bita ključa (histogram od 256 KB staje u
+ * L2) i sabira ključeve za srednju vrednost. Za svaki traženi rang
+ * prefiksna suma daje bucket i rang unutar njega. Drugi prolaz broji
+ * donjih 16 bita, ali samo za elemente iz ciljnih bucket-a (do
+ * QUANTILE_GROUP bucket-a po prolazu), pa daje tačnu vrednost. Sa
+ * epsilon > 0, bucket sa najviše epsilon * n elemenata se ne
+ * razrešava: vrednost se interpolira unutar njegovog opsega, greška
+ * ranga je najviše broj elemenata u bucket-u. mean može biti NULL.
+ */
+static SortResult selectQuantiles(const int32_t* data, size_t n, const double* qs, size_t numQs, double epsilon, int32_t* out, double* mean)
+{
+	if ((data == NULL) || (qs == NULL) || (out == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if ((n == 0U) || (n > (size_t)UINT32_MAX))
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	if ((numQs == 0U) || (numQs > (SIZE_MAX / (4U * sizeof(uint32_t)))) || !(epsilon >= 0.0))
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	for (size_t q = 0; q < numQs; q++)
+	{
+		if (!((qs[q] >= 0.0) && (qs[q] <= 1.0)))/*odbija i NaN*/
+		{
+			return SORT_ERROR_ARGUMENT;
+		}
+	}
+
+	resetStats();
+
+	/* Mali niz: kopija + sortiranje je jeftinije od čišćenja i obilaska histograma */
+	if (n <= QUANTILE_COPY_MAX_SIZE)
+	{
+		ScratchBuffer copy;
+		if (!scratchAlloc(&copy, 3U * n * sizeof(int32_t)))
+		{
+			return SORT_ERROR_MEMORY;
+		}
+		recordScratch(&copy);
+
+		int32_t* sorted = (int32_t*)copy.ptr;
+		int64_t total = 0;
+		for (size_t i = 0; i < n; i++)
+		{
+			sorted[i] = data[i];
+			total += data[i];
+		}
+		sortWithScratch(sorted, n, (uint32_t*)(sorted + n));
+		for (size_t q = 0; q < numQs; q++)
+		{
+			out[q] = sorted[(size_t)(qs[q] * (double)(n - 1U))];
+		}
+		if (mean != NULL)
+		{
+			*mean = (double)total / (double)n;
+		}
+
+		g_lastStats.strategy = SORT_STRATEGY_NONE;
+		g_lastStats.passes = 1U;
+		scratchFree(&copy);
+		return SORT_SUCCESS;
+	}
+
+	/* Histogrami, pa (bucket, rang u bucket-u) po kvantilu, pa mapa bucket -> slot */
+	size_t histSlots = (numQs < QUANTILE_GROUP) ? numQs : QUANTILE_GROUP;
+	if (histSlots < QUANTILE_LANES)
+	{
+		histSlots = QUANTILE_LANES;
+	}
+	size_t histBytes = histSlots * QUANTILE_BUCKETS * sizeof(uint32_t);
+	ScratchBuffer scratch;
+	if (!scratchAlloc(&scratch, histBytes + (numQs * 2U * sizeof(uint32_t)) + QUANTILE_BUCKETS))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	recordScratch(&scratch);
+
+	uint32_t* hist = (uint32_t*)scratch.ptr;
+	uint32_t* targets = (uint32_t*)((uint8_t*)scratch.ptr + histBytes);
+	uint8_t* slotOf = (uint8_t*)(targets + (numQs * 2U));
+
+	/*
+	 * Prvi prolaz u QUANTILE_LANES kopija histograma: kada većina ključeva
+	 * pada u isti bucket (uzak opseg), uzastopna povećanja istog brojača
+	 * čekaju jedno na drugo; sa 4 kopije lanac je 4 puta kraći.
+	 */
+	(void)memset(hist, 0, QUANTILE_LANES * QUANTILE_BUCKETS * sizeof(uint32_t));
+	uint64_t sum = 0U;
+	size_t i = 0;
+	for (; (i + QUANTILE_LANES) <= n; i += QUANTILE_LANES)
+	{
+		uint32_t key0 = (uint32_t)data[i] ^ SIGN_BIT;
+		uint32_t key1 = (uint32_t)data[i + 1U] ^ SIGN_BIT;
+		uint32_t key2 = (uint32_t)data[i + 2U] ^ SIGN_BIT;
+		uint32_t key3 = (uint32_t)data[i + 3U] ^ SIGN_BIT;
+		hist[key0 >> QUANTILE_BITS]++;
+		hist[QUANTILE_BUCKETS + (key1 >> QUANTILE_BITS)]++;
+		hist[(2U * QUANTILE_BUCKETS) + (key2 >> QUANTILE_BITS)]++;
+		hist[(3U * QUANTILE_BUCKETS) + (key3 >> QUANTILE_BITS)]++;
+		sum += (uint64_t)key0 + key1 + key2 + key3;
+	}
+	for (; i < n; i++)
+	{
+		uint32_t key = (uint32_t)data[i] ^ SIGN_BIT;
+		hist[key >> QUANTILE_BITS]++;
+		sum += key;
+	}
+
+	uint32_t total = 0U;
+	for (size_t b = 0; b < QUANTILE_BUCKETS; b++)
+	{
+		total += hist[b] + hist[QUANTILE_BUCKETS + b] + hist[(2U * QUANTILE_BUCKETS) + b] + hist[(3U * QUANTILE_BUCKETS) + b];
+		hist[b] = total;
+	}
+
+	/* Rang kvantila q je floor(q * (n - 1)); bucket je prvi sa prefiksnom sumom > rang */
+	for (size_t q = 0; q < numQs; q++)
+	{
+		uint32_t rank = (uint32_t)(qs[q] * (double)(n - 1U));
+		size_t lo = 0U;
+		size_t hi = QUANTILE_BUCKETS - 1U;
+		while (lo < hi)
+		{
+			size_t mid = lo + ((hi - lo) / 2U);
+			if (hist[mid] > rank)
+			{
+				hi = mid;
+			}
+			else
+			{
+				lo = mid + 1U;
+			}
+		}
+		uint32_t below = (lo == 0U) ? 0U : hist[lo - 1U];
+		uint32_t inBucket = hist[lo] - below;
+		rank -= below;
+
+		if ((epsilon > 0.0) && ((double)inBucket <= (epsilon * (double)n)))
+		{
+			uint32_t low = (uint32_t)(((uint64_t)rank << QUANTILE_BITS) / inBucket);
+			out[q] = (int32_t)((((uint32_t)lo << QUANTILE_BITS) | low) ^ SIGN_BIT);
+			targets[2U * q] = QUANTILE_DONE;
+		}
+		else
+		{
+			targets[2U * q] = (uint32_t)lo;
+			targets[(2U * q) + 1U] = rank;
+		}
+	}
+
+	size_t passes = 1U;
+	(void)memset(slotOf, QUANTILE_NO_SLOT, QUANTILE_BUCKETS);
+	for (;;)
+	{
+		uint32_t slotBucket[QUANTILE_GROUP];
+		size_t slots = 0U;
+		for (size_t q = 0; (q < numQs) && (slots < QUANTILE_GROUP); q++)
+		{
+			uint32_t bucket = targets[2U * q];
+			if ((bucket != QUANTILE_DONE) && (slotOf[bucket] == QUANTILE_NO_SLOT))
+			{
+				slotOf[bucket] = (uint8_t)slots;
+				slotBucket[slots] = bucket;
+				slots++;
+			}
+		}
+		if (slots == 0U)
+		{
+			break;
+		}
+
+		/* Drugi prolaz: donjih 16 bita, samo za elemente ciljnih bucket-a */
+		(void)memset(hist, 0, slots * QUANTILE_BUCKETS * sizeof(uint32_t));
+		for (i = 0; i < n; i++)
+		{
+			uint32_t key = (uint32_t)data[i] ^ SIGN_BIT;
+			size_t slot = slotOf[key >> QUANTILE_BITS];
+			if (slot != QUANTILE_NO_SLOT)
+			{
+				hist[(slot << QUANTILE_BITS) + (key & (QUANTILE_BUCKETS - 1U))]++;
+			}
+		}
+		passes++;
+
+		for (size_t q = 0; q < numQs; q++)
+		{
+			uint32_t bucket = targets[2U * q];
+			if ((bucket == QUANTILE_DONE) || (slotOf[bucket] == QUANTILE_NO_SLOT))
+			{
+				continue;
+			}
+
+			const uint32_t* counts = hist + ((size_t)slotOf[bucket] << QUANTILE_BITS);
+			uint32_t rank = targets[(2U * q) + 1U];
+			uint32_t seen = 0U;
+			size_t low = 0U;
+			while ((seen + counts[low]) <= rank)
+			{
+				seen += counts[low];
+				low++;
+			}
+			out[q] = (int32_t)(((bucket << QUANTILE_BITS) | (uint32_t)low) ^ SIGN_BIT);
+			targets[2U * q] = QUANTILE_DONE;
+		}
+
+		for (size_t s = 0; s < slots; s++)
+		{
+			slotOf[slotBucket[s]] = QUANTILE_NO_SLOT;
+		}
+	}
+
+	if (mean != NULL)
+	{
+		*mean = ((double)sum / (double)n) - (double)SIGN_BIT;
+	}
+
+	g_lastStats.strategy = SORT_STRATEGY_NONE;
+	g_lastStats.passes = passes;
+	scratchFree(&scratch);
+	return SORT_SUCCESS;
+}
+
+SortResult radixQuantiles(const int32_t* data, size_t n, const double* qs, size_t numQs, int32_t* out)
+{
+	return selectQuantiles(data, n, qs, numQs, 0.0, out, NULL);
+}
+
+SortResult radixQuantilesApprox(const int32_t* data, size_t n, const double* qs, size_t numQs, double epsilon, int32_t* out)
+{
+	return selectQuantiles(data, n, qs, numQs, epsilon, out, NULL);
+}
+
+SortResult radixSummarize(const int32_t* data, size_t n, DistributionSummary* summary)
+{
+	if (summary == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	static const double qs[8] = { 0.0, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0 };
+	int32_t values[8];
+	double mean = 0.0;
+	SortResult result = selectQuantiles(data, n, qs, 8U, 0.0, values, &mean);
+	if (result != SORT_SUCCESS)
+	{
+		return result;
+	}
+
+	summary->count = n;
+	summary->min = values[0];
+	summary->p25 = values[1];
+	summary->median = values[2];
+	summary->p75 = values[3];
+	summary->p90 = values[4];
+	summary->p99 = values[5];
+	summary->p999 = values[6];
+	summary->max = values[7];
+	summary->mean = mean;
+	return SORT_SUCCESS;
+}
+
+/*
+ * Pomoćna funkcija: Keš reč stringa od pozicije depth (depth <= length)
+ *
+ * Bajtovi posle kraja stringa su 0, a broj preostalih znakova u najnižem
+ * bajtu razlikuje "a" od "a\0". Sa bar 8 preostalih bajtova reč se čita
+ * jednim neporavnatim čitanjem.
+ */
+static uint64_t stringCache(const StringEntry* entry, size_t depth)
+{
+	size_t remaining = (size_t)entry->length - depth;
+	const uint8_t* text = entry->text + depth;
+	uint64_t word = 0U;
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	if (remaining > STRING_CACHE_CHARS)
+	{
+		memcpy(&word, text, sizeof(word));
+		return (__builtin_bswap64(word) & ~(uint64_t)0xFFU) | STRING_CACHE_CHARS;
+	}
+#endif
+
+	size_t take = (remaining < STRING_CACHE_CHARS) ? remaining : STRING_CACHE_CHARS;
+	for (size_t k = 0; k < take; k++)
+	{
+		word |= (uint64_t)text[k] << (56U - (8U * k));
+	}
+	return word | (uint64_t)take;
+}
+
+/*
+ * Pomoćna funkcija: Punjenje keš reči grupe od pozicije depth
+ *
+ * Jedino mesto gde se čita tekst: tekstovi su razbacani po memoriji, pa
+ * se čitanje najavljuje GATHER_PREFETCH_DISTANCE stringova unapred.
+ * Vraća OR razlika svih keš reči od prve: bajtovi koji su tu 0 isti su
+ * za celu grupu.
+ */
+static uint64_t loadStringCaches(StringEntry* entries, size_t n, size_t depth)
+{
+	uint64_t differ = 0U;
+	for (size_t i = 0; i < n; i++)
+	{
+		if ((i + GATHER_PREFETCH_DISTANCE) < n)
+		{
+			RADIX_PREFETCH(entries[i + GATHER_PREFETCH_DISTANCE].text + depth);
+		}
+		entries[i].cache = stringCache(&entries[i], depth);
+		differ |= entries[i].cache ^ entries[0].cache;
+	}
+	return differ;
+}
+
+/*
+ * Pomoćna funkcija: Insertion sort najmanjih grupa po keš reči
+ *
+ * Stabilan, a ulaz je po index-u (posle stabilnih raspodela) ili se
+ * jednaki porede po index-u, pa jednaki stringovi ostaju po redu.
+ */
+static void insertionSortStrings(StringEntry* entries, size_t n)
+{
+	for (size_t i = 1; i < n; i++)
+	{
+		StringEntry key = entries[i];
+		size_t j = i;
+		while ((j > 0U) && ((key.cache < entries[j - 1U].cache) ||
+		                    ((key.cache == entries[j - 1U].cache) && (key.index < entries[j - 1U].index))))
+		{
+			entries[j] = entries[j - 1U];
+			j--;
+		}
+		entries[j] = key;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Multikey quicksort (Bentley-Sedgewick) od pozicije depth
+ *
+ * Simbol nije jedan znak nego cela keš reč (7 znakova + broj preostalih),
+ * pa se tekst čita jednom na 7 znakova kao i u MSD delu. Podela na tri
+ * dela po keš reči (pivot je medijana tri); manji i veći deo se sortiraju
+ * od iste pozicije, a jednaki od depth + 7, u petlji. Jednaki sa manje
+ * od 7 preostalih su isti stringovi. Podela nije stabilna, ali jednaki
+ * stringovi uvek završe u istoj grupi, a tamo se porede po index-u.
+ * loaded: keš reči grupe su već napunjene od depth.
+ */
+static void multikeyQuicksort(StringEntry* entries, size_t n, size_t depth, bool loaded)
+{
+	if (!loaded)
+	{
+		(void)loadStringCaches(entries, n, depth);
+	}
+
+	for (;;)
+	{
+		while (n > STRING_INSERTION_THRESHOLD)
+		{
+			uint64_t a = entries[0].cache;
+			uint64_t b = entries[n / 2U].cache;
+			uint64_t c = entries[n - 1U].cache;
+			uint64_t pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a)) : ((a < c) ? a : ((b < c) ? c : b));
+
+			size_t lt = 0;
+			size_t i = 0;
+			size_t gt = n;
+			while (i < gt)
+			{
+				uint64_t cache = entries[i].cache;
+				if (cache < pivot)
+				{
+					StringEntry tmp = entries[lt];
+					entries[lt] = entries[i];
+					entries[i] = tmp;
+					lt++;
+					i++;
+				}
+				else if (cache > pivot)
+				{
+					gt--;
+					StringEntry tmp = entries[gt];
+					entries[gt] = entries[i];
+					entries[i] = tmp;
+				}
+				else
+				{
+					i++;
+				}
+			}
+
+			multikeyQuicksort(entries, lt, depth, true);
+			multikeyQuicksort(entries + gt, n - gt, depth, true);
+
+			entries += lt;
+			n = gt - lt;
+			if ((pivot & 0xFFU) < STRING_CACHE_CHARS)
+			{
+				insertionSortStrings(entries, n);/*isti stringovi, samo po index-u*/
+				return;
+			}
+			depth += STRING_CACHE_CHARS;
+			(void)loadStringCaches(entries, n, depth);
+		}
+
+		insertionSortStrings(entries, n);
+
+		/* Grupe iste keš reči sa 7 preostalih se razlikuju tek posle depth + 7 */
+		if ((n > 1U) && (entries[0].cache == entries[n - 1U].cache))
+		{
+			if ((entries[0].cache & 0xFFU) < STRING_CACHE_CHARS)
+			{
+				return;
+			}
+			depth += STRING_CACHE_CHARS;
+			(void)loadStringCaches(entries, n, depth);
+			continue;/*cela grupa je jedan niz jednakih: petlja, ne rekurzija*/
+		}
+
+		size_t run = 0;
+		for (size_t i = 1; i <= n; i++)
+		{
+			if ((i == n) || (entries[i].cache != entries[run].cache))
+			{
+				if (((i - run) > 1U) && ((entries[run].cache & 0xFFU) == STRING_CACHE_CHARS))
+				{
+					multikeyQuicksort(entries + run, i - run, depth + STRING_CACHE_CHARS, false);
+				}
+				run = i;
+			}
+		}
+		return;
+	}
+}
+
+/*
+ * Pomoćna funkcija: MSD po bajtovima keš reči
+ *
+ * Grupa ima zajednički prefiks [0, depth) i iste bajtove keš reči pre
+ * byteIndex. Bajtovi 0-6 su znakovi, bajt 7 broj preostalih. Kada grupa
+ * potroši sve bajtove, a ima bar 7 preostalih znakova, keš se puni od
+ * depth + 7; inače su stringovi jednaki i već su po index-u (raspodele
+ * su stabilne). Bajt isti za celu grupu se preskače bez pomeranja
+ * (posle punjenja keša svi takvi odjednom).
+ * Rekurzija ide samo u manje bucket-e, najveći se nastavlja u petlji,
+ * pa je dubina O(log n).
+ */
+static void msdSortStrings(StringEntry* entries, StringEntry* temp, size_t n, size_t depth, size_t byteIndex, size_t* refills)
+{
+	while (n > 1U)
+	{
+		if (byteIndex > STRING_CACHE_CHARS)
+		{
+			if ((entries[0].cache & 0xFFU) < STRING_CACHE_CHARS)
+			{
+				return;
+			}
+			depth += STRING_CACHE_CHARS;
+			byteIndex = 0U;
+		}
+
+		if (n < STRING_SMALL_THRESHOLD)
+		{
+			multikeyQuicksort(entries, n, depth, byteIndex > 0U);
+			return;
+		}
+
+		if (byteIndex == 0U)
+		{
+			/* Zajednički bajtovi odmah otpadaju, bez histograma po bajtu */
+			uint64_t differ = loadStringCaches(entries, n, depth);
+			(*refills)++;
+			while ((byteIndex <= STRING_CACHE_CHARS) && (((differ >> (8U * (STRING_CACHE_CHARS - byteIndex))) & 0xFFU) == 0U))
+			{
+				byteIndex++;
+			}
+			if (byteIndex > STRING_CACHE_CHARS)
+			{
+				continue;
+			}
+		}
+
+		size_t shift = 8U * (STRING_CACHE_CHARS - byteIndex);
+		size_t count[RADIX_SIZE] = { 0U };
+		for (size_t i = 0; i < n; i++)
+		{
+			count[(entries[i].cache >> shift) & 0xFFU]++;
+		}
+
+		if (count[(entries[0].cache >> shift) & 0xFFU] == n)
+		{
+			byteIndex++;
+			continue;
+		}
+
+		size_t offsets[RADIX_SIZE];
+		size_t sum = 0;
+		size_t largest = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			offsets[d] = sum;
+			sum += count[d];
+			if (count[d] > count[largest])
+			{
+				largest = d;
+			}
+		}
+
+		for (size_t i = 0; i < n; i++)
+		{
+			temp[offsets[(entries[i].cache >> shift) & 0xFFU]++] = entries[i];
+		}
+		memcpy(entries, temp, n * sizeof(StringEntry));
+
+		size_t start = 0;
+		size_t largestStart = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			if (d == largest)
+			{
+				largestStart = start;
+			}
+			else if (count[d] > 1U)
+			{
+				msdSortStrings(entries + start, temp, count[d], depth, byteIndex + 1U, refills);
+			}
+			start += count[d];
+		}
+
+		entries += largestStart;
+		n = count[largest];
+		byteIndex++;
+	}
+}
+
+/*
+ * Pomoćna funkcija: Sortiranje pripremljenih stringova + statistika
+ */
+static void sortStringEntries(StringEntry* entries, StringEntry* temp, size_t n)
+{
+	size_t refills = 0;
+	msdSortStrings(entries, temp, n, 0U, 0U, &refills);
+	g_lastStats.strategy = SORT_STRATEGY_STRING_MSD;
+	g_lastStats.passes = refills;
+}
+
+SortResult radixSortStrings(RadixString* strings, size_t n)
+{
+	if (strings == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if ((n == 0U) || (n > (size_t)UINT32_MAX) || (n > (SIZE_MAX / (2U * sizeof(StringEntry)))))
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		if ((strings[i].text == NULL) && (strings[i].length != 0U))
+		{
+			return SORT_ERROR_NULL;
+		}
+		if (strings[i].length > (size_t)UINT32_MAX)
+		{
+			return SORT_ERROR_SIZE;
+		}
+	}
+
+	resetStats();
+
+	if (n == 1U)
+	{
+		g_lastStats.strategy = SORT_STRATEGY_NONE;
+		return SORT_SUCCESS;
+	}
+
+	ScratchBuffer scratch;
+	if (!scratchAlloc(&scratch, 2U * n * sizeof(StringEntry)))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	recordScratch(&scratch);
+
+	StringEntry* entries = (StringEntry*)scratch.ptr;
+	for (size_t i = 0; i < n; i++)
+	{
+		entries[i].cache = 0U;
+		entries[i].text = (const uint8_t*)strings[i].text;
+		entries[i].length = (uint32_t)strings[i].length;
+		entries[i].index = (uint32_t)i;
+	}
+
+	sortStringEntries(entries, entries + n, n);
+
+	/* Opis se ponovo sastavlja iz pokazivača i dužine, bez gather-a po index-u */
+	for (size_t i = 0; i < n; i++)
+	{
+		strings[i].text = (const char*)entries[i].text;
+		strings[i].length = entries[i].length;
+	}
+
+	scratchFree(&scratch);
+	return SORT_SUCCESS;
+}
+
+SortResult radixSortStringOffsets(const char* blob, const size_t* offsets, size_t n, uint32_t* perm)
+{
+	if ((blob == NULL) || (offsets == NULL) || (perm == NULL))
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if ((n == 0U) || (n > (size_t)UINT32_MAX) || (n > (SIZE_MAX / (2U * sizeof(StringEntry)))))
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		if (offsets[i + 1U] < offsets[i])
+		{
+			return SORT_ERROR_ARGUMENT;
+		}
+		if ((offsets[i + 1U] - offsets[i]) > (size_t)UINT32_MAX)
+		{
+			return SORT_ERROR_SIZE;
+		}
+	}
+
+	resetStats();
+
+	if (n == 1U)
+	{
+		perm[0] = 0U;
+		g_lastStats.strategy = SORT_STRATEGY_NONE;
+		return SORT_SUCCESS;
+	}
+
+	ScratchBuffer scratch;
+	if (!scratchAlloc(&scratch, 2U * n * sizeof(StringEntry)))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+	recordScratch(&scratch);
+
+	StringEntry* entries = (StringEntry*)scratch.ptr;
+	for (size_t i = 0; i < n; i++)
+	{
+		entries[i].cache = 0U;
+		entries[i].text = (const uint8_t*)blob + offsets[i];
+		entries[i].length = (uint32_t)(offsets[i + 1U] - offsets[i]);
+		entries[i].index = (uint32_t)i;
+	}
 
-#define RADIX_BITS 8
-#define RADIX_SIZE 256/* 2^8 CPU je građen oko 8-bitnih blokova*/
-#define NUM_PASSES 4 /*int32_t je 4 bajta pa 4 prolaza, svaki prolaz sortira jedan bajt*/
+	sortStringEntries(entries, entries + n, n);
 
-static void countingSortByByte(uint32_t* arr, size_t size, uint32_t* output, size_t byteIndex);
+	for (size_t i = 0; i < n; i++)
+	{
+		perm[i] = entries[i].index;
+	}
+
+	scratchFree(&scratch);
+	return SORT_SUCCESS;
+}
 
 /*
- * Pomoćna funkcija: Counting Sort po određenom bajtu
- * 
- * Sortira niz po zadatom bajtu (0 = najmanji, 3 = najveći za int32_t)
- * koristeći stabilan Counting Sort.
+ * Pomoćna funkcija: Do 8 bajtova ključa kao big-endian broj (dopunjen nulama)
  */
-static void countingSortByByte(uint32_t* arr, size_t size, uint32_t* output, size_t byteIndex)/*MISRA: Rule 8.10/8.11 ispostovano sa static internal linkage*/
+static uint64_t keyWord(const uint8_t* key, size_t rest)
 {
-	assert(arr != NULL);
-	assert(output != NULL);
-	assert(byteIndex < NUM_PASSES);
+	uint64_t word = 0U;
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+	if (rest >= sizeof(word))
+	{
+		(void)memcpy(&word, key, sizeof(word));
+		return __builtin_bswap64(word);
+	}
+#endif
+	size_t take = (rest < sizeof(word)) ? rest : sizeof(word);
+	for (size_t k = 0; k < take; k++)
+	{
+		word |= (uint64_t)key[k] << (56U - (8U * k));
+	}
+	return word;
+}
 
-	size_t count[RADIX_SIZE] = {0};
-	size_t shift = byteIndex * RADIX_BITS;
+/*
+ * Pomoćna funkcija: Da li je ključ a veći od b (poslednjih rest bajtova)
+ */
+static bool keyGreater(const uint8_t* a, const uint8_t* b, size_t rest)
+{
+	for (size_t k = 0; k < rest; k += sizeof(uint64_t))
+	{
+		uint64_t wa = keyWord(a + k, rest - k);
+		uint64_t wb = keyWord(b + k, rest - k);
+		if (wa != wb)
+		{
+			return wa > wb;
+		}
+	}
+	return false;
+}
 
-	/* Prebroj pojavljivanja svakog bajta */
-	for (size_t i = 0; i < size; i++)
+/*
+ * Pomoćna funkcija: Insertion sort male grupe ključeva (n <= SMALL_SORT_THRESHOLD)
+ *
+ * Bajtovi pre depth su isti za celu grupu. Prvih 8 ostalih bajtova svakog
+ * ključa se pročita jednom, pa insertion sort pomera parove (reč, index)
+ * u registrima/steku; ostatak ključa se poredi samo kada su reči iste.
+ * Ključevi se zatim premeste jednom, kroz temp.
+ */
+static void insertionSortKeys(uint8_t* keys, uint8_t* temp, size_t n, size_t keyBytes, size_t depth)
+{
+	assert(n <= SMALL_SORT_THRESHOLD);
+
+	uint64_t words[SMALL_SORT_THRESHOLD];
+	uint8_t order[SMALL_SORT_THRESHOLD];
+	size_t rest = keyBytes - depth;
+	bool sorted = true;
+	for (size_t i = 0; i < n; i++)
+	{
+		words[i] = keyWord(keys + (i * keyBytes) + depth, rest);
+		order[i] = (uint8_t)i;
+		sorted = sorted && ((i == 0U) || (words[i - 1U] < words[i]));
+	}
+	if (sorted)
 	{
-		uint32_t digit = (arr[i] >> shift) & 0xFF;/*AND sa 0xFF uvek daje vrednost u opsegu [0, 255]*/
-		count[digit]++;
+		return;
 	}
 
-	/* Kumulativna suma - pozicije u output nizu */
-	for (size_t i = 1; i < RADIX_SIZE; i++)
+	for (size_t i = 1; i < n; i++)
 	{
-		count[i] += count[i - 1];
+		uint64_t word = words[i];
+		uint8_t index = order[i];
+		size_t j = i;
+		while ((j > 0U) &&
+		       ((words[j - 1U] > word) ||
+		        ((words[j - 1U] == word) && (rest > sizeof(uint64_t)) &&
+		         keyGreater(keys + ((size_t)order[j - 1U] * keyBytes) + depth + sizeof(uint64_t),
+		                    keys + ((size_t)index * keyBytes) + depth + sizeof(uint64_t), rest - sizeof(uint64_t)))))
+		{
+			words[j] = words[j - 1U];
+			order[j] = order[j - 1U];
+			j--;
+		}
+		words[j] = word;
+		order[j] = index;
 	}
 
-	/* Postavi elemente u output niz (unazad za stabilnost) */
-	for (size_t i = size; i > 0; i--) /*wrap-around: 0 - 1 = SIZE_MAX → velika vrednost, beskonačna petlja.*/
+	for (size_t i = 0; i < n; i++)
 	{
-		size_t idx = i - 1;/*Time izbegavamo wrap-around i pristupujemo poslednjem elementu arr[size-1]*/
-		uint32_t digit = (arr[idx] >> shift) & 0xFF;/*AND sa 0xFF uvek daje vrednost u opsegu [0, 255]*/
-		count[digit]--;
-		output[count[digit]] = arr[idx];
+		moveRecord(temp + (i * keyBytes), keys + ((size_t)order[i] * keyBytes), keyBytes);
 	}
+	(void)memcpy(keys, temp, n * keyBytes);
 }
 
 /*
- * Radix Sort LSD implementacija
+ * Pomoćna funkcija: LSD prolazi po bajtovima koji se menjaju
  *
- * Koraci:
- * 1. Transformiše int32_t u uint32_t (XOR sa 0x80000000)
- *    - Ovo mapira negativne brojeve u manji opseg od pozitivnih
- * 2. Sortira bajt po bajt (4 prolaza)
- * 3. Transformiše nazad u int32_t
+ * active su indeksi tih bajtova u rastućem redosledu, count histogrami
+ * iz jednog čitanja (ne zavise od redosleda, pa važe za svaki prolaz).
+ * Ključevi se pomeraju celi; posle neparnog broja prolaza rezultat se
+ * kopira nazad.
  */
-SortResult radixSort(int32_t* arr, size_t size)
+static void lsdSortKeysN(uint8_t* keys, uint8_t* temp, size_t n, size_t keyBytes, size_t (*count)[RADIX_SIZE], const size_t* active, size_t numActive)
 {
-	if (arr == NULL)
+	uint8_t* src = keys;
+	uint8_t* dst = temp;
+	for (size_t p = numActive; p > 0U; p--)
 	{
-		return SORT_ERROR_NULL;
+		size_t b = active[p - 1U];
+		size_t offsets[RADIX_SIZE];
+		size_t sum = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			offsets[d] = sum;
+			sum += count[b][d];
+		}
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const uint8_t* key = src + (i * keyBytes);
+			moveRecord(dst + (offsets[key[b]]++ * keyBytes), key, keyBytes);
+		}
+
+		uint8_t* swap = src;
+		src = dst;
+		dst = swap;
 	}
 
-	if (size == 0)
+	if (src != keys)
 	{
-		return SORT_ERROR_SIZE;
+		(void)memcpy(keys, src, n * keyBytes);
 	}
+}
 
-	if (size == 1)
+/*
+ * Pomoćna funkcija: MSD po bajtovima ključa od bajta depth
+ *
+ * Grupa ima iste bajtove pre depth. Bajt isti za celu grupu se preskače
+ * bez pomeranja. Rasipanje ide u temp i sekvencijalno nazad; rekurzija
+ * ide samo u manje bucket-e, najveći se nastavlja u petlji, pa je dubina
+ * O(log n). Grupe do SMALL_SORT_THRESHOLD završava insertion sort.
+ * maxLevel je najveći broj rasipanja na putu do neke grupe.
+ */
+static void msdSortKeysN(uint8_t* keys, uint8_t* temp, size_t n, size_t keyBytes, size_t depth, size_t level, size_t* maxLevel)
+{
+	while ((n > 1U) && (depth < keyBytes))
 	{
-		return SORT_SUCCESS;
-	}
+		if (n <= SMALL_SORT_THRESHOLD)
+		{
+			insertionSortKeys(keys, temp, n, keyBytes, depth);
+			return;
+		}
 
-	/*
-	* DVE MALLOC() ALOKACIJE:
-	* 
-	* Ovo nije propust!
-	* 
-	* 1. Eksplicitno pokazuje Radix Sort swapping koncept
-	*    - Dva odvojena bafera jasno prikazuju naizmenično korišćenje
-	*    - Swap operacija je transparentna i lako se prati
-	* 
-	* 2. Povećava bezbednost protiv memory grešaka  
-	*    - Odvojeni memory regioni sprečavaju slučajni buffer overflow
-	*    - Jasne granice između input/output bafera
-	* 
-	* 3.
-	*    - Kod ostaje čitljiv i razumljiv bez "magičnih" optimizacija
-	*    - Fokus na algoritam, ne na sistemske detalje
-	* 
-	* 4. Ima zanemarljiv performance impact na O(n) algoritmu
-	*    - Dodatni malloc() poziv ≈0.1ms u odnosu na ~100ms sortiranja
-	*    - Asimptotska složenost O(n) ostaje nepromenjena
-	* 
-	* 5. Olakšava buduće modifikacije i proširenja
-	*    - Jednostavna promena na druge tipove podataka
-	*    - Debug-friendly separacija bafera
-	* 
-	* 
-	*/
+		size_t count[RADIX_SIZE] = { 0U };
+		for (size_t i = 0; i < n; i++)
+		{
+			count[keys[(i * keyBytes) + depth]]++;
+		}
+
+		if (count[keys[depth]] == n)
+		{
+			depth++;
+			continue;
+		}
 
-	uint32_t* temp1 = (uint32_t*)malloc(size * sizeof(uint32_t));
-	if (temp1 == NULL)
+		size_t offsets[RADIX_SIZE];
+		size_t sum = 0;
+		size_t largest = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			offsets[d] = sum;
+			sum += count[d];
+			if (count[d] > count[largest])
+			{
+				largest = d;
+			}
+		}
+
+		for (size_t i = 0; i < n; i++)
+		{
+			const uint8_t* key = keys + (i * keyBytes);
+			moveRecord(temp + (offsets[key[depth]]++ * keyBytes), key, keyBytes);
+		}
+		(void)memcpy(keys, temp, n * keyBytes);
+
+		level++;
+		if (level > *maxLevel)
+		{
+			*maxLevel = level;
+		}
+
+		size_t start = 0;
+		size_t largestStart = 0;
+		for (size_t d = 0; d < RADIX_SIZE; d++)
+		{
+			if (d == largest)
+			{
+				largestStart = start;
+			}
+			else if (count[d] > 1U)
+			{
+				msdSortKeysN(keys + (start * keyBytes), temp, count[d], keyBytes, depth + 1U, level, maxLevel);
+			}
+			start += count[d];
+		}
+
+		keys += largestStart * keyBytes;
+		n = count[largest];
+		depth++;
+	}
+}
+
+SortResult radixSortKeysN(void* keys, size_t keyBytes, size_t n)
+{
+	if (keys == NULL)
 	{
-		return SORT_ERROR_MEMORY;
+		return SORT_ERROR_NULL;
 	}
 
+	if (n == 0U)
+	{
+		return SORT_ERROR_SIZE;
+	}
 
-	/*MISRA-C:2004 Rule 20.4, prekrseno*/
-	uint32_t* temp2 = (uint32_t*)malloc(size * sizeof(uint32_t));
-	if (temp2 == NULL)
+	if (keyBytes == 0U)
 	{
-		free(temp1);
-		return SORT_ERROR_MEMORY;
+		return SORT_ERROR_ARGUMENT;
 	}
 
-	/* Transformacija: int32_t -> uint32_t */
-	/* XOR sa 0x80000000 flip-uje sign bit, tako da negativni postaju manji */
-	/*Casting uint32_t u = (uint32_t)i; samo interpretira iste bitove kao unsigned.
-	Problem: negativni brojevi i dalje imaju najviši bit 1 → sortiranje po bajtu bi stavilo negativne brojeve na kraj.*/
-	for (size_t i = 0; i < size; i++)
+	if (n > ((SIZE_MAX - (KEYS_HISTOGRAM_MAX_BYTES * RADIX_SIZE * sizeof(size_t))) / keyBytes))
 	{
-		/*MISRA Rule 12.7 ispostovano*/
-		temp1[i] = (uint32_t)arr[i] ^ 0x80000000U;/*MISRA Rule 10.6 ispostovano, sa U izbegavam implicitnu konverziju*/
+		return SORT_ERROR_SIZE;
 	}
 
-	/* 4 prolaza - sortiranje po svakom bajtu */
-	uint32_t* input = temp1;
-	uint32_t* output = temp2;
+	resetStats();
 
-	for (size_t pass = 0; pass < NUM_PASSES; pass++)
+	if (n == 1U)
 	{
-		countingSortByByte(input, size, output, pass);
+		g_lastStats.strategy = SORT_STRATEGY_NONE;
+		return SORT_SUCCESS;
+	}
 
-		/* Zameni input i output za sledeći prolaz */
-		uint32_t* swap = input;
-		input = output;
-		output = swap;
+	/* Histogrami, pa ključevi (temp) */
+	size_t histBytes = (keyBytes <= KEYS_HISTOGRAM_MAX_BYTES) ? (keyBytes * RADIX_SIZE * sizeof(size_t)) : 0U;
+	ScratchBuffer scratch;
+	if (!scratchAlloc(&scratch, histBytes + (n * keyBytes)))
+	{
+		return SORT_ERROR_MEMORY;
 	}
+	recordScratch(&scratch);
 
-	/* Nakon 4 prolaza, sortirani podaci su u input */
-	/* Transformacija nazad: uint32_t -> int32_t */
-	for (size_t i = 0; i < size; i++)
+	uint8_t* data = (uint8_t*)keys;
+	uint8_t* temp = (uint8_t*)scratch.ptr + histBytes;
+	size_t depth = 0;
+
+	if (histBytes > 0U)
 	{
-		arr[i] = (int32_t)(input[i] ^ 0x80000000U);
-		/*0x80000000 = 2^31 = -2147483648 u signed int
-		// XOR sa 0x80000000 efektivno:
-		// - Obrće sign bit (MSB)
-		// - Negativni → pozitivni (ali u manjem opsegu)
-		// - Pozitivni → negativni (ali u većem opsegu)
-		// - Nula → postaje -2147483648*/
+		size_t (*count)[RADIX_SIZE] = (size_t (*)[RADIX_SIZE])scratch.ptr;
+		(void)memset(count, 0, histBytes);
+		for (size_t i = 0; i < n; i++)
+		{
+			const uint8_t* key = data + (i * keyBytes);
+			for (size_t b = 0; b < keyBytes; b++)
+			{
+				count[b][key[b]]++;
+			}
+		}
+
+		size_t active[KEYS_HISTOGRAM_MAX_BYTES];
+		size_t numActive = 0;
+		for (size_t b = 0; b < keyBytes; b++)
+		{
+			if (count[b][data[b]] != n)
+			{
+				active[numActive++] = b;
+			}
+		}
+
+		if (numActive == 0U)
+		{
+			g_lastStats.strategy = SORT_STRATEGY_NONE;
+			scratchFree(&scratch);
+			return SORT_SUCCESS;
+		}
+
+		bool cached = ((2U * n * keyBytes) <= privateCacheBytes());
+		if ((numActive <= KEYS_LSD_MAX_PASSES) || (cached && (numActive <= KEYS_LSD_CACHED_PASSES)))
+		{
+			lsdSortKeysN(data, temp, n, keyBytes, count, active, numActive);
+			g_lastStats.strategy = SORT_STRATEGY_LSD;
+			g_lastStats.passes = numActive;
+			scratchFree(&scratch);
+			return SORT_SUCCESS;
+		}
+		depth = active[0];/*vodeći konstantni bajtovi su već poznati*/
 	}
 
-	free(temp1);
-	free(temp2);
+	size_t maxLevel = 0;
+	msdSortKeysN(data, temp, n, keyBytes, depth, 0U, &maxLevel);
+	g_lastStats.strategy = SORT_STRATEGY_KEYS_MSD;
+	g_lastStats.passes = maxLevel;
 
+	scratchFree(&scratch);
 	return SORT_SUCCESS;
 }
 
@@ -195,11 +6097,414 @@ const char* getSortResultString(SortResult result)
 			return "Greška: Veličina niza je 0";
 		case SORT_ERROR_MEMORY:
 			return "Greška: Neuspela alokacija memorije";
+		case SORT_ERROR_ARGUMENT:
+			return "Greška: Neispravan argument";
 		default:
 			return "Nepoznata greška";
 	}
 }
 
+const char* getPageKindString(SortPageKind pages)
+{
+	switch (pages)
+	{
+		case SORT_PAGES_NONE:
+			return "bez scratch bafera";
+		case SORT_PAGES_NORMAL:
+			return "obične 4 KB stranice";
+		case SORT_PAGES_TRANSPARENT:
+			return "transparentne huge stranice (THP)";
+		case SORT_PAGES_HUGETLB:
+			return "eksplicitne huge stranice (hugetlbfs)";
+		default:
+			return "nepoznato";
+	}
+}
+
+const char* getStrategyString(SortStrategy strategy)
+{
+	switch (strategy)
+	{
+		case SORT_STRATEGY_NONE:
+			return "bez pomeranja";
+		case SORT_STRATEGY_INSERTION:
+			return "insertion sort";
+		case SORT_STRATEGY_LSD:
+			return "LSD radix";
+		case SORT_STRATEGY_COUNTING:
+			return "counting sort";
+		case SORT_STRATEGY_PARALLEL:
+			return "višenitni MSD + LSD";
+		case SORT_STRATEGY_BATCH:
+			return "batch";
+		case SORT_STRATEGY_LOW_CARDINALITY:
+			return "hash brojanje (malo različitih)";
+		case SORT_STRATEGY_CACHE_BLOCKED:
+			return "MSD + LSD po bucket-u (keš)";
+		case SORT_STRATEGY_MERGE_RUNS:
+			return "spajanje sortiranih delova";
+		case SORT_STRATEGY_CHUNKED:
+			return "delovi u limitu + spajanje u mestu";
+		case SORT_STRATEGY_STRING_MSD:
+			return "MSD po bajtovima stringa";
+		case SORT_STRATEGY_KEYS_MSD:
+			return "MSD po bajtovima širokog ključa";
+		default:
+			return "nepoznato";
+	}
+}
+
+void radixSortGetConfig(SortConfig* config)
+{
+	if (config != NULL)
+	{
+		*config = g_config;
+	}
+}
+
+SortResult radixSortSetConfig(const SortConfig* config)
+{
+	if (config == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	g_config = *config;
+	return SORT_SUCCESS;
+}
+
+/*
+ * Pomoćna funkcija: Aktivan profil mašine
+ *
+ * Prvi poziv (iz bilo kog thread-a) učitava datoteku profila sa
+ * podrazumevane putanje; ostali thread-ovi za to vreme čekaju. Bez
+ * datoteke, ili ako nije ispravna, ostaju ugrađene vrednosti.
+ */
+static const SortProfile* activeProfile(void)
+{
+	if (atomic_load_explicit(&g_profileState, memory_order_acquire) != PROFILE_READY)
+	{
+		int expected = PROFILE_UNLOADED;
+		if (atomic_compare_exchange_strong(&g_profileState, &expected, PROFILE_LOADING))
+		{
+			SortProfile loaded;
+			if (profileRead(NULL, &loaded) == SORT_SUCCESS)
+			{
+				g_profile = loaded;
+			}
+			atomic_store_explicit(&g_profileState, PROFILE_READY, memory_order_release);
+		}
+		while (atomic_load_explicit(&g_profileState, memory_order_acquire) != PROFILE_READY)
+		{
+#if RADIX_HAVE_AFFINITY
+			(void)sched_yield();/*čitanje male datoteke, drugi thread čeka*/
+#endif
+		}
+	}
+
+	return &g_profile;
+}
+
+/*
+ * Pomoćna funkcija: Da li su vrednosti profila upotrebljive
+ *
+ * Pragovi po thread-u se koriste kao delioci, a insertion sort je O(n^2),
+ * pa se vrednosti van razumnih granica odbijaju umesto da se primene.
+ */
+static bool profileValid(const SortProfile* profile)
+{
+	return (profile->smallSortThreshold <= PROFILE_SMALL_SORT_MAX) &&
+	       ((profile->wideDigitMaxSize == 0U) || (profile->wideDigitMinSize <= profile->wideDigitMaxSize)) &&
+	       (profile->parallelMinPerThread >= PROFILE_MIN_PER_THREAD) &&
+	       (profile->poolMinPerThread >= PROFILE_MIN_PER_THREAD);
+}
+
+/*
+ * Pomoćna funkcija: Putanja datoteke profila
+ *
+ * path ako nije NULL, zatim RADIXSORT_PROFILE, zatim $HOME/.radixsort-profile.
+ * Vraća false ako putanje nema (RADIXSORT_PROFILE="", nema HOME) ili je
+ * preduga.
+ */
+static bool profilePath(const char* path, char* buffer, size_t capacity)
+{
+	int length = -1;
+
+	if (path == NULL)
+	{
+		path = getenv("RADIXSORT_PROFILE");
+	}
+	if (path != NULL)
+	{
+		length = (path[0] != '\0') ? snprintf(buffer, capacity, "%s", path) : -1;
+	}
+	else
+	{
+		const char* home = getenv("HOME");
+		if ((home != NULL) && (home[0] != '\0'))
+		{
+			length = snprintf(buffer, capacity, "%s/.radixsort-profile", home);
+		}
+	}
+
+	return (length > 0) && ((size_t)length < capacity);
+}
+
+/*
+ * Pomoćna funkcija: Model procesora ("model name" iz /proc/cpuinfo)
+ *
+ * Prazan string ako se ne može pročitati (npr. van Linux-a) - tada se
+ * profil ne proverava po procesoru.
+ */
+static void hostCpuModel(char* buffer, size_t capacity)
+{
+	assert(capacity > 0U);
+
+	buffer[0] = '\0';
+#if defined(__linux__)
+	FILE* file = fopen("/proc/cpuinfo", "r");
+	if (file != NULL)
+	{
+		char line[PROFILE_LINE_MAX];
+		while (fgets(line, (int)sizeof(line), file) != NULL)
+		{
+			char* colon = strchr(line, ':');
+			if ((strncmp(line, "model name", 10U) == 0) && (colon != NULL))
+			{
+				colon++;
+				colon += strspn(colon, " \t");
+				colon[strcspn(colon, "\r\n")] = '\0';
+				(void)snprintf(buffer, capacity, "%s", colon);
+				break;
+			}
+		}
+		(void)fclose(file);
+	}
+#endif
+}
+
+/* Skida razmake sa početka i kraja stringa (u mestu) */
+static char* trimSpaces(char* text)
+{
+	text += strspn(text, " \t");
+	size_t length = strlen(text);
+	while ((length > 0U) && (strchr(" \t\r\n", text[length - 1U]) != NULL))
+	{
+		length--;
+	}
+	text[length] = '\0';
+	return text;
+}
+
+/*
+ * Pomoćna funkcija: Čitanje datoteke profila
+ *
+ * Počinje od ugrađenih vrednosti; svaki red je "ključ = vrednost" ili
+ * komentar. version je obavezan. Red bez '=', vrednost koja nije broj,
+ * profil drugog procesora ili vrednosti koje ne prolaze profileValid
+ * odbijaju celu datoteku.
+ */
+static SortResult profileRead(const char* path, SortProfile* profile)
+{
+	char file[PROFILE_PATH_MAX];
+	if (!profilePath(path, file, sizeof(file)))
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	FILE* input = fopen(file, "r");
+	if (input == NULL)
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	radixSortDefaultProfile(profile);
+
+	const struct
+	{
+		const char* key;
+		size_t* value;
+	} fields[] =
+	{
+		{ "small_sort_threshold", &profile->smallSortThreshold },
+		{ "wide_digit_min_size", &profile->wideDigitMinSize },
+		{ "wide_digit_max_size", &profile->wideDigitMaxSize },
+		{ "write_combine_min_size", &profile->writeCombineMinSize },
+		{ "cache_blocked_min_size", &profile->cacheBlockedMinSize },
+		{ "parallel_min_per_thread", &profile->parallelMinPerThread },
+		{ "pool_min_per_thread", &profile->poolMinPerThread },
+	};
+
+	bool valid = true;
+	bool versioned = false;
+	char line[PROFILE_LINE_MAX];
+	while (valid && (fgets(line, (int)sizeof(line), input) != NULL))
+	{
+		line[strcspn(line, "#")] = '\0';
+		char* key = trimSpaces(line);
+		if (key[0] == '\0')
+		{
+			continue;
+		}
+
+		char* separator = strchr(key, '=');
+		if (separator == NULL)
+		{
+			valid = false;
+			break;
+		}
+		*separator = '\0';
+		key = trimSpaces(key);
+		char* text = trimSpaces(separator + 1);
+
+		if (strcmp(key, "cpu") == 0)
+		{
+			char model[PROFILE_LINE_MAX];
+			hostCpuModel(model, sizeof(model));
+			valid = (model[0] == '\0') || (strcmp(model, text) == 0);/*profil izmeren na drugom procesoru*/
+			continue;
+		}
+
+		char* end = NULL;
+		unsigned long long number = strtoull(text, &end, 10);
+		if ((text[0] < '0') || (text[0] > '9') || (*end != '\0') || (number > SIZE_MAX))
+		{
+			valid = false;
+			break;
+		}
+
+		if (strcmp(key, "version") == 0)
+		{
+			valid = (number == PROFILE_VERSION);
+			versioned = true;
+			continue;
+		}
+		for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++)
+		{
+			if (strcmp(key, fields[f].key) == 0)
+			{
+				*fields[f].value = (size_t)number;
+			}
+		}
+	}
+	(void)fclose(input);
+
+	return (valid && versioned && profileValid(profile)) ? SORT_SUCCESS : SORT_ERROR_ARGUMENT;
+}
+
+SortResult radixSortLoadProfile(const char* path)
+{
+	SortProfile loaded;
+	SortResult result = profileRead(path, &loaded);
+	if (result == SORT_SUCCESS)
+	{
+		g_profile = loaded;
+		atomic_store_explicit(&g_profileState, PROFILE_READY, memory_order_release);
+	}
+	return result;
+}
+
+SortResult radixSortSaveProfile(const char* path)
+{
+	char file[PROFILE_PATH_MAX];
+	if (!profilePath(path, file, sizeof(file)))
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	const SortProfile* profile = activeProfile();
+	char model[PROFILE_LINE_MAX];
+	hostCpuModel(model, sizeof(model));
+
+	FILE* output = fopen(file, "w");
+	if (output == NULL)
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	int written = fprintf(output, "# radixsort profil mašine (radixsort_tune), L2 = %zu B\n", privateCacheBytes());
+	written = (written < 0) ? written : fprintf(output, "version = %u\n", PROFILE_VERSION);
+	if ((written >= 0) && (model[0] != '\0'))
+	{
+		written = fprintf(output, "cpu = %s\n", model);
+	}
+	written = (written < 0) ? written : fprintf(output,
+		"small_sort_threshold = %zu\n"
+		"wide_digit_min_size = %zu\n"
+		"wide_digit_max_size = %zu\n"
+		"write_combine_min_size = %zu\n"
+		"cache_blocked_min_size = %zu\n"
+		"parallel_min_per_thread = %zu\n"
+		"pool_min_per_thread = %zu\n",
+		profile->smallSortThreshold, profile->wideDigitMinSize, profile->wideDigitMaxSize,
+		profile->writeCombineMinSize, profile->cacheBlockedMinSize,
+		profile->parallelMinPerThread, profile->poolMinPerThread);
+
+	bool closed = (fclose(output) == 0);
+	return ((written >= 0) && closed) ? SORT_SUCCESS : SORT_ERROR_ARGUMENT;
+}
+
+void radixSortGetProfile(SortProfile* profile)
+{
+	if (profile != NULL)
+	{
+		*profile = *activeProfile();
+	}
+}
+
+SortResult radixSortSetProfile(const SortProfile* profile)
+{
+	if (profile == NULL)
+	{
+		return SORT_ERROR_NULL;
+	}
+
+	if (!profileValid(profile))
+	{
+		return SORT_ERROR_ARGUMENT;
+	}
+
+	g_profile = *profile;
+	atomic_store_explicit(&g_profileState, PROFILE_READY, memory_order_release);
+	return SORT_SUCCESS;
+}
+
+void radixSortDefaultProfile(SortProfile* profile)
+{
+	if (profile != NULL)
+	{
+		*profile = (SortProfile){ SMALL_SORT_THRESHOLD, 0U, 0U, 0U, 0U, PARALLEL_MIN_PER_THREAD, POOL_MIN_PER_THREAD };
+	}
+}
+
+void radixSortReleaseThreadCache(void)
+{
+	cacheTrim(&g_scratchCache, 0U);
+	g_scratchCache.calls = 0U;
+	g_scratchCache.highWater = 0U;
+}
+
+size_t radixSortThreadCacheBytes(void)
+{
+	size_t total = 0U;
+	for (size_t s = 0; s < SCRATCH_CACHE_SLOTS; s++)
+	{
+		if (g_scratchCache.slots[s].ptr != NULL)
+		{
+			total += g_scratchCache.slots[s].bytes;
+		}
+	}
+	return total;
+}
+
+void radixSortGetStats(SortStats* stats)
+{
+	if (stats != NULL)
+	{
+		*stats = g_lastStats;
+	}
+}
+
 /* Za niz od 1,000,000 elemenata:
 
 KLASIČAN RADIX SORT:
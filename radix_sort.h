@@ -10,16 +10,126 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus /* C++ front end (radix_sort.hpp) poziva iste funkcije */
+extern "C" {
+#endif
 
 typedef enum
 {
 	SORT_SUCCESS = 0,
 	SORT_ERROR_NULL = -1,
 	SORT_ERROR_SIZE = -2,
-	SORT_ERROR_MEMORY = -3
+	SORT_ERROR_MEMORY = -3,
+	SORT_ERROR_ARGUMENT = -4
 } SortResult;
 /*MISRA Rule 8.12 i Rule 8.1 ispostovani jer su enumm definicije u headeru*/
 
+/*
+ * Politika alokacije pomoćnih (scratch) bafera.
+ *
+ *   SORT_HUGEPAGES_OFF         - običan malloc(), 4 KB stranice
+ *   SORT_HUGEPAGES_TRANSPARENT - bafer poravnat na 2 MB + madvise(MADV_HUGEPAGE)
+ *   SORT_HUGEPAGES_AUTO        - prvo eksplicitne hugetlbfs stranice (MAP_HUGETLB),
+ *                                zatim transparentne, na kraju običan malloc()
+ */
+typedef enum
+{
+	SORT_HUGEPAGES_OFF = 0,
+	SORT_HUGEPAGES_TRANSPARENT = 1,
+	SORT_HUGEPAGES_AUTO = 2
+} SortHugePagePolicy;
+
+/*
+ * Vrsta stranica koje su zaista dobijene za scratch bafere poslednjeg poziva.
+ */
+typedef enum
+{
+	SORT_PAGES_NONE = 0,        /* nije bilo alokacije (npr. size == 1) */
+	SORT_PAGES_NORMAL = 1,      /* obične 4 KB stranice */
+	SORT_PAGES_TRANSPARENT = 2, /* kernel je prihvatio MADV_HUGEPAGE, THP je uključen */
+	SORT_PAGES_HUGETLB = 3      /* eksplicitne huge stranice iz hugetlbfs rezerve */
+} SortPageKind;
+
+/*
+ * Strategija koju je izabrao poslednji poziv sortiranja.
+ */
+typedef enum
+{
+	SORT_STRATEGY_NONE = 0,      /* ništa nije pomereno (npr. svi elementi isti) */
+	SORT_STRATEGY_INSERTION = 1, /* mali niz, insertion sort */
+	SORT_STRATEGY_LSD = 2,       /* LSD prolazi po bajtovima */
+	SORT_STRATEGY_COUNTING = 3,  /* direktan counting sort uskog opsega */
+	SORT_STRATEGY_PARALLEL = 4,  /* višenitni MSD + LSD */
+	SORT_STRATEGY_BATCH = 5,     /* više nezavisnih nizova ili segmenata */
+	SORT_STRATEGY_LOW_CARDINALITY = 6, /* hash brojanje malo različitih vrednosti */
+	SORT_STRATEGY_CACHE_BLOCKED = 7,   /* MSD po najvišem bajtu + LSD po bucket-u u kešu */
+	SORT_STRATEGY_MERGE_RUNS = 8,      /* k-way spajanje nekoliko sortiranih delova */
+	SORT_STRATEGY_CHUNKED = 9,         /* radixSortBudget: delovi u limitu memorije + spajanje u mestu */
+	SORT_STRATEGY_STRING_MSD = 10,     /* radixSortStrings: MSD po bajtovima + multikey quicksort */
+	SORT_STRATEGY_KEYS_MSD = 11        /* radixSortKeysN: MSD po bajtovima širokog ključa */
+} SortStrategy;
+
+/*
+ * Podešavanja biblioteke. Menjaju se pre pokretanja sortiranja,
+ * ne dok drugi thread-ovi sortiraju.
+ */
+typedef struct
+{
+	SortHugePagePolicy hugePages;
+	bool numaAware; /* radixSortParallel: pinovanje po čvorovima + first-touch bafera */
+	size_t threadCacheBytes; /* keš pomoćnih bafera po thread-u do ove veličine (0 = bez keša) */
+} SortConfig;
+
+/*
+ * Profil mašine: pragovi po kojima radixSort bira strategiju. Prave
+ * vrednosti zavise od keša, TLB-a i broja jezgara, pa ih radixsort_tune
+ * meri na samoj mašini i upisuje u datoteku profila (vidi
+ * radixSortLoadProfile). Veličine su u elementima.
+ */
+typedef struct
+{
+	size_t smallSortThreshold;    /* radixSort / radixSortCopy: do ovoliko elemenata insertion sort (0 = nikad) */
+	size_t wideDigitMinSize;      /* 11-bitne cifre (3 prolaza umesto 4) za ključeve pune širine od ovoliko elemenata */
+	size_t wideDigitMaxSize;      /* ... do ovoliko elemenata (0 = nikad) */
+	size_t writeCombineMinSize;   /* LSD rasipanje kroz bafere od keš linije po bucket-u od ovoliko elemenata (0 = nikad) */
+	size_t cacheBlockedMinSize;   /* keš-blokirana varijanta od ovoliko elemenata (0 = dvostruka veličina L2) */
+	size_t parallelMinPerThread;  /* radixSortParallel / Batch / Segmented: najmanje elemenata po thread-u */
+	size_t poolMinPerThread;      /* radixSortWithContext: najmanje elemenata po thread-u iz pool-a */
+} SortProfile;
+
+/*
+ * Statistika poslednjeg poziva sortiranja u tekućem thread-u.
+ */
+typedef struct
+{
+	size_t scratchBytes;   /* ukupno alocirano za pomoćne bafere */
+	SortPageKind pages;    /* najslabija vrsta stranica među baferima */
+	size_t threads;        /* broj thread-ova koji su sortirali */
+	size_t numaNodes;      /* broj NUMA čvorova sa pinovanim thread-ovima (0 = bez pinovanja) */
+	SortStrategy strategy; /* izabrana strategija */
+	size_t passes;         /* broj prolaza rasipanja po bajtu (radixSort) */
+} SortStats;
+
+/*
+ * Sažetak raspodele (radixSummarize). Kvantili su tačni elementi niza
+ * (index floor(q * (n - 1)) u sortiranom nizu).
+ */
+typedef struct
+{
+	size_t count;
+	int32_t min;
+	int32_t p25;
+	int32_t median;
+	int32_t p75;
+	int32_t p90;
+	int32_t p99;
+	int32_t p999;
+	int32_t max;
+	double mean;
+} DistributionSummary;
+
 /*
  * Funkcija: radixSort
  * 
@@ -28,6 +138,25 @@ typedef enum
  *
  * Za int32_t tip, d = 4 bajta (konstanta), pa je složenost O(n).
  *
+ * Prvo čitanje nalazi min i max. Ključevi se umanjuju za min, pa se rade
+ * samo prolazi po bajtovima koje opseg (max - min) zaista koristi, bez
+ * obzira na to gde se opseg nalazi. Ako je opseg manji od broja elemenata,
+ * radi se direktan counting sort (jedno brojanje + popunjavanje).
+ *
+ * Za nizove od bar 8192 elementa uzorak od 1024 elementa proverava da li
+ * ulaz ima malo različitih vrednosti (npr. enum kodovi rasuti po celom
+ * int32_t opsegu). Ako ima, vrednosti se prebroje u maloj hash tabeli,
+ * sortiraju se samo različite vrednosti (najviše 1024) i niz se popuni -
+ * jedno čitanje i jedno pisanje, bez prolaza rasipanja.
+ *
+ * Prvo čitanje broji i prirodne rastuće delove. Sortiran niz se ne dira,
+ * a niz od 2 do 16 sortiranih delova (npr. nadovezani sortirani segmenti)
+ * spaja se jednim k-way spajanjem turnirskim stablom umesto prolaza.
+ *
+ * Pragovi izbora (insertion sort za male nizove, 11-bitne cifre,
+ * rasipanje kroz bafere po bucket-u, keš-blokirana varijanta) dolaze iz
+ * profila mašine (vidi SortProfile i radixSortLoadProfile).
+ *
  * Parametri:
  *   arr  - pokazivač na niz int32_t vrednosti (menja se in-place)
  *   size - broj elemenata u nizu
@@ -41,11 +170,502 @@ typedef enum
  * Napomena:
  *   - Funkcija modifikuje ulazni niz direktno (in-place sortiranje)
  *   - Stabilan algoritam (čuva relativni redosled jednakih elemenata)
- *   - Radi odlično za bilo koji opseg vrednosti
+ *   - Radi odlično za bilo koji opseg vrednosti, uzak opseg je brži
  *   - Koristi byte-by-byte pristup (baza 256) za optimalnu brzinu
  */
 SortResult radixSort(int32_t* arr, size_t size); /*MISRA Rule 8.1 ispostovano, deklarisana funkcija*/
 
+/*
+ * Funkcija: radixSortCopy
+ *
+ * Sortira niz u drugi niz, a ulaz ostavlja neizmenjen. Prvi prolaz čita
+ * direktno iz in, poslednji piše direktno u out, a out služi i kao drugi
+ * bafer za prolaze - alocira se samo jedan scratch bafer (size * 4 B),
+ * umesto memcpy + radixSort sa dva.
+ *
+ * Parametri:
+ *   in   - pokazivač na ulazni niz (samo se čita)
+ *   out  - pokazivač na izlazni niz od size elemenata
+ *   size - broj elemenata
+ *
+ * Povratna vrednost: isto kao radixSort.
+ *
+ * Napomena:
+ *   - in i out ne smeju se delimično preklapati; in == out je isto što
+ *     i radixSort(out, size)
+ *   - Keš-blokirana varijanta traži dva scratch bafera, pa se za velike
+ *     nizove koristi obični LSD
+ */
+SortResult radixSortCopy(const int32_t* in, int32_t* out, size_t size);
+
+/*
+ * Funkcija: radixSortUnique / radixSortCounts
+ *
+ * Sortira niz i ostavlja na njegovom početku samo različite vrednosti,
+ * rastuće. Duplikati se izbacuju u poslednjem prolazu sortiranja (ili u
+ * popunjavanju kod counting i hash putanje), bez posebnog prolaza posle.
+ *
+ * Parametri:
+ *   arr         - pokazivač na niz int32_t vrednosti (menja se in-place)
+ *   size        - broj elemenata u nizu
+ *   newSize     - izlaz: broj različitih vrednosti (nova dužina niza)
+ *   counts      - izlaz: counts[i] je broj pojavljivanja arr[i]; mora
+ *                 imati mesta za size elemenata (broj različitih se ne
+ *                 zna unapred)
+ *   numDistinct - izlaz: broj različitih vrednosti
+ *
+ * Povratna vrednost: isto kao radixSort; SORT_ERROR_NULL i za NULL izlaz.
+ *
+ * Napomena:
+ *   - Sadržaj arr posle nove dužine nije definisan
+ */
+SortResult radixSortUnique(int32_t* arr, size_t size, size_t* newSize);
+SortResult radixSortCounts(int32_t* arr, size_t size, size_t* counts, size_t* numDistinct);
+
+/*
+ * Funkcija: radixSortParallel
+ *
+ * Višenitna varijanta radixSort-a za velike nizove.
+ *
+ * Koraci:
+ *   1. Svaki thread pravi histograme bajtova za svoj deo niza
+ *   2. Bira se najviši bajt koji nije isti za sve elemente (MSD cifra),
+ *      njegovi bucket-i se dele thread-ovima u susedne grupe ~size/numThreads
+ *   3. Svaki thread rasipa svoj deo niza po MSD cifri u scratch bafer
+ *   4. Svaki thread LSD-om sortira svoje bucket-e po preostalim nižim
+ *      bajtovima, i to samo unutar svog dela scratch bafera
+ *
+ * Sa config.numaAware thread-ovi se pinuju na CPU-ove grupisane po NUMA
+ * čvorovima, a svaki thread prvi dodiruje (first-touch) deo scratch bafera
+ * koji će u koraku 4 čitati i pisati, pa taj deo kernel smešta na njegov
+ * čvor. Samo rasipanje iz koraka 3 ide u udaljenu memoriju.
+ *
+ * Parametri:
+ *   arr        - pokazivač na niz int32_t vrednosti (menja se in-place)
+ *   size       - broj elemenata u nizu
+ *   numThreads - broj thread-ova, 0 = broj dostupnih CPU-ova
+ *
+ * Povratna vrednost: isto kao radixSort.
+ *
+ * Napomena:
+ *   - Za male nizove (manje od 64K elemenata po thread-u) broj thread-ova
+ *     se smanjuje, do običnog radixSort-a
+ *   - Na platformama bez POSIX thread-ova poziva radixSort
+ */
+SortResult radixSortParallel(int32_t* arr, size_t size, size_t numThreads);
+
+/*
+ * Funkcija: radixSortBatch / radixSortBatchParallel
+ *
+ * Sortira count nezavisnih nizova u jednom pozivu. Umesto alokacije i
+ * pripreme bucket-a za svaki niz posebno, jedan scratch bafer (za najveći
+ * niz) deli se između svih nizova. Nizovi do 32 elementa idu na insertion
+ * sort, ostali na LSD radix sa preskakanjem bajtova koji su isti za sve.
+ *
+ * radixSortBatchParallel deli nizove u susedne opsege sa približno istim
+ * ukupnim brojem elemenata, jedan opseg po thread-u (numThreads = 0 znači
+ * broj dostupnih CPU-ova). Svaki thread ima svoj scratch bafer.
+ *
+ * Parametri:
+ *   arrays - niz od count pokazivača na nizove (menjaju se in-place)
+ *   sizes  - veličine nizova; veličina 0 je dozvoljena i niz se preskače
+ *   count  - broj nizova
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS      - svi nizovi su sortirani
+ *   SORT_ERROR_NULL   - arrays ili sizes je NULL, ili je neki niz NULL a
+ *                       veličina mu nije 0 (ništa nije sortirano)
+ *   SORT_ERROR_SIZE   - count je 0
+ *   SORT_ERROR_MEMORY - neuspela alokacija (deo nizova može biti sortiran)
+ */
+SortResult radixSortBatch(int32_t** arrays, const size_t* sizes, size_t count);
+SortResult radixSortBatchParallel(int32_t** arrays, const size_t* sizes, size_t count, size_t numThreads);
+
+/*
+ * Funkcija: radixSortSegmented / radixSortSegmentedParallel
+ *
+ * Sortira svaki segment jednog kontinualnog niza nezavisno (CSR raspored).
+ * Segment s zauzima data[offsets[s]] .. data[offsets[s + 1] - 1].
+ *
+ * Kratki segmenti se ne sortiraju jedan po jedan, već zajedno, u blokovima
+ * uzastopnih segmenata do 16K elemenata: svaki element dobija kompozitni
+ * ključ (segment, vrednost), LSD prolazi idu po bajtovima vrednosti, a
+ * završni stabilan prolaz vraća elemente u njihov segment. To je najviše
+ * 5 prolaza po bloku bez obzira na broj segmenata, a blok ostaje u kešu.
+ * Segmenti duži od bloka se sortiraju pojedinačno.
+ *
+ * radixSortSegmentedParallel deli segmente u susedne grupe sa približno
+ * istim brojem elemenata, jedna grupa po thread-u (0 = broj CPU-ova).
+ *
+ * Parametri:
+ *   data        - kontinualan niz svih segmenata (menja se in-place)
+ *   offsets     - numSegments + 1 neopadajućih pozicija u data
+ *   numSegments - broj segmenata
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS        - svi segmenti su sortirani
+ *   SORT_ERROR_NULL     - data ili offsets je NULL
+ *   SORT_ERROR_SIZE     - numSegments je 0
+ *   SORT_ERROR_ARGUMENT - offsets nije neopadajući (ništa nije sortirano)
+ *   SORT_ERROR_MEMORY   - neuspela alokacija
+ */
+SortResult radixSortSegmented(int32_t* data, const size_t* offsets, size_t numSegments);
+SortResult radixSortSegmentedParallel(int32_t* data, const size_t* offsets, size_t numSegments, size_t numThreads);
+
+/*
+ * Kontekst za ponovljena sortiranja (neprozirna struktura)
+ */
+typedef struct RadixSortContext RadixSortContext;
+
+/*
+ * Funkcija: radixSortContextCreate / radixSortContextDestroy / radixSortWithContext
+ *
+ * Kontekst drži trajni pool thread-ova, histograme po thread-u i scratch
+ * bafere sa već dodeljenim stranicama. Pokretanje thread-ova i alokacija
+ * pri svakom pozivu (desetine mikrosekundi) tako nestaju, što je bitno za
+ * nizove od 100K do 1M elemenata.
+ *
+ * radixSortWithContext sortira kao radixSortParallel, ali na pool-u
+ * konteksta; thread koji poziva radi kao jedan od thread-ova. Paralelno
+ * se sortira već od 16K elemenata po thread-u, manji nizovi se sortiraju
+ * u thread-u koji poziva, sa scratch baferima konteksta.
+ *
+ * Parametri:
+ *   context    - izlaz (Create), kontekst (ostale funkcije)
+ *   numThreads - veličina pool-a uključujući thread koji poziva,
+ *                0 = broj dostupnih CPU-ova
+ *   capacity   - broj elemenata za koji se baferi alociraju i unapred
+ *                dodeljuju (prefault); 0 = alokacija pri prvom sortiranju.
+ *                Veći niz povećava bafere.
+ *   arr, size  - kao kod radixSort
+ *
+ * Povratna vrednost: SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE ili
+ * SORT_ERROR_MEMORY.
+ *
+ * Napomena:
+ *   - Više thread-ova sme deliti jedan kontekst: pozivi čekaju red
+ *     (FIFO) i izvršavaju se jedan po jedan, svaki na celom pool-u
+ *   - radixSortContextDestroy se ne sme pozvati dok sortiranje traje
+ *   - Sa config.numaAware pomoćni thread-ovi se pinuju pri kreiranju,
+ *     a svaki dodeljuje stranice svog dela bafera
+ */
+SortResult radixSortContextCreate(RadixSortContext** context, size_t numThreads, size_t capacity);
+void radixSortContextDestroy(RadixSortContext* context);
+SortResult radixSortWithContext(RadixSortContext* context, int32_t* arr, size_t size);
+
+/*
+ * Asinhroni posao sortiranja (neprozirna struktura) i callback završetka
+ */
+typedef struct RadixSortHandle RadixSortHandle;
+typedef void (*RadixSortCallback)(int32_t* arr, size_t size, SortResult result, void* userdata);
+
+/*
+ * Funkcija: radixSortAsync / radixSortWait / radixSortPoll / radixSortDetach
+ *
+ * radixSortAsync stavlja sortiranje u red pozadinskog pool-a (po jedan
+ * thread na CPU, pravi se pri prvom pozivu) i odmah vraća handle. Svaki
+ * posao sortira jedan thread, pa više predatih nizova ide istovremeno na
+ * različitim jezgrima, a redom kojim su predati.
+ *
+ * Parametri:
+ *   arr, size - kao kod radixSort; niz se ne sme koristiti do završetka
+ *   callback  - poziva se iz pozadinskog thread-a posle sortiranja
+ *               (sme biti NULL)
+ *   userdata  - prosleđuje se callback-u
+ *   handle    - vraćen iz radixSortAsync
+ *   result    - izlaz za radixSortPoll
+ *
+ * Povratna vrednost:
+ *   radixSortAsync  - handle, NULL samo ako handle nije mogao da se alocira
+ *   radixSortWait   - čeka kraj, vraća rezultat posla i oslobađa handle
+ *   radixSortPoll   - false ako posao još traje; true sa rezultatom u
+ *                     *result, i tada oslobađa handle
+ *   radixSortDetach - handle se oslobađa sam posle završetka
+ *
+ * Napomena:
+ *   - Greške argumenata (NULL niz, size 0) dolaze kao rezultat posla
+ *   - Svaki handle se završava tačno jednom: Wait, Poll koji vrati true,
+ *     ili Detach
+ *   - Callback je završen pre nego što Wait/Poll prijave kraj
+ *   - Bez POSIX thread-ova sortira se odmah u radixSortAsync
+ */
+RadixSortHandle* radixSortAsync(int32_t* arr, size_t size, RadixSortCallback callback, void* userdata);
+SortResult radixSortWait(RadixSortHandle* handle);
+bool radixSortPoll(RadixSortHandle* handle, SortResult* result);
+void radixSortDetach(RadixSortHandle* handle);
+
+/*
+ * Funkcija: radixPackedEncode / radixSortPacked / radixPackedDecode /
+ *           radixPackedFind / radixPackedBound
+ *
+ * Zapakovan oblik sortiranog niza za keš ili disk: blokovi od 128
+ * elemenata, svaki čuva prvi element i razlike uzastopnih elemenata
+ * spakovane u onoliko bitova koliko traži najveća razlika u bloku.
+ * Direktorijum prvih elemenata omogućava pretragu uz raspakivanje samo
+ * jednog bloka. Dekodiranje koristi SSE2 kada je dostupan.
+ *
+ * Parametri:
+ *   sorted, size    - sortiran niz (neopadajući redosled)
+ *   arr             - radixSortPacked ga prvo sortira (kao radixSort)
+ *   out, capacity   - izlazni bafer poravnat na 8 bajtova (malloc to daje);
+ *                     radixPackedBound(size) bajtova je uvek dovoljno
+ *   bytes           - izlaz: broj upisanih bajtova / dužina zapakovanog
+ *   packed          - bafer koji je napravio radixPackedEncode
+ *   out (decode)    - niz od capacity elemenata
+ *   count           - izlaz: broj elemenata u zapakovanom nizu
+ *   value, index    - radixPackedFind: index prvog elementa >= value
+ *                     (broj elemenata ako takvog nema)
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE (size 0; kod decode
+ *   capacity < count, a *count je upisan), SORT_ERROR_ARGUMENT (ulaz
+ *   nije sortiran, bafer premali ili neporavnat, neispravno zaglavlje ili
+ *   direktorijum blokova)
+ *
+ * Napomena:
+ *   - Raspored koristi nativni redosled bajtova
+ *   - Za slučajne int32_t vrednosti n = 10^6 zauzima ~15.5 bita po
+ *     elementu, za guste ili ponovljene vrednosti nekoliko bita
+ *   - Decode i Find pre čitanja proveravaju ceo direktorijum (pomeraji ne
+ *     opadaju i ne prelaze podatke, širina bloka do 32 bita), pa oštećen
+ *     bafer daje SORT_ERROR_ARGUMENT umesto čitanja van bafera
+ */
+size_t radixPackedBound(size_t size);
+SortResult radixPackedEncode(const int32_t* sorted, size_t size, uint8_t* out, size_t capacity, size_t* bytes);
+SortResult radixSortPacked(int32_t* arr, size_t size, uint8_t* out, size_t capacity, size_t* bytes);
+SortResult radixPackedDecode(const uint8_t* packed, size_t bytes, int32_t* out, size_t capacity, size_t* count);
+SortResult radixPackedFind(const uint8_t* packed, size_t bytes, int32_t value, size_t* index);
+
+/*
+ * Funkcija: radixSortColumns
+ *
+ * Leksikografsko sortiranje redova tabele zadate kolonama (prvo po
+ * cols[0], pa po cols[1], ...). Kolone se ne menjaju: vraća se
+ * permutacija, perm[i] je index reda koji ide na mesto i. Jednaki redovi
+ * ostaju u originalnom redosledu.
+ *
+ * LSD po kolonama: od poslednje kolone ka prvoj, svaka se sortira
+ * stabilnim prolazima po bajtovima nad parovima (ključ, index) u jednoj
+ * 64-bitnoj reči. Kao kod radixSort, ključevi kolone se umanjuju za
+ * minimum kada to štedi prolaze, a bajtovi isti za sve se preskaču.
+ *
+ * Parametri:
+ *   cols    - niz od numCols pokazivača na kolone od po n elemenata
+ *   numCols - broj kolona (bar 1)
+ *   n       - broj redova, najviše UINT32_MAX
+ *   perm    - izlaz: n indeksa
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE (n je 0 ili preveliko),
+ *   SORT_ERROR_ARGUMENT (numCols je 0), SORT_ERROR_MEMORY
+ *
+ * Napomena:
+ *   - Scratch je 2 * n * 8 bajtova
+ *   - Svaka kolona osim poslednje se čita nasumično, po tekućoj
+ *     permutaciji (sa najavom čitanja unapred)
+ */
+SortResult radixSortColumns(const int32_t** cols, size_t numCols, size_t n, uint32_t* perm);
+
+/*
+ * Funkcija: radixSortRecords
+ *
+ * Stabilno sortira niz zapisa fiksne veličine po int32_t polju, u mestu.
+ *
+ * Parametri:
+ *   base      - početak niza zapisa
+ *   n         - broj zapisa
+ *   stride    - veličina zapisa u bajtovima (razmak između zapisa)
+ *   keyOffset - pomeraj int32_t ključa unutar zapisa (ne mora biti poravnat)
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE (n je 0),
+ *   SORT_ERROR_ARGUMENT (ključ ne staje u zapis), SORT_ERROR_MEMORY
+ *
+ * Napomena:
+ *   - Zapisi manji od 32 bajta se pomeraju celi u svakom prolazu
+ *     (scratch n * stride bajtova)
+ *   - Veći zapisi: sortiraju se (ključ, index) parovi, pa se zapisi
+ *     premeste jednom - do 128 bajtova gather-om u scratch (16 * n +
+ *     n * stride bajtova), od 128 bajtova praćenjem ciklusa permutacije
+ *     u mestu (16 * n bajtova + jedan zapis)
+ *   - Izbor prolaza je isti kao kod radixSort (umanjenje za min,
+ *     preskakanje bajtova istih za sve)
+ */
+SortResult radixSortRecords(void* base, size_t n, size_t stride, size_t keyOffset);
+
+/*
+ * Funkcija: radixGather
+ *
+ * Primena permutacije na kolonu podataka (payload): dst[i] = src[perm[i]]
+ * za elemente od elemSize bajtova. Upisi su sekvencijalni, a nasumična
+ * čitanja se najavljuju unapred (prefetch), pa više promašaja keša čeka
+ * istovremeno. Elementi od 4 i 8 bajtova imaju posebnu petlju.
+ *
+ * Parametri:
+ *   src, dst - izvorna i odredišna kolona od n elemenata (ne preklapaju se)
+ *   elemSize - veličina elementa u bajtovima
+ *   perm     - permutacija iz radixSortColumns (svi indeksi < n)
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE (n je 0),
+ *   SORT_ERROR_ARGUMENT (elemSize je 0)
+ */
+SortResult radixGather(const void* src, size_t elemSize, size_t n, const uint32_t* perm, void* dst);
+
+/*
+ * Funkcija: radixSortBudget
+ *
+ * Sortiranje u mestu sa tvrdim limitom pomoćne memorije. Kada ceo
+ * scratch (2 * n * 4 bajtova, zaokruženo na huge stranice) staje u
+ * limit, radi isto što i radixSort. Inače se alocira jedan region u
+ * okviru limita, niz se deli na delove od pola regiona koji se sortiraju
+ * običnim putem (radix, counting, ...), pa se delovi spajaju odozdo
+ * nagore u mestu, sa regionom kao baferom za spajanje.
+ *
+ * Parametri:
+ *   arr             - niz koji se sortira
+ *   n               - broj elemenata
+ *   maxScratchBytes - najviše bajtova pomoćne memorije (može biti 0)
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE (n je 0)
+ *
+ * Napomena:
+ *   - Nikad ne vraća SORT_ERROR_MEMORY: ako alokacija ne uspe, region se
+ *     polovi, a bez regiona delovi su od 32 elementa (insertion sort) i
+ *     spajanje je potpuno u mestu (zamene blokova obrtanjem), O(n log^2 n)
+ *   - Sa limitom od nešto više od n * 4 bajtova niz se deli na dva dela i spaja
+ *     jednom; svako prepolovljenje limita dodaje jedan nivo spajanja
+ *   - scratchBytes u statistici je uvek <= maxScratchBytes; strategija
+ *     je SORT_STRATEGY_CHUNKED, a passes broj nivoa spajanja
+ */
+SortResult radixSortBudget(int32_t* arr, size_t n, size_t maxScratchBytes);
+
+/*
+ * Funkcija: radixQuantiles / radixQuantilesApprox / radixSummarize
+ *
+ * Kvantili bez sortiranja: podaci se samo čitaju, ništa se ne pomera.
+ * out[i] je element sa indexom floor(qs[i] * (n - 1)) u sortiranom
+ * nizu (qs[i] = 0 je minimum, 1 maksimum, 0.5 donja medijana).
+ *
+ * Prvo čitanje pravi histogram gornjih 16 bita ključa i iz prefiksne
+ * sume nalazi bucket svakog traženog ranga. Drugo čitanje broji donjih
+ * 16 bita samo za elemente tih bucket-a, pa je rezultat tačan. Do 8
+ * različitih ciljnih bucket-a ide u jedno drugo čitanje, za svakih
+ * sledećih 8 po jedno više.
+ *
+ * radixQuantilesApprox ne razrešava bucket sa najviše epsilon * n
+ * elemenata, već interpolira vrednost unutar njegovog opsega: rang
+ * vraćene vrednosti se od traženog razlikuje najviše za epsilon * n,
+ * ali ona ne mora biti element niza. Kada su svi ciljni bucket-i mali
+ * (npr. n = 10^7 raširenih vrednosti, epsilon = 0.001), dovoljno je
+ * jedno čitanje.
+ *
+ * radixSummarize računa min, kvartile, p90, p99, p99.9, max (tačno) i
+ * srednju vrednost u dva čitanja.
+ *
+ * Parametri:
+ *   data    - niz od n elemenata (ne menja se)
+ *   n       - broj elemenata, najviše UINT32_MAX
+ *   qs      - numQs kvantila iz [0, 1], proizvoljnim redom
+ *   epsilon - dozvoljena greška ranga kao deo n (0 = tačno)
+ *   out     - izlaz: numQs vrednosti, istim redom kao qs
+ *   summary - izlaz radixSummarize
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE (n je 0 ili preveliko),
+ *   SORT_ERROR_ARGUMENT (numQs je 0, q van [0, 1], epsilon < 0),
+ *   SORT_ERROR_MEMORY
+ *
+ * Napomena:
+ *   - Scratch je 1-2 MB (histogrami) bez obzira na n
+ *   - Do 65536 elemenata kopija niza se sortira u scratch-u (12 * n
+ *     bajtova) i kvantili se čitaju direktno - jeftinije od histograma
+ *   - passes u statistici je broj čitanja niza
+ */
+SortResult radixQuantiles(const int32_t* data, size_t n, const double* qs, size_t numQs, int32_t* out);
+SortResult radixQuantilesApprox(const int32_t* data, size_t n, const double* qs, size_t numQs, double epsilon, int32_t* out);
+SortResult radixSummarize(const int32_t* data, size_t n, DistributionSummary* summary);
+
+/*
+ * String promenljive dužine: text ne mora biti završen nulom, bajtovi
+ * (i '\0') se porede kao unsigned char.
+ */
+typedef struct
+{
+	const char* text;
+	size_t length;
+} RadixString;
+
+/*
+ * Funkcija: radixSortStrings / radixSortStringOffsets
+ *
+ * Stabilno sortiranje stringova po bajtovima, kao memcmp, a kraći
+ * prefiks ide pre dužeg ("ab" < "abc"). radixSortStrings sortira niz
+ * opisa (pokazivač, dužina) u mestu; radixSortStringOffsets čita
+ * stringove iz jednog bloka, string i je blob[offsets[i], offsets[i + 1]),
+ * i vraća permutaciju kao radixSortColumns.
+ *
+ * MSD po bajtovima (256 bucket-a): uz svaki string se čuva keš reč sa
+ * sledećih 7 znakova i brojem preostalih (do 7), pa prolazi po bajtovima
+ * ne čitaju string. Tekst se čita samo kada grupa iscrpi keš (jednom na
+ * 7 znakova zajedničkog prefiksa), sa najavom čitanja unapred. Bajt isti
+ * za celu grupu se preskače bez pomeranja. Grupe manje od 64 stringa
+ * idu u multikey quicksort (Bentley-Sedgewick), a najmanje u insertion
+ * sort.
+ *
+ * Parametri:
+ *   strings - niz od n opisa stringova
+ *   blob    - blok sa tekstom svih stringova
+ *   offsets - n + 1 neopadajućih pomeraja u blob
+ *   n       - broj stringova, najviše UINT32_MAX
+ *   perm    - izlaz: n indeksa, perm[i] je string koji ide na mesto i
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE (n je 0 ili preveliko,
+ *   string duži od UINT32_MAX), SORT_ERROR_ARGUMENT (offsets opadaju),
+ *   SORT_ERROR_MEMORY
+ *
+ * Napomena:
+ *   - Scratch je 2 * n * 24 bajta; tekst se ne kopira i ne menja
+ *   - Strategija je SORT_STRATEGY_STRING_MSD, a passes broj punjenja
+ *     keš reči u MSD delu (po grupama od bar 64 stringa)
+ */
+SortResult radixSortStrings(RadixString* strings, size_t n);
+SortResult radixSortStringOffsets(const char* blob, const size_t* offsets, size_t n, uint32_t* perm);
+
+/*
+ * Funkcija: radixSortKeysN
+ *
+ * Sortiranje u mestu n ključeva fiksne dužine od keyBytes bajtova
+ * (UUID, IPv6 adresa, složeni ključ), bajt po bajt kao memcmp: bajt 0
+ * je najviši. Celi brojevi moraju biti zapisani big-endian, a označeni
+ * sa obrnutim bitom znaka.
+ *
+ * Ključevi do 16 bajtova: jedno čitanje broji sve bajtove, bajtovi isti
+ * za sve ključeve se preskaču. Ako ostane najviše 6 bajtova (8 kada
+ * ključevi i pomoćni bafer staju u L2), LSD prolazi idu od poslednjeg
+ * ka prvom; inače, i za šire ključeve, MSD od prvog bajta koji se
+ * menja: posle 2-3 nivoa grupe su male i završava ih insertion sort, pa
+ * broj prolaza ne raste sa dužinom ključa. MSD i u svakoj grupi
+ * preskače bajt isti za celu grupu.
+ *
+ * Parametri:
+ *   keys     - niz od n ključeva (poravnanje nije potrebno)
+ *   keyBytes - dužina ključa u bajtovima (bar 1)
+ *   n        - broj ključeva
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS, SORT_ERROR_NULL, SORT_ERROR_SIZE (n je 0 ili n * keyBytes
+ *   ne staje u size_t), SORT_ERROR_ARGUMENT (keyBytes je 0), SORT_ERROR_MEMORY
+ *
+ * Napomena:
+ *   - Scratch je n * keyBytes bajtova (+ 32 KB histograma za ključeve do 16 bajtova)
+ *   - Strategija je SORT_STRATEGY_LSD (passes = broj prolaza) ili
+ *     SORT_STRATEGY_KEYS_MSD (passes = najveća dubina MSD nivoa)
+ */
+SortResult radixSortKeysN(void* keys, size_t keyBytes, size_t n);
+
 /*
  * Funkcija: getSortResultString
  * 
@@ -60,4 +680,121 @@ SortResult radixSort(int32_t* arr, size_t size); /*MISRA Rule 8.1 ispostovano, d
 const char* getSortResultString(SortResult result);
 /*MISRA Rule 11.5 Rule 20.1/20.2 ispostovano const char**/
 
+/*
+ * Funkcija: radixSortGetConfig / radixSortSetConfig
+ *
+ * Čita, odnosno postavlja globalna podešavanja biblioteke.
+ * Podrazumevano: hugePages = SORT_HUGEPAGES_AUTO, numaAware = true,
+ * threadCacheBytes = 0.
+ *
+ * Povratna vrednost (radixSortSetConfig):
+ *   SORT_SUCCESS    - podešavanja su primenjena
+ *   SORT_ERROR_NULL - config je NULL
+ */
+void radixSortGetConfig(SortConfig* config);
+SortResult radixSortSetConfig(const SortConfig* config);
+
+/*
+ * Funkcija: radixSortLoadProfile / radixSortSaveProfile
+ *
+ * Učitava profil mašine iz datoteke, odnosno upisuje aktivan profil u
+ * datoteku. Format je tekstualan, po jedan "ključ = vrednost" u redu,
+ * '#' započinje komentar:
+ *
+ *     version = 1
+ *     cpu = <model procesora>
+ *     small_sort_threshold = 32
+ *     wide_digit_min_size = 0
+ *     wide_digit_max_size = 0
+ *     write_combine_min_size = 0
+ *     cache_blocked_min_size = 0
+ *     parallel_min_per_thread = 65536
+ *     pool_min_per_thread = 16384
+ *
+ * Ključ koji nedostaje zadržava ugrađenu vrednost, nepoznat ključ se
+ * preskače. Profil izmeren na drugom procesoru (cpu se ne poklapa sa
+ * modelom iz /proc/cpuinfo) se ne primenjuje.
+ *
+ * Parametri:
+ *   path - putanja datoteke; NULL = podrazumevana: promenljiva okruženja
+ *          RADIXSORT_PROFILE, inače $HOME/.radixsort-profile
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS        - profil je učitan i primenjen, odnosno upisan
+ *   SORT_ERROR_ARGUMENT - datoteka ne postoji, ne može da se upiše, nije
+ *                         ispravna ili je profil za drugi procesor
+ *                         (aktivan profil ostaje nepromenjen)
+ *
+ * Napomena:
+ *   - Biblioteka sama učitava profil sa podrazumevane putanje jednom, pri
+ *     prvom sortiranju; bez datoteke važe ugrađene vrednosti
+ *   - RADIXSORT_PROFILE="" isključuje automatsko učitavanje
+ *   - Kao i radixSortSetConfig, ne poziva se dok drugi thread-ovi sortiraju
+ */
+SortResult radixSortLoadProfile(const char* path);
+SortResult radixSortSaveProfile(const char* path);
+
+/*
+ * Funkcija: radixSortGetProfile / radixSortSetProfile / radixSortDefaultProfile
+ *
+ * Čita aktivan profil, postavlja ga, odnosno vraća ugrađene vrednosti
+ * (ono što važi bez datoteke profila). Posle radixSortSetProfile
+ * automatsko učitavanje datoteke se više ne radi.
+ *
+ * Povratna vrednost (radixSortSetProfile):
+ *   SORT_SUCCESS        - profil je primenjen
+ *   SORT_ERROR_NULL     - profile je NULL
+ *   SORT_ERROR_ARGUMENT - smallSortThreshold > 512, wideDigitMinSize >
+ *                         wideDigitMaxSize (za wideDigitMaxSize > 0) ili
+ *                         prag po thread-u manji od 1024
+ */
+void radixSortGetProfile(SortProfile* profile);
+SortResult radixSortSetProfile(const SortProfile* profile);
+void radixSortDefaultProfile(SortProfile* profile);
+
+/*
+ * Funkcija: radixSortReleaseThreadCache / radixSortThreadCacheBytes
+ *
+ * Sa config.threadCacheBytes > 0 svaki thread čuva do 3 pomoćna bafera
+ * između poziva, pa ponovljeno sortiranje iz istog thread-a ne ide na
+ * malloc i ne dobija sveže (nemapirane) stranice. Baferi do
+ * threadCacheBytes bajtova se uzimaju iz keša, veći se alociraju kao
+ * ranije. Keš raste do najvećeg zahteva; posle svakih 64 alokacija
+ * oslobađaju se baferi veći od dvostrukog najvećeg zahteva u tom
+ * prozoru. Keš pripada thread-u, pa nema zaključavanja.
+ *
+ * radixSortReleaseThreadCache oslobađa keš tekućeg thread-a (npr. pre
+ * gašenja thread-a ili posle jednog izuzetno velikog niza).
+ * radixSortThreadCacheBytes vraća koliko bajtova keš tekućeg thread-a
+ * trenutno drži.
+ *
+ * Napomena:
+ *   - Sa POSIX thread-ovima keš se oslobađa i sam, na kraju thread-a
+ *   - Baferi RadixSortContext-a ne idu kroz keš
+ *   - Memorija po thread-u je najviše 3 * threadCacheBytes
+ */
+void radixSortReleaseThreadCache(void);
+size_t radixSortThreadCacheBytes(void);
+
+/*
+ * Funkcija: radixSortGetStats
+ *
+ * Popunjava stats podacima o poslednjem pozivu sortiranja
+ * iz tekućeg thread-a (veličina scratch bafera, vrsta stranica,
+ * broj thread-ova i NUMA čvorova).
+ */
+void radixSortGetStats(SortStats* stats);
+
+/*
+ * Funkcija: getPageKindString / getStrategyString
+ *
+ * Vraćaju string opis vrste stranica, odnosno strategije iz SortStats.
+ */
+const char* getPageKindString(SortPageKind pages);
+const char* getStrategyString(SortStrategy strategy);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* RADIX_SORT_H */
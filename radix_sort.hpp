@@ -0,0 +1,570 @@
+/*
+ * ============================================================================
+ * HEADER: radix_sort.hpp
+ * OPIS: Header-only C++ interfejs za Radix Sort modul (C++20)
+ * ============================================================================
+ *
+ * lightning::radix_sort sortira niz proizvoljnih elemenata po ključu koji
+ * vraća key_fn. Tip ključa je poznat u vreme prevođenja, pa se odatle
+ * određuju broj 32-bitnih reči ključa, transformacija znaka i smer
+ * sortiranja (if constexpr, bez virtuelnih poziva i bez pokazivača na
+ * funkcije). Iz sizeof(T) se u vreme prevođenja bira i kernel (4 bajta
+ * radixSort, 8 bajtova radixSortKeysN, ostalo radixSortColumns), a broj
+ * prolaza i širinu cifre svaki kernel određuje sam u vreme izvršavanja
+ * (cifre od 8 bita, bajtovi isti za sve ključeve se preskaču). Samo
+ * sortiranje rade funkcije C biblioteke:
+ *
+ *   - identitet nad int32_t / uint32_t: radixSort direktno nad nizom
+ *     (uint32_t i opadajući redosled kroz transformaciju u mestu)
+ *   - identitet nad ostalim ključevima od 4 bajta (float, enum, ...):
+ *     transformisana kopija u int32_t baferu + radixSort + povratak
+ *   - identitet nad ključevima od 8 bajtova (int64_t, uint64_t, double):
+ *     big-endian zapis u mestu + radixSortKeysN + povratak
+ *   - sve ostalo: ključevi u kolonama od po 32 bita, radixSortColumns
+ *     daje stabilnu permutaciju, elementi se po njoj premeštaju kroz
+ *     scratch (move konstrukcija, zatim move dodela nazad)
+ *
+ * Prevođenje: -std=c++20, linkovati sa libradixsort.a i -pthread.
+ *
+ * ============================================================================
+ */
+
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "radix_sort.h"
+
+namespace lightning
+{
+
+enum class order
+{
+	ascending,
+	descending
+};
+
+/*
+ * Tipovi koji mogu biti ključ: celi brojevi (i bool), float, double, enum
+ */
+template <typename K>
+concept radix_key = std::integral<K> || std::same_as<K, float> || std::same_as<K, double> || std::is_enum_v<K>;
+
+namespace detail
+{
+
+template <typename K>
+struct bits_of;
+
+template <std::integral K>
+struct bits_of<K>
+{
+	using type = std::make_unsigned_t<K>;
+};
+
+template <>
+struct bits_of<bool>
+{
+	using type = std::uint8_t;
+};
+
+template <>
+struct bits_of<float>
+{
+	using type = std::uint32_t;
+};
+
+template <>
+struct bits_of<double>
+{
+	using type = std::uint64_t;
+};
+
+template <typename K>
+	requires std::is_enum_v<K>
+struct bits_of<K>
+{
+	using type = typename bits_of<std::underlying_type_t<K>>::type;
+};
+
+template <typename K>
+constexpr bool is_signed_key() noexcept
+{
+	if constexpr (std::is_enum_v<K>)
+	{
+		return std::is_signed_v<std::underlying_type_t<K>>;
+	}
+	else
+	{
+		return std::is_signed_v<K>; /* i za float / double */
+	}
+}
+
+} /* namespace detail */
+
+/*
+ * Struktura: key_traits
+ *
+ * Sve što sortiranje zna o tipu ključa K, izračunato u vreme prevođenja.
+ * ordered() preslikava ključ u neoznačene bitove istog poretka:
+ *   - neoznačeni celi brojevi: bez promene
+ *   - označeni: obrnut bit znaka
+ *   - float / double: negativni se invertuju ceo, pozitivnim se postavlja
+ *     bit znaka (-0.0 ide pre +0.0, NaN po bitovima na krajeve)
+ * restore() je inverzno preslikavanje. ordered_bits() / restore_bits() rade
+ * isto nad bitovima ključa, bez učitavanja vrednosti: float / double tako
+ * ne prolaze kroz registar za pokretni zarez (x87 može da utiša signalni
+ * NaN), pa se niz vraća bit po bit isti.
+ */
+template <radix_key K>
+struct key_traits
+{
+	using bits_type = typename detail::bits_of<K>::type;
+
+	static constexpr std::size_t bytes = sizeof(K);
+	static constexpr std::size_t words = (bytes + 3U) / 4U; /* kolone za radixSortColumns */
+	static constexpr bool is_signed = detail::is_signed_key<K>();
+
+	static constexpr bits_type sign_bit = static_cast<bits_type>(bits_type{1} << ((bytes * 8U) - 1U));
+
+	[[nodiscard]] static constexpr bits_type ordered(K key) noexcept
+	{
+		if constexpr (std::is_same_v<K, bool>)
+		{
+			return static_cast<bits_type>(key ? 1U : 0U);
+		}
+		else if constexpr (std::is_enum_v<K>)
+		{
+			return key_traits<std::underlying_type_t<K>>::ordered(static_cast<std::underlying_type_t<K>>(key));
+		}
+		else if constexpr (std::is_floating_point_v<K>)
+		{
+			const bits_type raw = std::bit_cast<bits_type>(key);
+			return ((raw & sign_bit) != 0U) ? static_cast<bits_type>(~raw) : static_cast<bits_type>(raw | sign_bit);
+		}
+		else if constexpr (is_signed)
+		{
+			return static_cast<bits_type>(static_cast<bits_type>(key) ^ sign_bit);
+		}
+		else
+		{
+			return key;
+		}
+	}
+
+	/* ordered() nad bitovima ključa (ne za bool) */
+	[[nodiscard]] static constexpr bits_type ordered_bits(bits_type raw) noexcept
+	{
+		if constexpr (std::is_floating_point_v<K>)
+		{
+			return ((raw & sign_bit) != 0U) ? static_cast<bits_type>(~raw) : static_cast<bits_type>(raw | sign_bit);
+		}
+		else if constexpr (is_signed)
+		{
+			return static_cast<bits_type>(raw ^ sign_bit);
+		}
+		else
+		{
+			return raw;
+		}
+	}
+
+	/* restore() koji vraća bitove ključa (ne za bool) */
+	[[nodiscard]] static constexpr bits_type restore_bits(bits_type bits) noexcept
+	{
+		if constexpr (std::is_floating_point_v<K>)
+		{
+			return ((bits & sign_bit) != 0U) ? static_cast<bits_type>(bits ^ sign_bit) : static_cast<bits_type>(~bits);
+		}
+		else if constexpr (is_signed)
+		{
+			return static_cast<bits_type>(bits ^ sign_bit);
+		}
+		else
+		{
+			return bits;
+		}
+	}
+
+	[[nodiscard]] static constexpr K restore(bits_type bits) noexcept
+	{
+		if constexpr (std::is_same_v<K, bool>)
+		{
+			return bits != 0U;
+		}
+		else if constexpr (std::is_enum_v<K>)
+		{
+			return static_cast<K>(key_traits<std::underlying_type_t<K>>::restore(bits));
+		}
+		else if constexpr (std::is_floating_point_v<K>)
+		{
+			return std::bit_cast<K>(((bits & sign_bit) != 0U) ? static_cast<bits_type>(bits ^ sign_bit) : static_cast<bits_type>(~bits));
+		}
+		else if constexpr (is_signed)
+		{
+			return static_cast<K>(static_cast<bits_type>(bits ^ sign_bit));
+		}
+		else
+		{
+			return bits;
+		}
+	}
+
+	/* ordered() za zadati smer: opadajući je komplement rastućeg */
+	template <order Order>
+	[[nodiscard]] static constexpr bits_type encode(K key) noexcept
+	{
+		if constexpr (Order == order::descending)
+		{
+			return static_cast<bits_type>(~ordered(key));
+		}
+		else
+		{
+			return ordered(key);
+		}
+	}
+
+	template <order Order>
+	[[nodiscard]] static constexpr K decode(bits_type bits) noexcept
+	{
+		if constexpr (Order == order::descending)
+		{
+			return restore(static_cast<bits_type>(~bits));
+		}
+		else
+		{
+			return restore(bits);
+		}
+	}
+
+	/* encode() / decode() nad bitovima ključa */
+	template <order Order>
+	[[nodiscard]] static constexpr bits_type encode_bits(bits_type raw) noexcept
+	{
+		const bits_type bits = ordered_bits(raw);
+		return (Order == order::descending) ? static_cast<bits_type>(~bits) : bits;
+	}
+
+	template <order Order>
+	[[nodiscard]] static constexpr bits_type decode_bits(bits_type bits) noexcept
+	{
+		return restore_bits((Order == order::descending) ? static_cast<bits_type>(~bits) : bits);
+	}
+};
+
+namespace detail
+{
+
+template <typename T, typename KeyFn>
+using key_type = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const T&>>;
+
+/*
+ * Neinicijalizovan bafer za count objekata tipa T; nullptr kada alokacija
+ * ne uspe (greške se vraćaju kao SortResult, ne kao izuzeci)
+ */
+template <typename T>
+class scratch_buffer
+{
+public:
+	explicit scratch_buffer(std::size_t count) noexcept
+		: m_data((count > (std::numeric_limits<std::size_t>::max() / sizeof(T))) ? nullptr :
+			static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{alignof(T)}, std::nothrow)))
+	{
+	}
+
+	~scratch_buffer()
+	{
+		::operator delete(m_data, std::align_val_t{alignof(T)});
+	}
+
+	scratch_buffer(const scratch_buffer&) = delete;
+	scratch_buffer& operator=(const scratch_buffer&) = delete;
+
+	[[nodiscard]] T* get() const noexcept
+	{
+		return m_data;
+	}
+
+private:
+	T* m_data;
+};
+
+/* 32-bitna reč w (0 = najznačajnija) kao int32_t istog poretka */
+template <typename Bits, std::size_t Words>
+[[nodiscard]] constexpr std::int32_t word_of(Bits bits, std::size_t w) noexcept
+{
+	if constexpr (sizeof(Bits) < 4U)
+	{
+		(void)w;
+		return static_cast<std::int32_t>(bits); /* uži ključ je nenegativan int32_t */
+	}
+	else
+	{
+		const std::uint32_t word = static_cast<std::uint32_t>(bits >> (32U * (Words - 1U - w)));
+		return std::bit_cast<std::int32_t>(word ^ 0x80000000U);
+	}
+}
+
+template <typename T>
+inline constexpr bool aliases_int32 = std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::uint32_t>;
+
+/* Bitovi elementa i upis bitova nazad, bez učitavanja vrednosti tipa T */
+template <typename T>
+[[nodiscard]] typename key_traits<T>::bits_type load_bits(const T* element) noexcept
+{
+	typename key_traits<T>::bits_type bits;
+	std::memcpy(&bits, element, sizeof(T));
+	return bits;
+}
+
+template <typename T>
+void store_bits(T* element, typename key_traits<T>::bits_type bits) noexcept
+{
+	std::memcpy(element, &bits, sizeof(T));
+}
+
+/*
+ * Ključ je ceo element od 4 bajta: niz se pretvara u int32_t istog poretka,
+ * sortira sa radixSort i vraća nazad. int32_t i uint32_t se pretvaraju u
+ * mestu (smeju da se čitaju kao int32_t), ostali tipovi preko kopije.
+ */
+template <order Order, typename T>
+[[nodiscard]] SortResult sort_identity32(T* data, std::size_t n) noexcept
+{
+	using traits = key_traits<T>;
+
+	if constexpr (std::is_same_v<T, std::int32_t> && (Order == order::ascending))
+	{
+		return radixSort(data, n);
+	}
+	else if constexpr (aliases_int32<T>)
+	{
+		std::int32_t* words = reinterpret_cast<std::int32_t*>(data);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			words[i] = word_of<std::uint32_t, 1U>(traits::template encode<Order>(data[i]), 0U);
+		}
+		const SortResult result = radixSort(words, n);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			data[i] = traits::template decode<Order>(std::bit_cast<std::uint32_t>(words[i]) ^ 0x80000000U);
+		}
+		return result;
+	}
+	else
+	{
+		scratch_buffer<std::int32_t> words(n);
+		if (words.get() == nullptr)
+		{
+			return SORT_ERROR_MEMORY;
+		}
+		for (std::size_t i = 0; i < n; i++)
+		{
+			words.get()[i] = word_of<std::uint32_t, 1U>(traits::template encode_bits<Order>(load_bits(data + i)), 0U);
+		}
+		const SortResult result = radixSort(words.get(), n);
+		if (result == SORT_SUCCESS)
+		{
+			for (std::size_t i = 0; i < n; i++)
+			{
+				store_bits(data + i, traits::template decode_bits<Order>(std::bit_cast<std::uint32_t>(words.get()[i]) ^ 0x80000000U));
+			}
+		}
+		return result;
+	}
+}
+
+/* Bajtovi reči od najvišeg, kako ih poredi radixSortKeysN */
+[[nodiscard]] constexpr std::uint64_t big_endian(std::uint64_t bits) noexcept
+{
+	if constexpr (std::endian::native == std::endian::big)
+	{
+		return bits;
+	}
+	else
+	{
+		std::uint64_t swapped = 0U;
+		for (std::size_t b = 0; b < 8U; b++)
+		{
+			swapped = (swapped << 8) | ((bits >> (8U * b)) & 0xFFU);
+		}
+		return swapped;
+	}
+}
+
+/*
+ * Ključ je ceo element od 8 bajtova: svaki element se u mestu zamenjuje
+ * big-endian zapisom svog ključa, radixSortKeysN ga sortira kao 8 bajtova
+ * (MSD, bez permutacije i bez kopije), pa se vraća nazad. Isti bitovi su
+ * isti element, pa stabilnost ne može da se vidi. I pri grešci se niz
+ * vraća (sortiranje nije ništa pomerilo). Elementi se čitaju i pišu kao
+ * uint64_t (memcpy), pa double nikad ne prolazi kroz registar za pokretni
+ * zarez.
+ */
+template <order Order, typename T>
+[[nodiscard]] SortResult sort_identity64(T* data, std::size_t n) noexcept
+{
+	using traits = key_traits<T>;
+
+	for (std::size_t i = 0; i < n; i++)
+	{
+		store_bits(data + i, big_endian(traits::template encode_bits<Order>(load_bits(data + i))));
+	}
+	const SortResult result = radixSortKeysN(data, sizeof(T), n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		store_bits(data + i, traits::template decode_bits<Order>(big_endian(load_bits(data + i))));
+	}
+	return result;
+}
+
+/*
+ * Opšti slučaj: key_fn se poziva tačno jednom po elementu, ključevi idu u
+ * key_traits<K>::words kolona, radixSortColumns vraća stabilnu permutaciju,
+ * a elementi se po njoj premeštaju u scratch i nazad.
+ */
+template <order Order, typename T, typename KeyFn>
+[[nodiscard]] SortResult sort_by_permutation(T* data, std::size_t n, KeyFn& key_fn)
+{
+	using K = key_type<T, KeyFn>;
+	using traits = key_traits<K>;
+	constexpr std::size_t words = traits::words;
+
+	if (n > static_cast<std::size_t>(UINT32_MAX))
+	{
+		return SORT_ERROR_SIZE;
+	}
+
+	/* sav scratch pre čitanja ulaza, neuspeh ne ostavlja niz izmenjen */
+	scratch_buffer<std::int32_t> keys(words * n); /* words <= 2, n <= UINT32_MAX */
+	scratch_buffer<std::uint32_t> perm(n);
+	scratch_buffer<T> moved(n);
+	if ((keys.get() == nullptr) || (perm.get() == nullptr) || (moved.get() == nullptr))
+	{
+		return SORT_ERROR_MEMORY;
+	}
+
+	for (std::size_t i = 0; i < n; i++)
+	{
+		const auto bits = traits::template encode<Order>(static_cast<K>(std::invoke(key_fn, std::as_const(data[i]))));
+		for (std::size_t w = 0; w < words; w++)
+		{
+			keys.get()[(w * n) + i] = word_of<typename traits::bits_type, words>(bits, w);
+		}
+	}
+
+	const std::int32_t* cols[words];
+	for (std::size_t w = 0; w < words; w++)
+	{
+		cols[w] = keys.get() + (w * n);
+	}
+
+	const SortResult result = radixSortColumns(cols, words, n, perm.get());
+	if (result != SORT_SUCCESS)
+	{
+		return result;
+	}
+
+	T* buffer = moved.get();
+	for (std::size_t i = 0; i < n; i++)
+	{
+		std::construct_at(buffer + i, std::move(data[perm.get()[i]]));
+	}
+	for (std::size_t i = 0; i < n; i++)
+	{
+		data[i] = std::move(buffer[i]);
+		std::destroy_at(buffer + i);
+	}
+
+	return SORT_SUCCESS;
+}
+
+template <order Order, typename T, typename KeyFn>
+[[nodiscard]] SortResult sort_impl(T* data, std::size_t n, KeyFn& key_fn)
+{
+	static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+		"lightning::radix_sort: elementi se premeštaju kroz scratch, move mora biti noexcept");
+
+	if (n <= 1U)
+	{
+		return SORT_SUCCESS;
+	}
+
+	if constexpr (std::is_same_v<std::remove_cvref_t<KeyFn>, std::identity> && (sizeof(T) == 4U) && radix_key<T>)
+	{
+		return sort_identity32<Order>(data, n);
+	}
+	else if constexpr (std::is_same_v<std::remove_cvref_t<KeyFn>, std::identity> && (sizeof(T) == 8U) && radix_key<T>)
+	{
+		return sort_identity64<Order>(data, n);
+	}
+	else
+	{
+		return sort_by_permutation<Order>(data, n, key_fn);
+	}
+}
+
+} /* namespace detail */
+
+/*
+ * Funkcija: radix_sort
+ *
+ * Stabilno sortira [first, last) po ključu key_fn(element). Podrazumevani
+ * ključ je sam element (std::identity), a redosled rastući; opadajući se
+ * bira parametrom šablona: radix_sort<lightning::order::descending>(...).
+ *
+ * Parametri:
+ *   first, last - contiguous iteratori (std::vector, std::array, niz, ...)
+ *   key_fn      - poziva se kao std::invoke(key_fn, const T&) i vraća
+ *                 radix_key (ceo broj, bool, float, double ili enum);
+ *                 može i pokazivač na član, npr. &Record::id
+ *
+ * Povratna vrednost:
+ *   SORT_SUCCESS (i za prazan niz i niz od jednog elementa),
+ *   SORT_ERROR_SIZE (više od UINT32_MAX elemenata kada ključ nije ceo
+ *   element od 4 ili 8 bajtova), SORT_ERROR_MEMORY
+ *
+ * Napomena:
+ *   - key_fn se poziva jednom po elementu; elementi se ne kopiraju, samo
+ *     premeštaju (dovoljni su move-only tipovi sa noexcept move)
+ *   - Scratch: 4 * words * n + 4 * n + sizeof(T) * n bajtova, plus ono
+ *     što koristi C kernel; za ključ od 4 bajta koji je ceo element samo
+ *     radixSort (i n * 4 bajta za kopiju kada tip nije int32_t/uint32_t),
+ *     a od 8 bajtova samo radixSortKeysN (n * 8 bajtova)
+ *   - Pri grešci niz ostaje nepromenjen
+ */
+template <order Order = order::ascending, std::contiguous_iterator It, typename KeyFn = std::identity>
+	requires std::permutable<It> && radix_key<detail::key_type<std::iter_value_t<It>, KeyFn>>
+[[nodiscard]] SortResult radix_sort(It first, It last, KeyFn key_fn = {})
+{
+	const auto count = last - first;
+	if (count <= 1)
+	{
+		return SORT_SUCCESS;
+	}
+	return detail::sort_impl<Order>(std::to_address(first), static_cast<std::size_t>(count), key_fn);
+}
+
+template <order Order = order::ascending, typename T, std::size_t Extent, typename KeyFn = std::identity>
+	requires (!std::is_const_v<T>) && radix_key<detail::key_type<T, KeyFn>>
+[[nodiscard]] SortResult radix_sort(std::span<T, Extent> range, KeyFn key_fn = {})
+{
+	return detail::sort_impl<Order>(range.data(), range.size(), key_fn);
+}
+
+} /* namespace lightning */
+
+#endif /* RADIX_SORT_HPP */
@@ -0,0 +1,564 @@
+/*
+ * ============================================================================
+ * MODUL: radixsort_module.c
+ * OPIS: CPython ekstenzija (modul radixsort) nad Radix Sort bibliotekom
+ * ============================================================================
+ *
+ * Radi nad bilo kojim objektom koji izvozi C-contiguous bafer (buffer
+ * protocol): numpy.ndarray, array.array, memoryview, bytearray + cast.
+ * Podaci se ne kopiraju ni na ulazu ni na izlazu, sortira se u mestu.
+ * Sortiranje teče bez GIL-a, pa drugi Python thread-ovi rade u međuvremenu.
+ *
+ * Podržani tipovi ključeva (struct format, izvorni redosled bajtova):
+ *     i / I / f           int32, uint32, float32
+ *     l / L / q / Q / d   int64, uint64, float64 (l i L kada su 8 bajtova)
+ *
+ * Funkcije:
+ *     sort(keys)              sortira u mestu
+ *     argsort(keys, out=None) stabilna permutacija; keys se ne menja
+ *     sort_pairs(keys, values) sortira keys i istim redom premešta values
+ *
+ * Višedimenzionalni bafer se sortira kao ravan niz (kao a.ravel()).
+ *
+ * KOMPAJLIRANJE:
+ *     make python        ili  pip install .
+ *
+ * ============================================================================
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "radix_sort.h"
+
+/*
+ * Vrsta ključa iz struct formata bafera
+ */
+typedef enum
+{
+	KEY_SIGNED = 0,
+	KEY_UNSIGNED,
+	KEY_FLOAT
+} KeyKind;
+
+typedef struct
+{
+	KeyKind kind;
+	size_t size; /* 4 ili 8 bajtova */
+} KeyFormat;
+
+static bool parseKeyFormat(const Py_buffer* view, KeyFormat* key);
+static void toSigned32(uint32_t* words, size_t n, KeyKind kind);
+static uint64_t toSigned64(uint64_t raw, KeyKind kind);
+static SortResult sortKeys(void* keys, size_t n, KeyFormat key);
+static size_t columnWords(KeyFormat key);
+static SortResult keyPermutation(const void* keys, size_t n, KeyFormat key, int32_t* columns, uint32_t* perm);
+static PyObject* raiseSortError(SortResult result);
+static bool itemCount(const Py_buffer* view, size_t* n);
+
+/*
+ * Pomoćna funkcija: čita struct format ključa (npr. "i", "<d", "=q").
+ * Prihvata samo izvorni redosled bajtova i tipove od 4 i 8 bajtova,
+ * inače postavlja TypeError.
+ */
+static bool parseKeyFormat(const Py_buffer* view, KeyFormat* key)
+{
+	const char* format = (view->format != NULL) ? view->format : "B";
+
+	if ((format[0] == '@') || (format[0] == '=') || ((format[0] == '<') && (PY_LITTLE_ENDIAN != 0)) ||
+	    ((format[0] == '>') && (PY_LITTLE_ENDIAN == 0)))
+	{
+		format++;
+	}
+
+	bool known = (format[0] != '\0') && (format[1] == '\0');
+	if (known)
+	{
+		switch (format[0])
+		{
+			case 'i': case 'l': case 'q':
+				key->kind = KEY_SIGNED;
+				break;
+			case 'I': case 'L': case 'Q':
+				key->kind = KEY_UNSIGNED;
+				break;
+			case 'f': case 'd':
+				key->kind = KEY_FLOAT;
+				break;
+			default:
+				known = false;
+				break;
+		}
+	}
+	key->size = (size_t)view->itemsize;
+
+	if (!known || ((key->size != 4U) && (key->size != 8U)))
+	{
+		/* Format string za PyErr_Format mora biti ASCII - tekst ide kao argument */
+		PyErr_Format(PyExc_TypeError, "radixsort: %s '%s' (%zd B), %s",
+		             "nepodržan tip ključa", (view->format != NULL) ? view->format : "B", view->itemsize,
+		             "očekivan int32/uint32/float32/int64/uint64/float64");
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Pomoćna funkcija: broj elemenata C-contiguous bafera
+ */
+static bool itemCount(const Py_buffer* view, size_t* n)
+{
+	if ((view->itemsize <= 0) || ((view->len % view->itemsize) != 0))
+	{
+		PyErr_SetString(PyExc_ValueError, "radixsort: neispravna veličina elementa bafera");
+		return false;
+	}
+	*n = (size_t)(view->len / view->itemsize);
+	return true;
+}
+
+/*
+ * Pomoćna funkcija: preslikavanje 32-bitnih ključeva u int32_t istog
+ * poretka. Samo sebi je inverzno, pa isti poziv vraća originalne bitove.
+ *   uint32: obrnut bit znaka
+ *   float:  negativnima se obrću ostali bitovi (veća apsolutna vrednost
+ *           postaje manji int32), pozitivni ostaju
+ */
+static void toSigned32(uint32_t* words, size_t n, KeyKind kind)
+{
+	if (kind == KEY_UNSIGNED)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			words[i] ^= 0x80000000U;
+		}
+	}
+	else if (kind == KEY_FLOAT)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			words[i] ^= ((words[i] & 0x80000000U) != 0U) ? 0x7FFFFFFFU : 0U;
+		}
+	}
+	else
+	{
+		/* int32 je već u traženom poretku */
+	}
+}
+
+/*
+ * Pomoćna funkcija: isto preslikavanje za 64-bitne ključeve (int64 poredak)
+ */
+static uint64_t toSigned64(uint64_t raw, KeyKind kind)
+{
+	if (kind == KEY_UNSIGNED)
+	{
+		return raw ^ 0x8000000000000000ULL;
+	}
+	if (kind == KEY_FLOAT)
+	{
+		return raw ^ (((raw & 0x8000000000000000ULL) != 0U) ? 0x7FFFFFFFFFFFFFFFULL : 0U);
+	}
+	return raw;
+}
+
+/*
+ * Pomoćna funkcija: sortiranje ključeva u mestu.
+ *
+ * 4 bajta: preslikavanje u int32_t poredak, radixSort, povratak.
+ * 8 bajtova: svaki element se u mestu prepiše u par int32_t reči (niža
+ * reč na pomeraju 0, viša na 4), pa dva stabilna radixSortRecords prolaza
+ * (LSD: prvo po nižoj, zatim po višoj reči) i povratak. Pri grešci su
+ * elementi isti, ali mogu biti delimično premešteni.
+ */
+static SortResult sortKeys(void* keys, size_t n, KeyFormat key)
+{
+	SortResult result;
+
+	if (key.size == 4U)
+	{
+		uint32_t* words = (uint32_t*)keys;
+		toSigned32(words, n, key.kind);
+		result = radixSort((int32_t*)keys, n);
+		toSigned32(words, n, key.kind);
+		return result;
+	}
+
+	uint32_t* pairs = (uint32_t*)keys;
+	for (size_t i = 0; i < n; i++)
+	{
+		uint64_t raw;
+		(void)memcpy(&raw, &pairs[2U * i], sizeof(raw));
+		uint64_t ordered = toSigned64(raw, key.kind);
+		pairs[2U * i] = (uint32_t)ordered ^ 0x80000000U; /* niža reč je neoznačena */
+		pairs[(2U * i) + 1U] = (uint32_t)(ordered >> 32);
+	}
+
+	result = radixSortRecords(keys, n, 8U, 0U);
+	if (result == SORT_SUCCESS)
+	{
+		result = radixSortRecords(keys, n, 8U, 4U);
+	}
+
+	for (size_t i = 0; i < n; i++)
+	{
+		uint64_t ordered = ((uint64_t)pairs[(2U * i) + 1U] << 32) | (uint64_t)(pairs[2U * i] ^ 0x80000000U);
+		uint64_t raw = toSigned64(ordered, key.kind);
+		(void)memcpy(&pairs[2U * i], &raw, sizeof(raw));
+	}
+	return result;
+}
+
+/*
+ * Pomoćna funkcija: koliko int32_t reči po elementu treba za kolone
+ * ključa (int32 se čita direktno iz bafera)
+ */
+static size_t columnWords(KeyFormat key)
+{
+	if (key.size == 8U)
+	{
+		return 2U;
+	}
+	return (key.kind == KEY_SIGNED) ? 0U : 1U;
+}
+
+/*
+ * Pomoćna funkcija: stabilna permutacija ključeva preko radixSortColumns.
+ * columns ima columnWords(key) * n reči; keys se ne menja.
+ */
+static SortResult keyPermutation(const void* keys, size_t n, KeyFormat key, int32_t* columns, uint32_t* perm)
+{
+	const int32_t* cols[2];
+	size_t numCols = 1U;
+
+	if (key.size == 4U)
+	{
+		if (key.kind == KEY_SIGNED)
+		{
+			cols[0] = (const int32_t*)keys;
+		}
+		else
+		{
+			(void)memcpy(columns, keys, n * sizeof(int32_t));
+			toSigned32((uint32_t*)columns, n, key.kind);
+			cols[0] = columns;
+		}
+	}
+	else
+	{
+		const uint8_t* bytes = (const uint8_t*)keys;
+		int32_t* high = columns;
+		int32_t* low = columns + n;
+		for (size_t i = 0; i < n; i++)
+		{
+			uint64_t raw;
+			(void)memcpy(&raw, bytes + (8U * i), sizeof(raw));
+			uint64_t ordered = toSigned64(raw, key.kind);
+			high[i] = (int32_t)(uint32_t)(ordered >> 32);
+			low[i] = (int32_t)((uint32_t)ordered ^ 0x80000000U);
+		}
+		cols[0] = high;
+		cols[1] = low;
+		numCols = 2U;
+	}
+
+	return radixSortColumns(cols, numCols, n, perm);
+}
+
+/*
+ * Pomoćna funkcija: SortResult -> Python izuzetak
+ */
+static PyObject* raiseSortError(SortResult result)
+{
+	if (result == SORT_ERROR_MEMORY)
+	{
+		return PyErr_NoMemory();
+	}
+	PyErr_Format(PyExc_ValueError, "radixsort: %s", getSortResultString(result));
+	return NULL;
+}
+
+/*
+ * sort(keys) -> None
+ */
+static PyObject* radixsortSort(PyObject* self, PyObject* args)
+{
+	(void)self;
+	PyObject* object;
+	Py_buffer view;
+	KeyFormat key;
+	size_t n;
+
+	if (!PyArg_ParseTuple(args, "O:sort", &object))
+	{
+		return NULL;
+	}
+	if (PyObject_GetBuffer(object, &view, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0)
+	{
+		return NULL;
+	}
+	if (!parseKeyFormat(&view, &key) || !itemCount(&view, &n))
+	{
+		PyBuffer_Release(&view);
+		return NULL;
+	}
+
+	SortResult result = SORT_SUCCESS;
+	if (n > 1U)
+	{
+		Py_BEGIN_ALLOW_THREADS
+		result = sortKeys(view.buf, n, key);
+		Py_END_ALLOW_THREADS
+	}
+	PyBuffer_Release(&view);
+
+	if (result != SORT_SUCCESS)
+	{
+		return raiseSortError(result);
+	}
+	Py_RETURN_NONE;
+}
+
+/*
+ * argsort(keys, out=None) -> out
+ *
+ * out je upisiv bafer od n celih brojeva (int32/uint32/int64/uint64);
+ * bez njega se vraća memoryview formata 'q' nad novim bytearray-jem
+ * (numpy.asarray ga pretvara bez kopiranja).
+ */
+static PyObject* radixsortArgsort(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+	(void)self;
+	static char* keywords[] = { "keys", "out", NULL };
+	PyObject* keysObject;
+	PyObject* outObject = Py_None;
+	Py_buffer keys;
+	Py_buffer out;
+	KeyFormat key;
+	KeyFormat index;
+	size_t n;
+	size_t outCount;
+	PyObject* created = NULL;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O:argsort", keywords, &keysObject, &outObject))
+	{
+		return NULL;
+	}
+	if (PyObject_GetBuffer(keysObject, &keys, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0)
+	{
+		return NULL;
+	}
+	if (!parseKeyFormat(&keys, &key) || !itemCount(&keys, &n))
+	{
+		PyBuffer_Release(&keys);
+		return NULL;
+	}
+	if (n > (size_t)UINT32_MAX)
+	{
+		PyBuffer_Release(&keys);
+		PyErr_SetString(PyExc_OverflowError, "radixsort.argsort: najviše 2^32 - 1 elemenata");
+		return NULL;
+	}
+
+	if (outObject == Py_None)
+	{
+		PyObject* bytes = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t)(n * sizeof(int64_t)));
+		PyObject* view = (bytes != NULL) ? PyMemoryView_FromObject(bytes) : NULL;
+		created = (view != NULL) ? PyObject_CallMethod(view, "cast", "s", "q") : NULL;
+		Py_XDECREF(view);
+		Py_XDECREF(bytes);
+		if (created == NULL)
+		{
+			PyBuffer_Release(&keys);
+			return NULL;
+		}
+		outObject = created;
+	}
+
+	if (PyObject_GetBuffer(outObject, &out, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0)
+	{
+		Py_XDECREF(created);
+		PyBuffer_Release(&keys);
+		return NULL;
+	}
+	bool valid = parseKeyFormat(&out, &index) && itemCount(&out, &outCount);
+	if (valid && ((index.kind == KEY_FLOAT) || (outCount != n) ||
+	              ((index.kind == KEY_SIGNED) && (index.size == 4U) && (n > (size_t)INT32_MAX))))
+	{
+		PyErr_SetString(PyExc_ValueError, "radixsort.argsort: out mora biti celobrojni bafer od len(keys) elemenata");
+		valid = false;
+	}
+	if (!valid)
+	{
+		PyBuffer_Release(&out);
+		Py_XDECREF(created);
+		PyBuffer_Release(&keys);
+		return NULL;
+	}
+
+	SortResult result = SORT_SUCCESS;
+	if (n > 0U)
+	{
+		Py_BEGIN_ALLOW_THREADS
+		/* sav scratch pre čitanja ulaza; 4-bajtni out prima permutaciju direktno */
+		size_t words = columnWords(key);
+		int32_t* columns = (words > 0U) ? (int32_t*)malloc(words * n * sizeof(int32_t)) : NULL;
+		uint32_t* perm = (index.size == 4U) ? (uint32_t*)out.buf : (uint32_t*)malloc(n * sizeof(uint32_t));
+		if (((words > 0U) && (columns == NULL)) || (perm == NULL))
+		{
+			result = SORT_ERROR_MEMORY;
+		}
+		else
+		{
+			result = keyPermutation(keys.buf, n, key, columns, perm);
+		}
+		if ((result == SORT_SUCCESS) && (index.size == 8U))
+		{
+			uint64_t* wide = (uint64_t*)out.buf;
+			for (size_t i = n; i > 0U; i--)
+			{
+				wide[i - 1U] = perm[i - 1U];
+			}
+		}
+		if ((perm != NULL) && (index.size == 8U))
+		{
+			free(perm);
+		}
+		free(columns);
+		Py_END_ALLOW_THREADS
+	}
+	PyBuffer_Release(&out);
+	PyBuffer_Release(&keys);
+
+	if (result != SORT_SUCCESS)
+	{
+		Py_XDECREF(created);
+		return raiseSortError(result);
+	}
+	if (created != NULL)
+	{
+		return created;
+	}
+	Py_INCREF(outObject);
+	return outObject;
+}
+
+/*
+ * sort_pairs(keys, values) -> None
+ *
+ * values je bilo koji upisiv C-contiguous bafer sa istim brojem elemenata
+ * (proizvoljne veličine elementa, npr. numpy strukturirani niz).
+ */
+static PyObject* radixsortSortPairs(PyObject* self, PyObject* args)
+{
+	(void)self;
+	PyObject* keysObject;
+	PyObject* valuesObject;
+	Py_buffer keys;
+	Py_buffer values;
+	KeyFormat key;
+	size_t n;
+	size_t valueCount;
+
+	if (!PyArg_ParseTuple(args, "OO:sort_pairs", &keysObject, &valuesObject))
+	{
+		return NULL;
+	}
+	if (PyObject_GetBuffer(keysObject, &keys, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) != 0)
+	{
+		return NULL;
+	}
+	if (PyObject_GetBuffer(valuesObject, &values, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) != 0)
+	{
+		PyBuffer_Release(&keys);
+		return NULL;
+	}
+	bool valid = parseKeyFormat(&keys, &key) && itemCount(&keys, &n) && itemCount(&values, &valueCount);
+	if (valid && (valueCount != n))
+	{
+		PyErr_SetString(PyExc_ValueError, "radixsort.sort_pairs: keys i values moraju imati isti broj elemenata");
+		valid = false;
+	}
+	if (valid && (n > (size_t)UINT32_MAX))
+	{
+		PyErr_SetString(PyExc_OverflowError, "radixsort.sort_pairs: najviše 2^32 - 1 elemenata");
+		valid = false;
+	}
+	if (!valid)
+	{
+		PyBuffer_Release(&values);
+		PyBuffer_Release(&keys);
+		return NULL;
+	}
+
+	SortResult result = SORT_SUCCESS;
+	if (n > 1U)
+	{
+		size_t valueSize = (size_t)values.itemsize;
+		Py_BEGIN_ALLOW_THREADS
+		size_t words = columnWords(key);
+		size_t moveSize = (valueSize > key.size) ? valueSize : key.size;
+		int32_t* columns = (words > 0U) ? (int32_t*)malloc(words * n * sizeof(int32_t)) : NULL;
+		uint32_t* perm = (uint32_t*)malloc(n * sizeof(uint32_t));
+		void* moved = (moveSize <= (SIZE_MAX / n)) ? malloc(moveSize * n) : NULL;
+		if (((words > 0U) && (columns == NULL)) || (perm == NULL) || (moved == NULL))
+		{
+			result = SORT_ERROR_MEMORY;
+		}
+		else
+		{
+			result = keyPermutation(keys.buf, n, key, columns, perm);
+		}
+		if (result == SORT_SUCCESS)
+		{
+			(void)radixGather(values.buf, valueSize, n, perm, moved);
+			(void)memcpy(values.buf, moved, valueSize * n);
+			(void)radixGather(keys.buf, key.size, n, perm, moved);
+			(void)memcpy(keys.buf, moved, key.size * n);
+		}
+		free(moved);
+		free(perm);
+		free(columns);
+		Py_END_ALLOW_THREADS
+	}
+	PyBuffer_Release(&values);
+	PyBuffer_Release(&keys);
+
+	if (result != SORT_SUCCESS)
+	{
+		return raiseSortError(result);
+	}
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef g_methods[] =
+{
+	{ "sort", radixsortSort, METH_VARARGS,
+	  "sort(keys)\n\nSortira bafer (int32/uint32/float32/int64/uint64/float64) u mestu, bez GIL-a." },
+	{ "argsort", (PyCFunction)(void (*)(void))radixsortArgsort, METH_VARARGS | METH_KEYWORDS,
+	  "argsort(keys, out=None)\n\nStabilna permutacija koja sortira keys; keys se ne menja.\n"
+	  "out: celobrojni bafer od len(keys) elemenata, inače novi memoryview formata 'q'." },
+	{ "sort_pairs", radixsortSortPairs, METH_VARARGS,
+	  "sort_pairs(keys, values)\n\nStabilno sortira keys u mestu i istim redom premešta values." },
+	{ NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef g_module =
+{
+	PyModuleDef_HEAD_INIT,
+	"radixsort",
+	"Radix sort nad baferima (buffer protocol), u mestu i bez GIL-a.",
+	-1,
+	g_methods,
+	NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit_radixsort(void)
+{
+	return PyModule_Create(&g_module);
+}
@@ -0,0 +1,384 @@
+/*
+ * ============================================================================
+ * PROGRAM: radixsort_tune.c
+ * OPIS: Merenje pragova strategija na tekućoj mašini i upis profila
+ * ============================================================================
+ *
+ * Za svaki prag iz SortProfile meri sortiranje sa putanjom uključenom i
+ * isključenom na nizu veličina i bira prelaz:
+ *
+ *     small_sort_threshold      do koje veličine insertion sort pobeđuje
+ *     wide_digit_min/max_size   opseg veličina u kome 3 prolaza sa 11-bitnim
+ *                               ciframa pobeđuju 4 prolaza po bajtu
+ *     write_combine_min_size    od koje veličine rasipanje kroz bafere po
+ *                               bucket-u pobeđuje direktno rasipanje
+ *     cache_blocked_min_size    od koje veličine pobeđuje keš-blokirana
+ *                               varijanta
+ *     parallel_min_per_thread   od koliko elemenata po thread-u
+ *     pool_min_per_thread       radixSortParallel, odnosno radixSortWithContext
+ *                               pobeđuju radixSort (samo sa više CPU-ova)
+ *
+ * Ključevi su slučajni preko celog int32_t opsega (sva 4 bajta se menjaju).
+ * Vreme je medijana ponavljanja u ns po elementu; mali nizovi se mere u
+ * seriji da merenje ne bude kraće od rezolucije sata. Putanja se uključuje
+ * tek kada je brža bar za TUNE_MARGIN, a prag "od veličine" važi samo ako
+ * putanja pobeđuje i na svim većim izmerenim veličinama.
+ *
+ * Ako keš-blokirana varijanta nigde ne pobeđuje, cache_blocked_min_size
+ * ostaje 0 (prag iz veličine L2); "nikad" (SIZE_MAX) se upisuje samo kada
+ * gubi na svim veličinama, a izmereno je bar do TUNE_NEVER_MIN_SIZE.
+ *
+ * KOMPAJLIRANJE:
+ *     make radixsort_tune
+ *
+ * POKRETANJE:
+ *     make radixsort-tune                (meri i upisuje podrazumevani profil)
+ *     ./radixsort_tune [putanja_profila] [maksimalna_veličina] [broj_ponavljanja]
+ *
+ * Bez putanje (ili sa "-") profil ide tamo odakle ga biblioteka učitava:
+ * RADIXSORT_PROFILE, inače $HOME/.radixsort-profile.
+ *
+ * ============================================================================
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "radix_sort.h"
+
+#define DEFAULT_MAX_SIZE ((size_t)16U * 1024U * 1024U)
+#define DEFAULT_RUNS 5U
+#define MAX_RUNS 64U
+#define MAX_STEPS 16U
+#define TUNE_BATCH_ELEMENTS ((size_t)1U << 18) /* mali nizovi: ovoliko elemenata po merenju */
+#define TUNE_MARGIN 0.03 /* putanja mora biti bar 3% brža */
+#define TUNE_NEVER_MIN_SIZE ((size_t)16U * 1024U * 1024U) /* "nikad" tek ako gubi i ovde (iznad 2 x L2 svuda) */
+
+typedef SortResult (*SortFunction)(int32_t* arr, size_t size);
+
+/*
+ * Izmerena veličina: ns po elementu sa uključenom i isključenom putanjom
+ */
+typedef struct
+{
+	size_t size;
+	double on;
+	double off;
+} Step;
+
+static SortResult sortParallel(int32_t* arr, size_t size);
+static SortResult sortContext(int32_t* arr, size_t size);
+static double timeSort(const SortProfile* profile, SortFunction sort, size_t size);
+static size_t measureSteps(const char* name, const SortProfile* on, const SortProfile* off, SortFunction onSort,
+                           const size_t* sizes, size_t count, Step* steps);
+static bool wins(const Step* step);
+static size_t winningSuffix(const Step* steps, size_t count);
+static void fillRandom(int32_t* arr, size_t size, uint32_t seed);
+static double nowMs(void);
+static double median(double* values, size_t count);
+
+static RadixSortContext* g_context = NULL;
+static int32_t* g_source = NULL; /* slučajan ulaz, isti za sva merenja */
+static int32_t* g_work = NULL;
+static size_t g_maxSize = DEFAULT_MAX_SIZE;
+static size_t g_runs = DEFAULT_RUNS;
+
+static const size_t g_smallSizes[] = { 8U, 16U, 24U, 32U, 48U, 64U, 96U, 128U, 192U, 256U, 384U, 512U };
+static const size_t g_largeSizes[] = { 4096U, 16384U, 65536U, 262144U, 1048576U, 4194304U, 16777216U, 67108864U };
+
+/* Svi dostupni CPU-ovi */
+static SortResult sortParallel(int32_t* arr, size_t size)
+{
+	return radixSortParallel(arr, size, 0U);
+}
+
+static SortResult sortContext(int32_t* arr, size_t size)
+{
+	return radixSortWithContext(g_context, arr, size);
+}
+
+/*
+ * Medijana vremena u ns po elementu, sa datim profilom
+ *
+ * Ulaz se pre svakog ponavljanja kopira iz g_source, kopija se ne meri.
+ */
+static double timeSort(const SortProfile* profile, SortFunction sort, size_t size)
+{
+	size_t batch = (size < TUNE_BATCH_ELEMENTS) ? (TUNE_BATCH_ELEMENTS / size) : 1U;
+	double times[MAX_RUNS];
+
+	(void)radixSortSetProfile(profile);
+	for (size_t r = 0; r < g_runs; r++)
+	{
+		(void)memcpy(g_work, g_source, batch * size * sizeof(int32_t));
+
+		double start = nowMs();
+		for (size_t b = 0; b < batch; b++)
+		{
+			(void)sort(&g_work[b * size], size);
+		}
+		times[r] = ((nowMs() - start) * 1000000.0) / (double)(batch * size);
+	}
+
+	return median(times, g_runs);
+}
+
+/*
+ * Meri sve veličine do g_maxSize sa profilima on i off i ispisuje red po
+ * veličini. Vraća broj izmerenih veličina.
+ */
+static size_t measureSteps(const char* name, const SortProfile* on, const SortProfile* off, SortFunction onSort,
+                           const size_t* sizes, size_t count, Step* steps)
+{
+	size_t measured = 0;
+
+	for (size_t s = 0; (s < count) && (sizes[s] <= g_maxSize); s++)
+	{
+		steps[measured].size = sizes[s];
+		steps[measured].on = timeSort(on, onSort, sizes[s]);
+		steps[measured].off = timeSort(off, radixSort, sizes[s]);
+		printf("%-24s %12zu %12.2f %12.2f  %s\n", name, sizes[s], steps[measured].on, steps[measured].off,
+		       wins(&steps[measured]) ? "da" : "ne");
+		measured++;
+	}
+
+	return measured;
+}
+
+static bool wins(const Step* step)
+{
+	return step->on < (step->off * (1.0 - TUNE_MARGIN));
+}
+
+/* Index prve veličine od koje putanja pobeđuje na svim većim, count ako je nema */
+static size_t winningSuffix(const Step* steps, size_t count)
+{
+	size_t first = count;
+	while ((first > 0U) && wins(&steps[first - 1U]))
+	{
+		first--;
+	}
+	return first;
+}
+
+/*
+ * Generator ulaza: xorshift32, nezavisan od rand() i RAND_MAX platforme
+ */
+static void fillRandom(int32_t* arr, size_t size, uint32_t seed)
+{
+	uint32_t state = (seed == 0U) ? 0x9E3779B9U : seed;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		arr[i] = (int32_t)state;
+	}
+}
+
+static double nowMs(void)
+{
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((double)ts.tv_sec * 1000.0) + ((double)ts.tv_nsec / 1000000.0);
+}
+
+/* Medijana malog niza - insertion sort je dovoljan za <= MAX_RUNS vrednosti */
+static double median(double* values, size_t count)
+{
+	for (size_t i = 1; i < count; i++)
+	{
+		double key = values[i];
+		size_t j = i;
+		while ((j > 0U) && (values[j - 1U] > key))
+		{
+			values[j] = values[j - 1U];
+			j--;
+		}
+		values[j] = key;
+	}
+	return values[count / 2U];
+}
+
+int main(int argc, char** argv)
+{
+	const char* path = NULL;
+
+	if ((argc > 1) && (strcmp(argv[1], "-") != 0))
+	{
+		path = argv[1];
+	}
+	if (argc > 2)
+	{
+		g_maxSize = (size_t)strtoull(argv[2], NULL, 10);
+	}
+	if (argc > 3)
+	{
+		g_runs = (size_t)strtoull(argv[3], NULL, 10);
+	}
+	if ((g_runs == 0U) || (g_runs > MAX_RUNS))
+	{
+		g_runs = DEFAULT_RUNS;
+	}
+	if (g_maxSize < TUNE_BATCH_ELEMENTS)
+	{
+		g_maxSize = TUNE_BATCH_ELEMENTS;
+	}
+
+	g_source = (int32_t*)malloc(g_maxSize * sizeof(int32_t));
+	g_work = (int32_t*)malloc(g_maxSize * sizeof(int32_t));
+	if ((g_source == NULL) || (g_work == NULL))
+	{
+		printf("Greška: Neuspela alokacija %zu elemenata\n", g_maxSize);
+		free(g_source);
+		free(g_work);
+		return 1;
+	}
+	fillRandom(g_source, g_maxSize, 49U);
+
+	/* Merenje kreće od ugrađenih vrednosti, ne od postojećeg profila */
+	SortProfile profile;
+	radixSortDefaultProfile(&profile);
+	(void)radixSortSetProfile(&profile);
+
+	printf("%-24s %12s %12s %12s  %s\n", "prag", "veličina", "sa ns/el", "bez ns/el", "pobeđuje");
+
+	Step steps[MAX_STEPS];
+	const size_t numSmall = sizeof(g_smallSizes) / sizeof(g_smallSizes[0]);
+	const size_t numLarge = sizeof(g_largeSizes) / sizeof(g_largeSizes[0]);
+
+	/* 1. Insertion sort: do prve veličine na kojoj gubi */
+	SortProfile on = profile;
+	SortProfile off = profile;
+	on.smallSortThreshold = g_smallSizes[numSmall - 1U];
+	off.smallSortThreshold = 0U;
+	size_t count = measureSteps("small_sort_threshold", &on, &off, radixSort, g_smallSizes, numSmall, steps);
+	profile.smallSortThreshold = 0U;
+	for (size_t s = 0; (s < count) && wins(&steps[s]); s++)
+	{
+		profile.smallSortThreshold = steps[s].size;
+	}
+
+	/* 2. 11-bitne cifre: najduži neprekinut opseg veličina na kojima pobeđuju (ostale putanje isključene) */
+	on = profile;
+	on.wideDigitMinSize = 0U;
+	on.wideDigitMaxSize = SIZE_MAX;
+	on.cacheBlockedMinSize = SIZE_MAX;
+	off = on;
+	off.wideDigitMaxSize = 0U;
+	count = measureSteps("wide_digit_min/max_size", &on, &off, radixSort, g_largeSizes, numLarge, steps);
+	size_t bestFirst = 0;
+	size_t bestLength = 0;
+	for (size_t s = 0; s < count; s++)
+	{
+		size_t length = 0;
+		while (((s + length) < count) && wins(&steps[s + length]))
+		{
+			length++;
+		}
+		if (length > bestLength)
+		{
+			bestFirst = s;
+			bestLength = length;
+		}
+	}
+	if (bestLength > 0U)
+	{
+		profile.wideDigitMinSize = (bestFirst == 0U) ? 0U : steps[bestFirst].size;
+		profile.wideDigitMaxSize = ((bestFirst + bestLength) == count) ? SIZE_MAX : steps[bestFirst + bestLength - 1U].size;
+	}
+
+	/* 3. Rasipanje kroz bafere po bucket-u: samo LSD po bajtovima */
+	on = profile;
+	on.wideDigitMaxSize = 0U;
+	on.cacheBlockedMinSize = SIZE_MAX;
+	on.writeCombineMinSize = 1U;
+	off = on;
+	off.writeCombineMinSize = 0U;
+	count = measureSteps("write_combine_min_size", &on, &off, radixSort, &g_largeSizes[2], numLarge - 2U, steps);
+	size_t first = winningSuffix(steps, count);
+	profile.writeCombineMinSize = (first < count) ? steps[first].size : 0U;
+
+	/* 4. Keš-blokirana varijanta, sa već izabranim LSD putanjama */
+	on = profile;
+	on.cacheBlockedMinSize = 1U;
+	off = profile;
+	off.cacheBlockedMinSize = SIZE_MAX;
+	count = measureSteps("cache_blocked_min_size", &on, &off, radixSort, &g_largeSizes[3], numLarge - 3U, steps);
+	first = winningSuffix(steps, count);
+	if (first < count)
+	{
+		profile.cacheBlockedMinSize = steps[first].size;
+	}
+	else
+	{
+		/* Bez prelaza ostaje prag iz L2, osim ako izmereno gubi svuda do velikih nizova */
+		size_t won = 0;
+		for (size_t s = 0; s < count; s++)
+		{
+			won += wins(&steps[s]) ? 1U : 0U;
+		}
+		bool neverWins = (count > 0U) && (won == 0U) && (steps[count - 1U].size >= TUNE_NEVER_MIN_SIZE);
+		profile.cacheBlockedMinSize = neverWins ? SIZE_MAX : 0U;
+	}
+
+	/* 5. Paralelno: od koje ukupne veličine svi CPU-ovi pobeđuju jedan */
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t cpus = (online > 0) ? (size_t)online : 1U;
+	if (cpus < 2U)
+	{
+		printf("%-24s jedan CPU - ostaju ugrađene vrednosti\n", "parallel/pool_min");
+	}
+	else
+	{
+		on = profile;
+		on.parallelMinPerThread = 1024U;
+		count = measureSteps("parallel_min_per_thread", &on, &profile, sortParallel, &g_largeSizes[2], numLarge - 2U, steps);
+		first = winningSuffix(steps, count);
+		profile.parallelMinPerThread = (first < count) ? steps[first].size / cpus : SIZE_MAX;
+		profile.parallelMinPerThread = (profile.parallelMinPerThread < 1024U) ? 1024U : profile.parallelMinPerThread;
+
+		if (radixSortContextCreate(&g_context, 0U, 0U) == SORT_SUCCESS)
+		{
+			on = profile;
+			on.poolMinPerThread = 1024U;
+			count = measureSteps("pool_min_per_thread", &on, &profile, sortContext, &g_largeSizes[1], numLarge - 1U, steps);
+			first = winningSuffix(steps, count);
+			profile.poolMinPerThread = (first < count) ? steps[first].size / cpus : SIZE_MAX;
+			profile.poolMinPerThread = (profile.poolMinPerThread < 1024U) ? 1024U : profile.poolMinPerThread;
+			radixSortContextDestroy(g_context);
+		}
+	}
+
+	free(g_source);
+	free(g_work);
+
+	SortResult result = radixSortSetProfile(&profile);
+	if (result == SORT_SUCCESS)
+	{
+		result = radixSortSaveProfile(path);
+	}
+
+	printf("\nsmall_sort_threshold = %zu\nwide_digit_min_size = %zu\nwide_digit_max_size = %zu\n"
+	       "write_combine_min_size = %zu\ncache_blocked_min_size = %zu\n"
+	       "parallel_min_per_thread = %zu\npool_min_per_thread = %zu\n",
+	       profile.smallSortThreshold, profile.wideDigitMinSize, profile.wideDigitMaxSize,
+	       profile.writeCombineMinSize, profile.cacheBlockedMinSize,
+	       profile.parallelMinPerThread, profile.poolMinPerThread);
+
+	if (result != SORT_SUCCESS)
+	{
+		printf("Greška: profil nije upisan (%s)\n", (path != NULL) ? path : "RADIXSORT_PROFILE / $HOME/.radixsort-profile");
+		return 1;
+	}
+	printf("Profil upisan: %s\n", (path != NULL) ? path : "RADIXSORT_PROFILE / $HOME/.radixsort-profile");
+	return 0;
+}
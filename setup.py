@@ -0,0 +1,28 @@
+"""
+============================================================================
+setup.py
+OPIS: Instalacija Python modula radixsort (pip install .)
+============================================================================
+
+Isti izvori kao make python: radixsort_module.c + radix_sort.c u jednoj
+ekstenziji, bez zavisnosti od libradixsort.so.
+
+============================================================================
+"""
+
+from setuptools import Extension, setup
+
+setup(
+    name="radixsort",
+    version="1.0.0",
+    description="Radix sort nad baferima (buffer protocol), u mestu i bez GIL-a",
+    ext_modules=[
+        Extension(
+            "radixsort",
+            sources=["radixsort_module.c", "radix_sort.c"],
+            depends=["radix_sort.h"],
+            extra_compile_args=["-std=c2x", "-O2"],
+            extra_link_args=["-pthread"],
+        )
+    ],
+)
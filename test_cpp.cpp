@@ -0,0 +1,196 @@
+/*
+ * ============================================================================
+ * test_cpp.cpp
+ * OPIS: Testovi za C++ interfejs (radix_sort.hpp)
+ * ============================================================================
+ *
+ * Svaki slučaj se poredi sa std::stable_sort nad istim ulazom.
+ *
+ * KOMPAJLIRANJE:
+ *     g++ -std=c++20 -pedantic -Wall -O2 test_cpp.cpp -L. -lradixsort -pthread -o test_cpp
+ *
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "radix_sort.hpp"
+
+namespace
+{
+
+/*
+ * Zapis sa move-only članom: sortira se po id, payload pamti početni index
+ * radi provere stabilnosti
+ */
+struct Record
+{
+	std::int64_t id;
+	std::unique_ptr<std::size_t> payload;
+};
+
+enum class Level : std::int16_t
+{
+	low = -3,
+	mid = 0,
+	high = 7
+};
+
+bool report(const char* name, bool ok)
+{
+	std::printf("%-44s %s\n", name, ok ? "OK" : "GREŠKA");
+	return ok;
+}
+
+template <lightning::order Order, typename T, typename KeyFn>
+bool matchesStableSort(std::vector<T> values, KeyFn key)
+{
+	std::vector<T> expected = values;
+	std::stable_sort(expected.begin(), expected.end(), [&key](const T& a, const T& b)
+	{
+		using K = decltype(std::invoke(key, a));
+		const auto ka = lightning::key_traits<std::remove_cvref_t<K>>::ordered(std::invoke(key, a));
+		const auto kb = lightning::key_traits<std::remove_cvref_t<K>>::ordered(std::invoke(key, b));
+		return (Order == lightning::order::ascending) ? (ka < kb) : (kb < ka);
+	});
+
+	const SortResult result = lightning::radix_sort<Order>(values.begin(), values.end(), key);
+	if (result != SORT_SUCCESS)
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < values.size(); i++)
+	{
+		/* ključ po bitovima: -0.0 i +0.0 su jednaki za ==, ali ne i za sort */
+		const auto a = lightning::key_traits<std::remove_cvref_t<decltype(std::invoke(key, values[i]))>>::ordered(std::invoke(key, values[i]));
+		const auto b = lightning::key_traits<std::remove_cvref_t<decltype(std::invoke(key, expected[i]))>>::ordered(std::invoke(key, expected[i]));
+		if ((a != b) || !(values[i] == expected[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+} /* namespace */
+
+int main()
+{
+	std::printf("TEST C++: lightning::radix_sort (radix_sort.hpp)\n");
+	std::printf("-------------------------------------------------\n");
+
+	std::mt19937_64 rng(45U);
+	const std::size_t n = 100003U;
+	bool passed = true;
+
+	std::vector<std::int32_t> i32(n);
+	for (auto& v : i32)
+	{
+		v = static_cast<std::int32_t>(rng());
+	}
+	passed = report("int32_t rastuće (radixSort direktno)", matchesStableSort<lightning::order::ascending>(i32, std::identity{})) && passed;
+	passed = report("int32_t opadajuće (u mestu)", matchesStableSort<lightning::order::descending>(i32, std::identity{})) && passed;
+
+	std::vector<std::uint32_t> u32(n);
+	for (auto& v : u32)
+	{
+		v = static_cast<std::uint32_t>(rng());
+	}
+	passed = report("uint32_t rastuće", matchesStableSort<lightning::order::ascending>(u32, std::identity{})) && passed;
+
+	std::vector<float> f32(n);
+	std::uniform_real_distribution<float> real(-1000.0F, 1000.0F);
+	for (auto& v : f32)
+	{
+		v = real(rng);
+	}
+	f32[0] = -0.0F;
+	f32[1] = 0.0F;
+	f32[2] = std::numeric_limits<float>::infinity();
+	f32[3] = -std::numeric_limits<float>::infinity();
+	f32[4] = std::numeric_limits<float>::lowest();
+	passed = report("float rastuće (kopija u int32_t)", matchesStableSort<lightning::order::ascending>(f32, std::identity{})) && passed;
+	passed = report("float opadajuće", matchesStableSort<lightning::order::descending>(f32, std::identity{})) && passed;
+
+	std::vector<double> f64(n);
+	for (auto& v : f64)
+	{
+		v = static_cast<double>(real(rng)) * 1e200;
+	}
+	passed = report("double (radixSortKeysN)", matchesStableSort<lightning::order::ascending>(f64, std::identity{})) && passed;
+
+	std::vector<std::int64_t> i64(n);
+	for (auto& v : i64)
+	{
+		v = static_cast<std::int64_t>(rng());
+	}
+	i64[0] = std::numeric_limits<std::int64_t>::min();
+	i64[1] = std::numeric_limits<std::int64_t>::max();
+	passed = report("int64_t (radixSortKeysN)", matchesStableSort<lightning::order::ascending>(i64, std::identity{})) && passed;
+	passed = report("int64_t opadajuće", matchesStableSort<lightning::order::descending>(i64, std::identity{})) && passed;
+
+	/* Uzak ključ iz para: stabilnost se vidi po drugom članu */
+	std::vector<std::pair<std::uint8_t, std::uint32_t>> pairs(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		pairs[i] = { static_cast<std::uint8_t>(rng()), static_cast<std::uint32_t>(i) };
+	}
+	passed = report("uint8_t ključ iz para, stabilno", matchesStableSort<lightning::order::ascending>(pairs, &std::pair<std::uint8_t, std::uint32_t>::first)) && passed;
+	passed = report("uint8_t ključ opadajuće, stabilno", matchesStableSort<lightning::order::descending>(pairs, [](const auto& p) { return p.first; })) && passed;
+
+	std::vector<std::pair<Level, std::uint32_t>> levels(1000U);
+	const Level all[] = { Level::low, Level::mid, Level::high };
+	for (std::size_t i = 0; i < levels.size(); i++)
+	{
+		levels[i] = { all[rng() % 3U], static_cast<std::uint32_t>(i) };
+	}
+	passed = report("enum ključ (int16_t)", matchesStableSort<lightning::order::ascending>(levels, [](const auto& p) { return p.first; })) && passed;
+
+	/* Move-only elementi: premeštaju se kroz scratch, ključ je pokazivač na član */
+	std::vector<Record> records;
+	records.reserve(n);
+	for (std::size_t i = 0; i < n; i++)
+	{
+		records.push_back({ static_cast<std::int64_t>(rng() % 1000U) - 500, std::make_unique<std::size_t>(i) });
+	}
+	bool ok = (lightning::radix_sort(records.begin(), records.end(), &Record::id) == SORT_SUCCESS);
+	for (std::size_t i = 1; ok && (i < n); i++)
+	{
+		ok = (records[i - 1U].id < records[i].id) ||
+		     ((records[i - 1U].id == records[i].id) && (*records[i - 1U].payload < *records[i].payload));
+	}
+	passed = report("move-only zapisi po &Record::id, stabilno", ok) && passed;
+
+	/* std::span i std::array */
+	std::array<std::int32_t, 9> small = { 5, -1, 9, 0, -7, 3, 3, 100, -100 };
+	ok = (lightning::radix_sort(std::span<std::int32_t>(small)) == SORT_SUCCESS) &&
+	     std::is_sorted(small.begin(), small.end());
+	passed = report("std::span nad std::array", ok) && passed;
+
+	std::vector<std::int32_t> empty;
+	ok = (lightning::radix_sort(empty.begin(), empty.end()) == SORT_SUCCESS) &&
+	     (lightning::radix_sort(std::span<std::int32_t>(small.data(), 1U)) == SORT_SUCCESS);
+	passed = report("prazan niz i jedan element", ok) && passed;
+
+	static_assert(lightning::key_traits<std::int16_t>::bytes == 2U);
+	static_assert(lightning::key_traits<double>::restore_bits(lightning::key_traits<double>::ordered_bits(0x7FF0000000000001U)) == 0x7FF0000000000001U);
+	static_assert(lightning::key_traits<double>::words == 2U);
+	static_assert(lightning::key_traits<std::int8_t>::ordered(-128) == 0U);
+	static_assert(lightning::key_traits<float>::ordered(-1.0F) < lightning::key_traits<float>::ordered(-0.0F));
+
+	if (passed)
+	{
+		std::printf("✓ Test uspešan! Rezultati se poklapaju sa std::stable_sort.\n\n");
+		return 0;
+	}
+	std::printf("✗ Test neuspešan!\n\n");
+	return 1;
+}
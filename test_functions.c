@@ -10,12 +10,21 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <assert.h>
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define TEST_HAVE_THREADS 1
+#else
+#define TEST_HAVE_THREADS 0
+#endif
 
 #include "radix_sort.h"
 #include "test_functions.h"
 
 static void printArray(const int32_t* arr, size_t size);
 static bool isSorted(const int32_t* arr, size_t size);
+static int compareInt32(const void* a, const void* b);
+static bool matchesQsort(const int32_t* sorted, int32_t* original, size_t size);
 
 /*
  * TEST 1: Pozitivni brojevi
@@ -367,6 +376,38 @@ static bool isSorted(const int32_t* arr, size_t size)
 	return true;
 }
 
+/*
+ * Pomoćna funkcija: Poređenje za qsort (referentno sortiranje)
+ */
+static int compareInt32(const void* a, const void* b)
+{
+	int32_t x = *(const int32_t*)a;
+	int32_t y = *(const int32_t*)b;
+	return (x > y) - (x < y);
+}
+
+/*
+ * Pomoćna funkcija: Provera rezultata prema qsort-u
+ *
+ * Sortira original qsort-om (menja ga) i poredi element po element,
+ * tako da se proverava i sadržaj, ne samo redosled.
+ */
+static bool matchesQsort(const int32_t* sorted, int32_t* original, size_t size)
+{
+	assert(sorted != NULL);
+	assert(original != NULL);
+
+	qsort(original, size, sizeof(int32_t), compareInt32);
+	for (size_t i = 0; i < size; i++)
+	{
+		if (sorted[i] != original[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 /*
  * TEST FUNKCIJE SA NAMERNIM GREŠKAMA:
  * 
@@ -734,4 +775,2405 @@ void testMillionElements(void)
 	}
 
 	free(arr);
-}
\ No newline at end of file
+}
+
+/*
+ * TEST 17: Huge stranice za scratch bafere
+ *
+ * Sortira niz čiji su scratch baferi veći od 2 MB, prvo sa podrazumevanom
+ * politikom (hugetlbfs/THP), zatim sa isključenim huge stranicama.
+ * Proverava da je niz sortiran u oba slučaja i da statistika prijavljuje
+ * veličinu i vrstu stranica (dostupnost huge stranica zavisi od sistema).
+ */
+void testHugePageScratch(void)
+{
+	printf("TEST 17: Huge stranice za scratch bafere\n");
+	printf("-----------------------------------------\n");
+	printf("(Testira alokaciju i statistiku scratch bafera)\n");
+
+	const size_t size = 1U << 20;/*4 MB po baferu - iznad praga od 2 MB*/
+
+	int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+	if (arr == NULL)
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		return;
+	}
+
+	SortConfig original;
+	radixSortGetConfig(&original);
+
+	const SortHugePagePolicy policies[] = {SORT_HUGEPAGES_AUTO, SORT_HUGEPAGES_OFF};
+	bool passed = true;
+
+	for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++)
+	{
+		SortConfig config = original;
+		config.hugePages = policies[p];
+		(void)radixSortSetConfig(&config);
+
+		srand(17);
+		for (size_t i = 0; i < size; i++)
+		{
+			arr[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+		}
+
+		SortResult result = radixSort(arr, size);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		printf("Politika %d: %s, scratch %zu bajtova, stranice: %s\n",
+		       (int)policies[p], getSortResultString(result),
+		       stats.scratchBytes, getPageKindString(stats.pages));
+
+		if ((result != SORT_SUCCESS) || !isSorted(arr, size) ||
+		    (stats.scratchBytes != 2U * size * sizeof(int32_t)))
+		{
+			passed = false;
+		}
+
+		if ((policies[p] == SORT_HUGEPAGES_OFF) && (stats.pages != SORT_PAGES_NORMAL))
+		{
+			passed = false;
+		}
+	}
+
+	(void)radixSortSetConfig(&original);
+	free(arr);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Scratch baferi su ispravno alocirani i prijavljeni.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Neispravno sortiranje ili statistika scratch bafera!\n\n");
+	}
+}
+
+/*
+ * TEST 18: Višenitno sortiranje
+ *
+ * Poredi radixSortParallel sa radixSort na tri vrste ulaza: nasumične
+ * vrednosti, uzak opseg (najviši bajt isti za sve - MSD raspodela mora
+ * da izabere niži bajt) i svi isti elementi. Svaki ulaz se sortira sa
+ * uključenim i isključenim NUMA pinovanjem, sa 4 thread-a.
+ */
+void testParallelSort(void)
+{
+	printf("TEST 18: Višenitno sortiranje\n");
+	printf("------------------------------\n");
+	printf("(Poredi radixSortParallel sa radixSort)\n");
+
+	const size_t size = 1000000;
+	const size_t numThreads = 4;
+
+	int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* expected = (int32_t*)malloc(size * sizeof(int32_t));
+	if ((arr == NULL) || (expected == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(arr);
+		free(expected);
+		return;
+	}
+
+	SortConfig original;
+	radixSortGetConfig(&original);
+
+	const char* inputs[] = {"nasumične vrednosti", "uzak opseg [0, 999]", "svi isti"};
+	bool passed = true;
+
+	for (size_t input = 0; input < 3U; input++)
+	{
+		for (size_t numa = 0; numa < 2U; numa++)
+		{
+			srand(18);
+			for (size_t i = 0; i < size; i++)
+			{
+				int32_t value = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+				arr[i] = (input == 0U) ? value : ((input == 1U) ? (rand() % 1000) : -7);
+				expected[i] = arr[i];
+			}
+
+			SortConfig config = original;
+			config.numaAware = (numa == 0U);
+			(void)radixSortSetConfig(&config);
+
+			SortResult expectedResult = radixSort(expected, size);
+			SortResult result = radixSortParallel(arr, size, numThreads);
+			SortStats stats;
+			radixSortGetStats(&stats);
+
+			bool same = (result == SORT_SUCCESS) && (expectedResult == SORT_SUCCESS);
+			for (size_t i = 0; same && (i < size); i++)
+			{
+				same = (arr[i] == expected[i]);
+			}
+
+			printf("%-20s NUMA %-3s: %s, thread-ova %zu, čvorova %zu\n", inputs[input],
+			       config.numaAware ? "da" : "ne", same ? "isto kao radixSort" : "RAZLIKA",
+			       stats.threads, stats.numaNodes);
+
+			if (!same || (stats.threads != numThreads))
+			{
+				passed = false;
+			}
+		}
+	}
+
+	(void)radixSortSetConfig(&original);
+	free(arr);
+	free(expected);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Višenitni rezultat je identičan jednonitnom.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Višenitno sortiranje se razlikuje od radixSort!\n\n");
+	}
+}
+
+/*
+ * TEST 19: Batch sortiranje mnogo malih nizova
+ *
+ * Pravi 2000 nizova različitih veličina (prazni, mali za insertion sort,
+ * srednji i nekoliko velikih), sortira ih sa radixSortBatch i sa
+ * radixSortBatchParallel (4 thread-a) i poredi svaki niz sa radixSort.
+ * Proverava i da NULL niz sa veličinom većom od 0 vraća grešku.
+ */
+void testBatchSort(void)
+{
+	printf("TEST 19: Batch sortiranje mnogo malih nizova\n");
+	printf("---------------------------------------------\n");
+	printf("(Poredi radixSortBatch sa pojedinačnim radixSort pozivima)\n");
+
+	enum { COUNT = 2000 };
+	static int32_t* arrays[COUNT];
+	static int32_t* expected[COUNT];
+	static size_t sizes[COUNT];
+	bool passed = true;
+
+	for (size_t mode = 0; mode < 2U; mode++)
+	{
+		srand(19);
+		size_t total = 0;
+		for (size_t i = 0; i < COUNT; i++)
+		{
+			sizes[i] = (i % 7U == 0U) ? 0U : (size_t)(rand() % 300);
+			if (i % 500U == 1U)
+			{
+				sizes[i] = 20000U;
+			}
+			total += sizes[i];
+			arrays[i] = (int32_t*)malloc((sizes[i] + 1U) * sizeof(int32_t));
+			expected[i] = (int32_t*)malloc((sizes[i] + 1U) * sizeof(int32_t));
+			if ((arrays[i] == NULL) || (expected[i] == NULL))
+			{
+				printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+				return;
+			}
+			for (size_t j = 0; j < sizes[i]; j++)
+			{
+				arrays[i][j] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+				expected[i][j] = arrays[i][j];
+			}
+			if (sizes[i] > 0U)
+			{
+				(void)radixSort(expected[i], sizes[i]);
+			}
+		}
+
+		SortResult result = (mode == 0U) ? radixSortBatch(arrays, sizes, COUNT)
+		                                 : radixSortBatchParallel(arrays, sizes, COUNT, 4U);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool same = (result == SORT_SUCCESS);
+		for (size_t i = 0; same && (i < COUNT); i++)
+		{
+			for (size_t j = 0; same && (j < sizes[i]); j++)
+			{
+				same = (arrays[i][j] == expected[i][j]);
+			}
+		}
+
+		printf("%s: %zu nizova, %zu elemenata, thread-ova %zu, scratch %zu bajtova - %s\n",
+		       (mode == 0U) ? "radixSortBatch        " : "radixSortBatchParallel",
+		       (size_t)COUNT, total, stats.threads, stats.scratchBytes,
+		       same ? "isto kao radixSort" : "RAZLIKA");
+
+		passed = passed && same;
+
+		for (size_t i = 0; i < COUNT; i++)
+		{
+			free(arrays[i]);
+			free(expected[i]);
+		}
+	}
+
+	int32_t valid[] = {3, 1, 2};
+	int32_t* withNull[] = {valid, NULL};
+	size_t nullSizes[] = {3U, 5U};
+	SortResult nullResult = radixSortBatch(withNull, nullSizes, 2U);
+	printf("NULL niz u batch-u: %s\n", getSortResultString(nullResult));
+	if ((nullResult != SORT_ERROR_NULL) || (valid[0] != 3))
+	{
+		passed = false;
+	}
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Svi nizovi iz batch-a su ispravno sortirani.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Batch sortiranje se razlikuje od radixSort!\n\n");
+	}
+}
+
+/*
+ * TEST 20: Segmentirano sortiranje
+ *
+ * Jedan niz od 1,000,000 elemenata podeljen je na segmente nasumičnih
+ * dužina (uključujući prazne). Prvo kratki segmenti (prosek ~50, zajednički
+ * prolazi po blokovima), zatim dugi (prosek ~5000, delom i segmenti duži
+ * od bloka), sa jednim i sa 4 thread-a. Svaki segment se poredi sa radixSort.
+ * Proverava i da opadajući offsets vraća SORT_ERROR_ARGUMENT.
+ */
+void testSegmentedSort(void)
+{
+	printf("TEST 20: Segmentirano sortiranje\n");
+	printf("---------------------------------\n");
+	printf("(Poredi radixSortSegmented sa radixSort po segmentu)\n");
+
+	const size_t size = 1000000;
+	int32_t* data = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* expected = (int32_t*)malloc(size * sizeof(int32_t));
+	size_t* offsets = (size_t*)malloc((size + 1U) * sizeof(size_t));
+	if ((data == NULL) || (expected == NULL) || (offsets == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(data);
+		free(expected);
+		free(offsets);
+		return;
+	}
+
+	const size_t maxLengths[] = {100U, 10000U};
+	bool passed = true;
+
+	for (size_t mode = 0; mode < 4U; mode++)
+	{
+		size_t maxLength = maxLengths[mode / 2U];
+		size_t numThreads = ((mode % 2U) == 0U) ? 1U : 4U;
+
+		srand(20);
+		size_t numSegments = 0;
+		offsets[0] = 0;
+		while (offsets[numSegments] < size)
+		{
+			size_t length = (size_t)rand() % maxLength;
+			if (length > size - offsets[numSegments])
+			{
+				length = size - offsets[numSegments];
+			}
+			offsets[numSegments + 1U] = offsets[numSegments] + length;
+			numSegments++;
+		}
+		for (size_t i = 0; i < size; i++)
+		{
+			data[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+			expected[i] = data[i];
+		}
+		for (size_t s = 0; s < numSegments; s++)
+		{
+			if (offsets[s + 1U] > offsets[s])
+			{
+				(void)radixSort(expected + offsets[s], offsets[s + 1U] - offsets[s]);
+			}
+		}
+
+		SortResult result = radixSortSegmentedParallel(data, offsets, numSegments, numThreads);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool same = (result == SORT_SUCCESS);
+		for (size_t i = 0; same && (i < size); i++)
+		{
+			same = (data[i] == expected[i]);
+		}
+
+		printf("%zu segmenata (prosek %zu), thread-ova %zu: %s\n", numSegments,
+		       size / numSegments, stats.threads, same ? "isto kao radixSort" : "RAZLIKA");
+		passed = passed && same;
+	}
+
+	size_t badOffsets[] = {0U, 5U, 3U};
+	SortResult badResult = radixSortSegmented(data, badOffsets, 2U);
+	printf("Opadajući offsets: %s\n", getSortResultString(badResult));
+	passed = passed && (badResult == SORT_ERROR_ARGUMENT);
+
+	free(data);
+	free(expected);
+	free(offsets);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Svi segmenti su ispravno sortirani.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Segmentirano sortiranje se razlikuje od radixSort!\n\n");
+	}
+}
+
+/*
+ * TEST 21: Uzak opseg vrednosti
+ *
+ * Ocene oko 10^9, opseg oko nule i opseg pomeren ka INT32_MIN: broj
+ * prolaza mora zavisiti samo od širine opsega, ne od njegovog položaja.
+ * Opseg manji od broja elemenata ide na counting sort (1 prolaz),
+ * opseg do 2^16 na najviše 2 LSD prolaza. Rezultat se poredi sa qsort.
+ */
+void testNarrowRange(void)
+{
+	printf("TEST 21: Uzak opseg vrednosti\n");
+	printf("------------------------------\n");
+	printf("(Broj prolaza zavisi od širine opsega, ne od položaja)\n");
+
+	typedef struct
+	{
+		const char* name;
+		size_t size;
+		int32_t base;
+		uint32_t range;
+		size_t maxPasses;
+	} NarrowCase;
+
+	const NarrowCase cases[] =
+	{
+		{ "ocene [10^9, 10^9+500]",     100000U, 1000000000, 501U,   1U },
+		{ "opseg 60000 oko 10^9",       1000U,   1000000000, 60000U, 2U },
+		{ "[-300, 300] preko nule",     100U,    -300,       601U,   2U },
+		{ "opseg 40000 kod INT32_MIN",  5000U,   INT32_MIN,  40000U, 2U },
+	};
+
+	bool passed = true;
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		size_t size = cases[c].size;
+		int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+		int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+		if ((arr == NULL) || (reference == NULL))
+		{
+			printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+			free(arr);
+			free(reference);
+			return;
+		}
+
+		srand(21);
+		for (size_t i = 0; i < size; i++)
+		{
+			uint32_t offset = (((uint32_t)rand() << 16) ^ (uint32_t)rand()) % cases[c].range;
+			arr[i] = (int32_t)((uint32_t)cases[c].base + offset);
+			reference[i] = arr[i];
+		}
+
+		SortResult result = radixSort(arr, size);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (result == SORT_SUCCESS) && matchesQsort(arr, reference, size) &&
+		          (stats.passes <= cases[c].maxPasses);
+
+		printf("%-28s n=%-7zu %s, prolaza %zu - %s\n", cases[c].name, size,
+		       getStrategyString(stats.strategy), stats.passes, ok ? "OK" : "GREŠKA");
+
+		passed = passed && ok;
+		free(arr);
+		free(reference);
+	}
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Uski opsezi su sortirani u 1-2 prolaza.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Uzak opseg nije ispravno ili efikasno sortiran!\n\n");
+	}
+}
+
+/*
+ * TEST 22: Malo različitih vrednosti
+ *
+ * 100 000 elemenata: sve iste vrednosti i 100 kodova rasutih po celom
+ * int32_t opsegu moraju ići na hash brojanje. 300 kodova uz retke
+ * jedinstvene vrednosti van uzorka prekida brojanje (više od 1024
+ * različitih), a slučajne vrednosti ne prolaze uzorak - obe idu na LSD.
+ */
+void testLowCardinality(void)
+{
+	printf("TEST 22: Malo različitih vrednosti\n");
+	printf("----------------------------------\n");
+	printf("(Hash brojanje različitih vrednosti umesto prolaza rasipanja)\n");
+
+	typedef struct
+	{
+		const char* name;
+		uint32_t distinct;      /* 0 = sve vrednosti su slučajne */
+		size_t rareStride;      /* svaki rareStride-ti element (van uzorka) je jedinstven, 0 = bez */
+		SortStrategy expected;
+	} CardinalityCase;
+
+	const CardinalityCase cases[] =
+	{
+		{ "sve vrednosti iste",          1U,   0U,  SORT_STRATEGY_LOW_CARDINALITY },
+		{ "100 kodova po celom opsegu",  100U, 0U,  SORT_STRATEGY_LOW_CARDINALITY },
+		{ "300 kodova + retke jedinst.", 300U, 97U, SORT_STRATEGY_LSD },
+		{ "slučajne vrednosti",          0U,   0U,  SORT_STRATEGY_LSD },
+	};
+
+	const size_t size = 100000U;
+	int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+	if ((arr == NULL) || (reference == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(arr);
+		free(reference);
+		return;
+	}
+
+	bool passed = true;
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		srand(22);
+		for (size_t i = 0; i < size; i++)
+		{
+			uint32_t random = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+			if ((cases[c].distinct == 0U) ||
+			    ((cases[c].rareStride != 0U) && ((i % cases[c].rareStride) == 50U)))
+			{
+				arr[i] = (int32_t)random;
+			}
+			else
+			{
+				/* Kodovi rasuti po celom opsegu, i negativni */
+				arr[i] = (int32_t)((random % cases[c].distinct) * 0x9E3779B1U);
+			}
+			reference[i] = arr[i];
+		}
+
+		SortResult result = radixSort(arr, size);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (result == SORT_SUCCESS) && matchesQsort(arr, reference, size) &&
+		          (stats.strategy == cases[c].expected);
+
+		printf("%-28s %s, prolaza %zu - %s\n", cases[c].name,
+		       getStrategyString(stats.strategy), stats.passes, ok ? "OK" : "GREŠKA");
+
+		passed = passed && ok;
+	}
+
+	free(arr);
+	free(reference);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Malo različitih vrednosti je prepoznato i sortirano.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Niska kardinalnost nije ispravno obrađena!\n\n");
+	}
+}
+
+/*
+ * TEST 23: Sortiranje sa izbacivanjem duplikata
+ *
+ * radixSortUnique i radixSortCounts na ulazima koji pogađaju svaku
+ * putanju: jedan element, sve iste vrednosti, uzak opseg (counting),
+ * jedan bajt koji se menja (jedini LSD prolaz), širok opseg sa
+ * duplikatima (više LSD prolaza) i malo različitih (hash brojanje).
+ * Rezultat se poredi sa qsort + ručnim brojanjem.
+ */
+void testUniqueCounts(void)
+{
+	printf("TEST 23: Sortiranje sa izbacivanjem duplikata\n");
+	printf("---------------------------------------------\n");
+	printf("(Duplikati se izbacuju u poslednjem prolazu)\n");
+
+	typedef struct
+	{
+		const char* name;
+		size_t size;
+		uint32_t distinct;
+		uint32_t step;/*razmak između vrednosti*/
+	} UniqueCase;
+
+	const UniqueCase cases[] =
+	{
+		{ "jedan element",              1U,      1U,    1U },
+		{ "sve vrednosti iste",         1000U,   1U,    1U },
+		{ "uzak opseg (counting)",      10000U,  500U,  1U },
+		{ "jedan bajt se menja",        5000U,   256U,  1U << 24 },
+		{ "širok opseg sa duplikatima", 20000U,  5000U, 100003U },
+		{ "100 kodova (hash)",          100000U, 100U,  0x9E3779B1U },
+	};
+
+	bool passed = true;
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		size_t size = cases[c].size;
+		int32_t* unique = (int32_t*)malloc(size * sizeof(int32_t));
+		int32_t* counted = (int32_t*)malloc(size * sizeof(int32_t));
+		int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+		size_t* counts = (size_t*)malloc(size * sizeof(size_t));
+		if ((unique == NULL) || (counted == NULL) || (reference == NULL) || (counts == NULL))
+		{
+			printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+			free(unique);
+			free(counted);
+			free(reference);
+			free(counts);
+			return;
+		}
+
+		srand(23);
+		for (size_t i = 0; i < size; i++)
+		{
+			uint32_t random = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+			unique[i] = (int32_t)((random % cases[c].distinct) * cases[c].step);
+			counted[i] = unique[i];
+			reference[i] = unique[i];
+		}
+		qsort(reference, size, sizeof(int32_t), compareInt32);
+
+		size_t newSize = 0;
+		size_t numDistinct = 0;
+		bool ok = (radixSortUnique(unique, size, &newSize) == SORT_SUCCESS) &&
+		          (radixSortCounts(counted, size, counts, &numDistinct) == SORT_SUCCESS) &&
+		          (newSize == numDistinct);
+
+		/* Poređenje sa referencom: svaka grupa jednakih vrednosti je jedan izlaz */
+		size_t k = 0;
+		for (size_t i = 0; ok && (i < size); k++)
+		{
+			size_t run = 1;
+			while ((i + run < size) && (reference[i + run] == reference[i]))
+			{
+				run++;
+			}
+			ok = (k < newSize) && (unique[k] == reference[i]) &&
+			     (counted[k] == reference[i]) && (counts[k] == run);
+			i += run;
+		}
+		ok = ok && (k == newSize);
+
+		SortStats stats;
+		radixSortGetStats(&stats);
+		printf("%-28s n=%-7zu različitih %-5zu %s - %s\n", cases[c].name, size, newSize,
+		       getStrategyString(stats.strategy), ok ? "OK" : "GREŠKA");
+
+		passed = passed && ok;
+		free(unique);
+		free(counted);
+		free(reference);
+		free(counts);
+	}
+
+	size_t dummy = 0;
+	int32_t one[] = { 1 };
+	passed = passed && (radixSortUnique(one, 1U, NULL) == SORT_ERROR_NULL) &&
+	         (radixSortCounts(one, 1U, NULL, &dummy) == SORT_ERROR_NULL);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Različite vrednosti i brojači odgovaraju referenci.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Izbacivanje duplikata nije ispravno!\n\n");
+	}
+}
+
+/*
+ * TEST 24: Keš-blokirano sortiranje velikog niza
+ *
+ * 4 000 000 elemenata je više od dvostrukog L2 na uobičajenim
+ * procesorima, pa uniformne vrednosti idu na MSD po najvišem bajtu + LSD
+ * po bucket-u. Kod iskrivljene raspodele (skoro sve u jednom bucket-u
+ * najvišeg bajta) bucket ne staje u keš i mora se izabrati običan LSD.
+ * Oba rezultata se porede sa qsort.
+ */
+void testCacheBlockedSort(void)
+{
+	printf("TEST 24: Keš-blokirano sortiranje\n");
+	printf("---------------------------------\n");
+	printf("(Jedan MSD prolaz, zatim LSD po bucket-u dok je u kešu)\n");
+
+	const size_t size = 4000000U;
+	int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+	if ((arr == NULL) || (reference == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(arr);
+		free(reference);
+		return;
+	}
+
+	bool passed = true;
+
+	for (size_t c = 0; c < 2U; c++)
+	{
+		bool skewed = (c == 1U);
+
+		srand(24);
+		for (size_t i = 0; i < size; i++)
+		{
+			uint32_t random = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+			/* Iskrivljeno: sve u [0, 2^24) osim svakog 1000-tog elementa */
+			arr[i] = (skewed && ((i % 1000U) != 0U)) ? (int32_t)(random & 0xFFFFFFU) : (int32_t)random;
+			reference[i] = arr[i];
+		}
+
+		SortResult result = radixSort(arr, size);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (result == SORT_SUCCESS) && matchesQsort(arr, reference, size);
+		if (skewed)
+		{
+			ok = ok && (stats.strategy == SORT_STRATEGY_LSD);
+		}
+		else
+		{
+			/* Na procesoru sa L2 većim od 8 MB niz još nije dovoljno velik */
+			ok = ok && ((stats.strategy == SORT_STRATEGY_CACHE_BLOCKED) || (stats.strategy == SORT_STRATEGY_LSD));
+		}
+
+		printf("%-24s %s - %s\n", skewed ? "iskrivljena raspodela" : "uniformna raspodela",
+		       getStrategyString(stats.strategy), ok ? "OK" : "GREŠKA");
+
+		passed = passed && ok;
+	}
+
+	free(arr);
+	free(reference);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Veliki niz je ispravno sortiran.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Keš-blokirano sortiranje nije ispravno!\n\n");
+	}
+}
+
+/*
+ * TEST 25: Sortiranje u drugi niz
+ *
+ * radixSortCopy za ulaze koji daju paran i neparan broj prolaza, sa i bez
+ * umanjenja za min (i sa dodatnim prolazom kada parnost ne odgovara),
+ * jedan prolaz, counting i hash putanju. Ulaz mora ostati neizmenjen,
+ * izlaz se poredi sa qsort, a koristi se samo jedan scratch bafer.
+ */
+void testSortCopy(void)
+{
+	printf("TEST 25: Sortiranje u drugi niz\n");
+	printf("-------------------------------\n");
+	printf("(Ulaz se samo čita, izlaz je drugi bafer za prolaze)\n");
+
+	typedef struct
+	{
+		const char* name;
+		size_t size;
+		int32_t base;
+		uint32_t count;/*broj mogućih vrednosti, 0 = pun opseg*/
+		uint32_t step;
+	} CopyCase;
+
+	const CopyCase cases[] =
+	{
+		{ "jedan element",                1U,      5,          1U,       1U },
+		{ "sve vrednosti iste",           1000U,   -7,         1U,       1U },
+		{ "pun opseg (4 prolaza)",        100000U, 0,          0U,       1U },
+		{ "[0, 2^24) (3 prolaza)",        50000U,  0,          1U << 24, 1U },
+		{ "jedan bajt (direktno)",        5000U,   0,          256U,     1U << 24 },
+		{ "umanjenje, 3 bajta",           50000U,  1000000000, 1U << 24, 1U },
+		{ "umanjenje, 2 bajta",           50000U,  1000000000, 60000U,   1U },
+		{ "umanjenje + dodatni prolaz",   5000U,   0x00FFFF00, 256U,     256U },
+		{ "uzak opseg (counting)",        10000U,  -250,       500U,     1U },
+		{ "100 kodova (hash)",            100000U, 0,          100U,     0x9E3779B1U },
+	};
+
+	bool passed = true;
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		size_t size = cases[c].size;
+		int32_t* in = (int32_t*)malloc(size * sizeof(int32_t));
+		int32_t* saved = (int32_t*)malloc(size * sizeof(int32_t));
+		int32_t* out = (int32_t*)malloc(size * sizeof(int32_t));
+		if ((in == NULL) || (saved == NULL) || (out == NULL))
+		{
+			printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+			free(in);
+			free(saved);
+			free(out);
+			return;
+		}
+
+		srand(25);
+		for (size_t i = 0; i < size; i++)
+		{
+			uint32_t random = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+			uint32_t offset = (cases[c].count == 0U) ? random : ((random % cases[c].count) * cases[c].step);
+			in[i] = (int32_t)((uint32_t)cases[c].base + offset);
+			saved[i] = in[i];
+		}
+
+		SortResult result = radixSortCopy(in, out, size);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool unchanged = (memcmp(in, saved, size * sizeof(int32_t)) == 0);
+		bool ok = (result == SORT_SUCCESS) && unchanged && matchesQsort(out, saved, size) &&
+		          ((size == 1U) || (stats.scratchBytes == size * sizeof(uint32_t)));
+
+		printf("%-28s %-32s prolaza %zu - %s\n", cases[c].name, getStrategyString(stats.strategy),
+		       stats.passes, ok ? "OK" : "GREŠKA");
+
+		passed = passed && ok;
+		free(in);
+		free(saved);
+		free(out);
+	}
+
+	int32_t one[] = { 1 };
+	passed = passed && (radixSortCopy(NULL, one, 1U) == SORT_ERROR_NULL) &&
+	         (radixSortCopy(one, NULL, 1U) == SORT_ERROR_NULL) &&
+	         (radixSortCopy(one, one, 0U) == SORT_ERROR_SIZE);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Izlaz je sortiran, ulaz nije menjan.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Sortiranje u drugi niz nije ispravno!\n\n");
+	}
+}
+
+#if TEST_HAVE_THREADS
+
+/*
+ * Pozivalac koji deli kontekst sa ostalima: sortira svoje nizove i
+ * proverava rezultat
+ */
+typedef struct
+{
+	RadixSortContext* context;
+	unsigned int seed;
+	bool ok;
+} ContextCaller;
+
+static void* contextCallerThread(void* arg)
+{
+	ContextCaller* caller = (ContextCaller*)arg;
+	const size_t size = 70000U;
+	int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+
+	caller->ok = (arr != NULL) && (reference != NULL);
+	for (size_t round = 0; caller->ok && (round < 8U); round++)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			caller->seed = (caller->seed * 1103515245U) + 12345U;
+			arr[i] = (int32_t)(caller->seed ^ (caller->seed << 7));
+			reference[i] = arr[i];
+		}
+		caller->ok = (radixSortWithContext(caller->context, arr, size) == SORT_SUCCESS) &&
+		             matchesQsort(arr, reference, size);
+	}
+
+	free(arr);
+	free(reference);
+	return NULL;
+}
+
+#endif
+
+/*
+ * TEST 26: Kontekst sa trajnim pool-om thread-ova
+ *
+ * Jedan kontekst (4 thread-a, bafer za 200 000 elemenata) sortira nizove
+ * različitih veličina, uključujući veći od kapaciteta (bafer raste).
+ * Zatim ga 4 thread-a koriste istovremeno, svaki po 8 nizova - pozivi
+ * čekaju red i svaki rezultat mora biti ispravan.
+ */
+void testSortContext(void)
+{
+	printf("TEST 26: Kontekst sa trajnim pool-om thread-ova\n");
+	printf("-----------------------------------------------\n");
+	printf("(Thread-ovi i baferi se prave jednom, koriste u svakom pozivu)\n");
+
+	RadixSortContext* context = NULL;
+	if (radixSortContextCreate(&context, 4U, 200000U) != SORT_SUCCESS)
+	{
+		printf("✗ Greška: Kontekst nije napravljen!\n\n");
+		return;
+	}
+
+	const size_t sizes[] = { 1U, 1000U, 100000U, 300000U, 50000U };
+	bool passed = true;
+
+	for (size_t c = 0; c < sizeof(sizes) / sizeof(sizes[0]); c++)
+	{
+		size_t size = sizes[c];
+		int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+		int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+		if ((arr == NULL) || (reference == NULL))
+		{
+			printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+			free(arr);
+			free(reference);
+			radixSortContextDestroy(context);
+			return;
+		}
+
+		srand(26);
+		for (size_t i = 0; i < size; i++)
+		{
+			arr[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+			reference[i] = arr[i];
+		}
+
+		SortResult result = radixSortWithContext(context, arr, size);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (result == SORT_SUCCESS) && matchesQsort(arr, reference, size);
+		printf("n=%-8zu %-30s thread-ova %zu - %s\n", size, getStrategyString(stats.strategy),
+		       stats.threads, ok ? "OK" : "GREŠKA");
+
+		passed = passed && ok;
+		free(arr);
+		free(reference);
+	}
+
+#if TEST_HAVE_THREADS
+	ContextCaller callers[4];
+	pthread_t threads[4];
+	bool started[4] = {false};
+	for (size_t t = 0; t < 4U; t++)
+	{
+		callers[t].context = context;
+		callers[t].seed = 26U + (unsigned int)t;
+		callers[t].ok = false;
+		started[t] = (pthread_create(&threads[t], NULL, contextCallerThread, &callers[t]) == 0);
+		if (!started[t])
+		{
+			(void)contextCallerThread(&callers[t]);
+		}
+	}
+	bool sharedOk = true;
+	for (size_t t = 0; t < 4U; t++)
+	{
+		if (started[t])
+		{
+			(void)pthread_join(threads[t], NULL);
+		}
+		sharedOk = sharedOk && callers[t].ok;
+	}
+	printf("4 pozivaoca dele kontekst (po 8 nizova)            - %s\n", sharedOk ? "OK" : "GREŠKA");
+	passed = passed && sharedOk;
+#endif
+
+	int32_t one[] = { 1 };
+	passed = passed && (radixSortWithContext(NULL, one, 1U) == SORT_ERROR_NULL) &&
+	         (radixSortWithContext(context, NULL, 1U) == SORT_ERROR_NULL) &&
+	         (radixSortWithContext(context, one, 0U) == SORT_ERROR_SIZE) &&
+	         (radixSortContextCreate(NULL, 1U, 0U) == SORT_ERROR_NULL);
+
+	radixSortContextDestroy(context);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Kontekst je ispravno ponovo korišćen i deljen.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Sortiranje sa kontekstom nije ispravno!\n\n");
+	}
+}
+
+/*
+ * Pomoćna funkcija za TEST 27: callback beleži rezultat u svoj slot
+ */
+typedef struct
+{
+	SortResult result;
+	size_t size;
+	bool called;
+} AsyncSlot;
+
+static void asyncRecord(int32_t* arr, size_t size, SortResult result, void* userdata)
+{
+	(void)arr;
+	AsyncSlot* slot = (AsyncSlot*)userdata;
+	slot->result = result;
+	slot->size = size;
+	slot->called = true;
+}
+
+#if TEST_HAVE_THREADS
+typedef struct
+{
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	bool called;
+} AsyncSignal;
+
+static void asyncSignal(int32_t* arr, size_t size, SortResult result, void* userdata)
+{
+	(void)arr;
+	(void)size;
+	(void)result;
+	AsyncSignal* signal = (AsyncSignal*)userdata;
+	(void)pthread_mutex_lock(&signal->mutex);
+	signal->called = true;
+	(void)pthread_cond_signal(&signal->cond);
+	(void)pthread_mutex_unlock(&signal->mutex);
+}
+#endif
+
+/*
+ * TEST 27: Asinhrono sortiranje u pozadinskom pool-u
+ *
+ * Predaje se 16 nizova različitih veličina odjednom; pola se završava sa
+ * radixSortWait, pola sa radixSortPoll. Svaki niz mora biti sortiran, a
+ * callback pozvan sa pravim rezultatom. Zatim jedan odvojen (detach)
+ * posao i greške argumenata koje stižu kroz rezultat posla.
+ */
+void testSortAsync(void)
+{
+	printf("TEST 27: Asinhrono sortiranje u pozadinskom pool-u\n");
+	printf("--------------------------------------------------\n");
+	printf("(16 nizova predato odjednom, Wait i Poll)\n");
+
+	enum { JOBS = 16 };
+	int32_t* arrays[JOBS] = { NULL };
+	int32_t* references[JOBS] = { NULL };
+	size_t sizes[JOBS];
+	AsyncSlot slots[JOBS];
+	RadixSortHandle* handles[JOBS] = { NULL };
+	bool passed = true;
+
+	srand(27);
+	for (size_t j = 0; j < JOBS; j++)
+	{
+		sizes[j] = 1U + ((j * 37813U) % 200000U);
+		arrays[j] = (int32_t*)malloc(sizes[j] * sizeof(int32_t));
+		references[j] = (int32_t*)malloc(sizes[j] * sizeof(int32_t));
+		if ((arrays[j] == NULL) || (references[j] == NULL))
+		{
+			printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+			for (size_t k = 0; k <= j; k++)
+			{
+				free(arrays[k]);
+				free(references[k]);
+			}
+			return;
+		}
+		for (size_t i = 0; i < sizes[j]; i++)
+		{
+			arrays[j][i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+			references[j][i] = arrays[j][i];
+		}
+		slots[j].result = SORT_ERROR_ARGUMENT;
+		slots[j].size = 0U;
+		slots[j].called = false;
+	}
+
+	for (size_t j = 0; j < JOBS; j++)
+	{
+		handles[j] = radixSortAsync(arrays[j], sizes[j], asyncRecord, &slots[j]);
+		passed = passed && (handles[j] != NULL);
+	}
+
+	size_t polls = 0U;
+	for (size_t j = 0; j < JOBS; j++)
+	{
+		if (handles[j] == NULL)
+		{
+			continue;
+		}
+
+		SortResult result = SORT_ERROR_ARGUMENT;
+		if ((j % 2U) == 0U)
+		{
+			result = radixSortWait(handles[j]);
+		}
+		else
+		{
+			while (!radixSortPoll(handles[j], &result))
+			{
+				polls++;
+			}
+		}
+
+		bool ok = (result == SORT_SUCCESS) && slots[j].called && (slots[j].result == SORT_SUCCESS) &&
+		          (slots[j].size == sizes[j]) && matchesQsort(arrays[j], references[j], sizes[j]);
+		passed = passed && ok;
+	}
+	printf("16 poslova (%zu neuspešnih Poll poziva) - %s\n", polls, passed ? "OK" : "GREŠKA");
+
+	for (size_t j = 0; j < JOBS; j++)
+	{
+		free(arrays[j]);
+		free(references[j]);
+	}
+
+	/* Odvojen posao: handle se oslobađa sam, kraj javlja callback */
+	int32_t detached[] = { 5, -3, 9, 0, -7, 2 };
+#if TEST_HAVE_THREADS
+	AsyncSignal signal = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, false };
+	RadixSortHandle* handle = radixSortAsync(detached, 6U, asyncSignal, &signal);
+	radixSortDetach(handle);
+	(void)pthread_mutex_lock(&signal.mutex);
+	while ((handle != NULL) && !signal.called)
+	{
+		(void)pthread_cond_wait(&signal.cond, &signal.mutex);
+	}
+	(void)pthread_mutex_unlock(&signal.mutex);
+	bool detachedOk = (handle != NULL) && isSorted(detached, 6U);
+#else
+	radixSortDetach(radixSortAsync(detached, 6U, NULL, NULL));
+	bool detachedOk = isSorted(detached, 6U);
+#endif
+	printf("Odvojen (detach) posao                  - %s\n", detachedOk ? "OK" : "GREŠKA");
+	passed = passed && detachedOk;
+
+	/* Greške argumenata stižu kroz rezultat posla i callback */
+	AsyncSlot errorSlot = { SORT_SUCCESS, 0U, false };
+	int32_t one[] = { 1 };
+	passed = passed && (radixSortWait(radixSortAsync(NULL, 1U, asyncRecord, &errorSlot)) == SORT_ERROR_NULL) &&
+	         errorSlot.called && (errorSlot.result == SORT_ERROR_NULL) &&
+	         (radixSortWait(radixSortAsync(one, 0U, NULL, NULL)) == SORT_ERROR_SIZE) &&
+	         (radixSortWait(NULL) == SORT_ERROR_NULL);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Asinhroni poslovi su ispravno završeni.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Asinhrono sortiranje nije ispravno!\n\n");
+	}
+}
+
+/*
+ * Pomoćna funkcija za TEST 28: referentni lower_bound nad sortiranim nizom
+ */
+static size_t lowerBound(const int32_t* sorted, size_t size, int32_t value)
+{
+	size_t low = 0U;
+	size_t high = size;
+	while (low < high)
+	{
+		size_t middle = low + ((high - low) / 2U);
+		if (sorted[middle] < value)
+		{
+			low = middle + 1U;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	return low;
+}
+
+/*
+ * TEST 28: Zapakovan sortiran izlaz (delta + pakovanje bitova)
+ *
+ * Za različite veličine (i nepotpune blokove) i raspodele: radixSortPacked
+ * pa radixPackedDecode mora vratiti isto što i qsort, a radixPackedFind
+ * isti index kao lower_bound nad raspakovanim nizom. Pokriveni su širina
+ * 0 (svi isti), širina 32 (INT32_MIN i INT32_MAX) i greške, uključujući
+ * oštećen direktorijum blokova.
+ */
+void testPackedSort(void)
+{
+	printf("TEST 28: Zapakovan sortiran izlaz\n");
+	printf("---------------------------------\n");
+	printf("(Razlike uzastopnih elemenata u blokovima od 128)\n");
+
+	typedef struct
+	{
+		const char* name;
+		size_t size;
+		uint32_t range; /* 0 = ceo int32_t opseg */
+	} PackCase;
+
+	const PackCase cases[] =
+	{
+		{ "jedan element",      1U,       0U },
+		{ "127 (nepotpun blok)", 127U,    0U },
+		{ "129 elemenata",      129U,     0U },
+		{ "uniformno 10^6",     1000000U, 0U },
+		{ "opseg 1000",         100000U,  1000U },
+		{ "svi isti",           5000U,    1U },
+		{ "MIN i MAX",          1000U,    2U },
+	};
+
+	bool passed = true;
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		size_t size = cases[c].size;
+		size_t capacity = radixPackedBound(size);
+		int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+		int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+		int32_t* decoded = (int32_t*)malloc(size * sizeof(int32_t));
+		uint8_t* packed = (uint8_t*)malloc(capacity);
+		if ((arr == NULL) || (reference == NULL) || (decoded == NULL) || (packed == NULL))
+		{
+			printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+			free(arr);
+			free(reference);
+			free(decoded);
+			free(packed);
+			return;
+		}
+
+		srand(28);
+		for (size_t i = 0; i < size; i++)
+		{
+			uint32_t random = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+			if (cases[c].range == 0U)
+			{
+				arr[i] = (int32_t)random;
+			}
+			else if (cases[c].range == 2U)
+			{
+				arr[i] = ((random & 1U) != 0U) ? INT32_MAX : INT32_MIN;
+			}
+			else
+			{
+				arr[i] = (int32_t)(random % cases[c].range) - 500;
+			}
+			reference[i] = arr[i];
+		}
+		qsort(reference, size, sizeof(int32_t), compareInt32);
+
+		size_t bytes = 0U;
+		size_t count = 0U;
+		bool ok = (radixSortPacked(arr, size, packed, capacity, &bytes) == SORT_SUCCESS) &&
+		          (radixPackedDecode(packed, bytes, decoded, size, &count) == SORT_SUCCESS) &&
+		          (count == size) && (memcmp(decoded, reference, size * sizeof(int32_t)) == 0);
+
+		/* Pretraga: postojeće vrednosti, susedi i granice opsega */
+		for (size_t q = 0; ok && (q < 64U); q++)
+		{
+			int64_t near = (int64_t)reference[(q * 7919U) % size] + (int64_t)(q % 3U) - 1;
+			near = (near < INT32_MIN) ? INT32_MIN : ((near > INT32_MAX) ? INT32_MAX : near);
+			int32_t value = (q == 0U) ? INT32_MIN : ((q == 1U) ? INT32_MAX : (int32_t)near);
+			size_t index = 0U;
+			ok = (radixPackedFind(packed, bytes, value, &index) == SORT_SUCCESS) &&
+			     (index == lowerBound(reference, size, value));
+		}
+
+		printf("%-20s n=%-8zu %6.2f bita po elementu - %s\n", cases[c].name, size,
+		       (8.0 * (double)bytes) / (double)size, ok ? "OK" : "GREŠKA");
+		passed = passed && ok;
+
+		free(arr);
+		free(reference);
+		free(decoded);
+		free(packed);
+	}
+
+	/* Greške: nesortiran ulaz, premali izlaz, neispravno zaglavlje */
+	const int32_t unsorted[] = { 1, 3, 2 };
+	const int32_t sorted[] = { 1, 2, 3 };
+	uint64_t buffer[256];
+	uint8_t* packed = (uint8_t*)buffer;
+	int32_t small[2];
+	size_t bytes = 0U;
+	size_t count = 0U;
+	passed = passed && (radixPackedEncode(unsorted, 3U, packed, sizeof(buffer), &bytes) == SORT_ERROR_ARGUMENT) &&
+	         (radixPackedEncode(sorted, 3U, packed, 16U, &bytes) == SORT_ERROR_ARGUMENT) &&
+	         (radixPackedEncode(sorted, 0U, packed, sizeof(buffer), &bytes) == SORT_ERROR_SIZE) &&
+	         (radixPackedEncode(NULL, 3U, packed, sizeof(buffer), &bytes) == SORT_ERROR_NULL) &&
+	         (radixPackedEncode(sorted, 3U, packed, sizeof(buffer), &bytes) == SORT_SUCCESS) &&
+	         (radixPackedDecode(packed, bytes, small, 2U, &count) == SORT_ERROR_SIZE) && (count == 3U);
+	packed[0] ^= 0xFFU;
+	passed = passed && (radixPackedDecode(packed, bytes, small, 2U, &count) == SORT_ERROR_ARGUMENT);
+
+	/* Oštećen direktorijum (pomeraj van podataka, širina koja nije umnožak 4 trake, opadajući pomeraji) */
+	int32_t values[600];
+	int32_t decodedValues[600];
+	uint64_t large[400];
+	packed = (uint8_t*)large;
+	for (size_t i = 0; i < 600U; i++)
+	{
+		values[i] = ((int32_t)i * 1000) - 300000;
+	}
+	passed = passed && (radixPackedBound(600U) <= sizeof(large)) &&
+	         (radixPackedEncode(values, 600U, packed, sizeof(large), &bytes) == SORT_SUCCESS);
+	uint32_t* directory = (uint32_t*)(void*)(packed + 24U);
+	const uint32_t original = directory[(2U * 3U) + 1U];
+	const uint32_t corrupt[] = { 0x00FFFFFFU, original + 1U, directory[(2U * 2U) + 1U] - 4U };
+	for (size_t c = 0; c < sizeof(corrupt) / sizeof(corrupt[0]); c++)
+	{
+		size_t index = 0U;
+		directory[(2U * 3U) + 1U] = corrupt[c];
+		passed = passed && (radixPackedDecode(packed, bytes, decodedValues, 600U, &count) == SORT_ERROR_ARGUMENT) &&
+		         (radixPackedFind(packed, bytes, values[400], &index) == SORT_ERROR_ARGUMENT);
+	}
+	directory[(2U * 3U) + 1U] = original;
+	passed = passed && (radixPackedDecode(packed, bytes, decodedValues, 600U, &count) == SORT_SUCCESS) &&
+	         (memcmp(values, decodedValues, sizeof(values)) == 0);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Zapakovan niz se ispravno raspakuje i pretražuje.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Pakovanje sortiranog niza nije ispravno!\n\n");
+	}
+}
+
+/*
+ * TEST 29: Ulaz od nekoliko sortiranih delova
+ *
+ * Niz je nadovezivanje k sortiranih delova (kao spojeni sortirani
+ * segmenti po shard-u). Do 16 delova očekuje se
+ * k-way spajanje, za 17 i više radix, za jedan deo ništa. Proverava se
+ * i sortiranje u drugi niz i delovi od jednog elementa.
+ */
+void testSortedRuns(void)
+{
+	printf("TEST 29: Ulaz od nekoliko sortiranih delova\n");
+	printf("-------------------------------------------\n");
+	printf("(Prirodni rastući delovi se spajaju turnirskim stablom)\n");
+
+	typedef struct
+	{
+		const char* name;
+		size_t runs;
+		bool copy;
+		SortStrategy expected;
+	} RunCase;
+
+	const RunCase cases[] =
+	{
+		{ "1 deo (sortiran)",      1U,  false, SORT_STRATEGY_NONE },
+		{ "2 dela",                2U,  false, SORT_STRATEGY_MERGE_RUNS },
+		{ "5 delova",              5U,  false, SORT_STRATEGY_MERGE_RUNS },
+		{ "16 delova",             16U, false, SORT_STRATEGY_MERGE_RUNS },
+		{ "16 delova, u drugi niz", 16U, true, SORT_STRATEGY_MERGE_RUNS },
+		{ "17 delova",             17U, false, SORT_STRATEGY_LSD },
+	};
+
+	const size_t size = 200000U;
+	bool passed = true;
+
+	int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* out = (int32_t*)malloc(size * sizeof(int32_t));
+	if ((arr == NULL) || (reference == NULL) || (out == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(arr);
+		free(reference);
+		free(out);
+		return;
+	}
+
+	srand(29);
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		/* Delovi jednakih dužina; pretposlednja dva su po jedan element (1000, pa -1000) */
+		size_t runs = cases[c].runs;
+		size_t start = 0;
+		for (size_t r = 0; r < runs; r++)
+		{
+			bool single = (runs >= 3U) && (r + 3U >= runs) && (r + 1U < runs);
+			size_t end = (r + 1U == runs) ? size : (single ? (start + 1U) : (start + (size / runs)));
+			for (size_t i = start; i < end; i++)
+			{
+				arr[i] = single ? ((r + 3U == runs) ? 1000 : -1000) : (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+			}
+			(void)radixSort(arr + start, end - start);
+			start = end;
+		}
+
+		size_t actualRuns = 1U;
+		for (size_t i = 1; i < size; i++)
+		{
+			actualRuns += (arr[i] < arr[i - 1U]) ? 1U : 0U;
+		}
+		(void)memcpy(reference, arr, size * sizeof(int32_t));
+
+		SortResult result = cases[c].copy ? radixSortCopy(arr, out, size) : radixSort(arr, size);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (actualRuns == runs) && (result == SORT_SUCCESS) && (stats.strategy == cases[c].expected) &&
+		          matchesQsort(cases[c].copy ? out : arr, reference, size);
+		printf("%-24s %-30s - %s\n", cases[c].name, getStrategyString(stats.strategy), ok ? "OK" : "GREŠKA");
+		passed = passed && ok;
+	}
+
+	free(arr);
+	free(reference);
+	free(out);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Sortirani delovi su ispravno spojeni.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Spajanje sortiranih delova nije ispravno!\n\n");
+	}
+}
+
+/*
+ * TEST 30: Sortiranje više kolona (permutacija) i gather
+ *
+ * Tri kolone: mala kardinalnost (puno izjednačenja), negativne vrednosti
+ * i pun int32_t opseg. Permutacija mora biti permutacija, susedni redovi
+ * u leksikografskom poretku, a jednaki redovi u originalnom redosledu.
+ * radixGather se proverava za elemente od 4, 8 i 12 bajtova.
+ */
+void testSortColumns(void)
+{
+	printf("TEST 30: Sortiranje više kolona (permutacija)\n");
+	printf("---------------------------------------------\n");
+	printf("(LSD od poslednje kolone ka prvoj, kolone se ne menjaju)\n");
+
+	const size_t n = 100000U;
+	int32_t* first = (int32_t*)malloc(n * sizeof(int32_t));
+	int32_t* second = (int32_t*)malloc(n * sizeof(int32_t));
+	int32_t* third = (int32_t*)malloc(n * sizeof(int32_t));
+	uint32_t* perm = (uint32_t*)malloc(n * sizeof(uint32_t));
+	bool* seen = (bool*)calloc(n, sizeof(bool));
+	int32_t* gathered = (int32_t*)malloc(n * 3U * sizeof(int32_t));
+	if ((first == NULL) || (second == NULL) || (third == NULL) || (perm == NULL) || (seen == NULL) || (gathered == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(first);
+		free(second);
+		free(third);
+		free(perm);
+		free(seen);
+		free(gathered);
+		return;
+	}
+
+	srand(30);
+	for (size_t i = 0; i < n; i++)
+	{
+		first[i] = (int32_t)(rand() % 10);
+		second[i] = (int32_t)(rand() % 200) - 100;
+		third[i] = ((i % 7U) == 0U) ? 0 : (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+	}
+
+	const int32_t* cols[3] = { first, second, third };
+	bool passed = true;
+
+	/* Dve kolone: treća je izostavljena, pa ima mnogo jednakih redova (stabilnost) */
+	for (size_t numCols = 2U; numCols <= 3U; numCols++)
+	{
+		(void)memset(seen, 0, n * sizeof(bool));
+		SortResult result = radixSortColumns(cols, numCols, n, perm);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (result == SORT_SUCCESS);
+		for (size_t i = 0; ok && (i < n); i++)
+		{
+			ok = (perm[i] < n) && !seen[perm[i]];
+			if (ok)
+			{
+				seen[perm[i]] = true;
+			}
+		}
+		for (size_t i = 1; ok && (i < n); i++)
+		{
+			uint32_t a = perm[i - 1U];
+			uint32_t b = perm[i];
+			int order = 0;
+			for (size_t c = 0; (c < numCols) && (order == 0); c++)
+			{
+				order = (cols[c][a] < cols[c][b]) ? -1 : ((cols[c][a] > cols[c][b]) ? 1 : 0);
+			}
+			ok = (order < 0) || ((order == 0) && (a < b));
+		}
+
+		printf("%zu kolone, n=%zu, prolaza %-2zu - %s\n", numCols, n, stats.passes, ok ? "OK" : "GREŠKA");
+		passed = passed && ok;
+	}
+
+	/* Gather: 4 bajta, 8 bajtova (dve kolone kao int64_t) i 12 bajtova (ceo red) */
+	bool gatherOk = (radixGather(third, sizeof(int32_t), n, perm, gathered) == SORT_SUCCESS);
+	for (size_t i = 0; gatherOk && (i < n); i++)
+	{
+		gatherOk = (gathered[i] == third[perm[i]]);
+	}
+
+	int64_t* wide = (int64_t*)malloc(n * sizeof(int64_t));
+	int64_t* wideOut = (int64_t*)malloc(n * sizeof(int64_t));
+	int32_t* rows = (int32_t*)malloc(n * 3U * sizeof(int32_t));
+	if ((wide != NULL) && (wideOut != NULL) && (rows != NULL))
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			wide[i] = ((int64_t)second[i] * 4294967296LL) + third[i];
+			rows[i * 3U] = first[i];
+			rows[(i * 3U) + 1U] = second[i];
+			rows[(i * 3U) + 2U] = third[i];
+		}
+		gatherOk = gatherOk && (radixGather(wide, sizeof(int64_t), n, perm, wideOut) == SORT_SUCCESS) &&
+		           (radixGather(rows, 3U * sizeof(int32_t), n, perm, gathered) == SORT_SUCCESS);
+		for (size_t i = 0; gatherOk && (i < n); i++)
+		{
+			gatherOk = (wideOut[i] == wide[perm[i]]) && (gathered[i * 3U] == first[perm[i]]) &&
+			           (gathered[(i * 3U) + 2U] == third[perm[i]]);
+		}
+	}
+	else
+	{
+		gatherOk = false;
+	}
+	printf("radixGather (4, 8 i 12 bajtova)     - %s\n", gatherOk ? "OK" : "GREŠKA");
+	passed = passed && gatherOk;
+
+	uint32_t one = 5U;
+	const int32_t* nullCols[1] = { NULL };
+	passed = passed && (radixSortColumns(cols, 0U, n, perm) == SORT_ERROR_ARGUMENT) &&
+	         (radixSortColumns(nullCols, 1U, n, perm) == SORT_ERROR_NULL) &&
+	         (radixSortColumns(cols, 3U, 0U, perm) == SORT_ERROR_SIZE) &&
+	         (radixSortColumns(cols, 3U, 1U, &one) == SORT_SUCCESS) && (one == 0U) &&
+	         (radixGather(third, 0U, n, perm, gathered) == SORT_ERROR_ARGUMENT);
+
+	free(first);
+	free(second);
+	free(third);
+	free(perm);
+	free(seen);
+	free(gathered);
+	free(wide);
+	free(wideOut);
+	free(rows);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Redovi su leksikografski sortirani, stabilno.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Sortiranje kolona nije ispravno!\n\n");
+	}
+}
+
+/*
+ * TEST 31: Sortiranje zapisa po int32_t polju
+ *
+ * Zapisi od 12, 40 i 200 bajtova (pomeranje celih zapisa, gather i
+ * ciklusi u mestu), ključ i na neporavnatom pomeraju. Svaki zapis nosi
+ * redni broj i bajtove izvedene iz njega - posle sortiranja ključevi
+ * moraju biti neopadajući, jednaki ključevi u originalnom redosledu, a
+ * svaki zapis ceo.
+ */
+void testSortRecords(void)
+{
+	printf("TEST 31: Sortiranje zapisa po int32_t polju\n");
+	printf("-------------------------------------------\n");
+	printf("(Mali zapisi se pomeraju celi, veliki preko (ključ, index))\n");
+
+	typedef struct
+	{
+		size_t stride;
+		size_t keyOffset;
+		size_t idOffset;
+	} RecordCase;
+
+	const RecordCase cases[] =
+	{
+		{ 12U,  4U,   0U },
+		{ 40U,  3U,   20U },
+		{ 200U, 101U, 0U },
+	};
+
+	const size_t n = 50000U;
+	bool passed = true;
+
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		size_t stride = cases[c].stride;
+		uint8_t* records = (uint8_t*)malloc(n * stride);
+		if (records == NULL)
+		{
+			printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+			return;
+		}
+
+		srand(31);
+		for (size_t i = 0; i < n; i++)
+		{
+			uint8_t* record = records + (i * stride);
+			for (size_t b = 0; b < stride; b++)
+			{
+				record[b] = (uint8_t)((i * 31U) + b);
+			}
+			uint32_t id = (uint32_t)i;
+			int32_t key = (int32_t)(rand() % 2000) - 1000; /* puno jednakih ključeva */
+			(void)memcpy(record + cases[c].idOffset, &id, sizeof(id));
+			(void)memcpy(record + cases[c].keyOffset, &key, sizeof(key));
+		}
+
+		SortResult result = radixSortRecords(records, n, stride, cases[c].keyOffset);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (result == SORT_SUCCESS);
+		int32_t previousKey = INT32_MIN;
+		uint32_t previousId = 0U;
+		for (size_t i = 0; ok && (i < n); i++)
+		{
+			const uint8_t* record = records + (i * stride);
+			uint32_t id;
+			int32_t key;
+			(void)memcpy(&id, record + cases[c].idOffset, sizeof(id));
+			(void)memcpy(&key, record + cases[c].keyOffset, sizeof(key));
+
+			ok = (id < n) && ((key > previousKey) || ((key == previousKey) && ((i == 0U) || (id > previousId))));
+			for (size_t b = 0; ok && (b < stride); b++)
+			{
+				bool field = ((b >= cases[c].idOffset) && (b < cases[c].idOffset + 4U)) ||
+				             ((b >= cases[c].keyOffset) && (b < cases[c].keyOffset + 4U));
+				ok = field || (record[b] == (uint8_t)((id * 31U) + b));
+			}
+			previousKey = key;
+			previousId = id;
+		}
+
+		printf("zapis %3zu B, ključ na %3zu: scratch %8zu B, prolaza %zu - %s\n", stride, cases[c].keyOffset,
+		       stats.scratchBytes, stats.passes, ok ? "OK" : "GREŠKA");
+		passed = passed && ok;
+		free(records);
+	}
+
+	uint8_t small[16] = { 0 };
+	passed = passed && (radixSortRecords(NULL, 4U, 4U, 0U) == SORT_ERROR_NULL) &&
+	         (radixSortRecords(small, 0U, 4U, 0U) == SORT_ERROR_SIZE) &&
+	         (radixSortRecords(small, 2U, 8U, 5U) == SORT_ERROR_ARGUMENT) &&
+	         (radixSortRecords(small, 4U, 3U, 0U) == SORT_ERROR_ARGUMENT) &&
+	         (radixSortRecords(small, 1U, 16U, 12U) == SORT_SUCCESS);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Zapisi su stabilno sortirani i ostali celi.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Sortiranje zapisa nije ispravno!\n\n");
+	}
+}
+
+/*
+ * TEST 32: Sortiranje sa limitom pomoćne memorije
+ *
+ * Isti niz se sortira sa limitima od 0 bajtova (potpuno u mestu) do
+ * dovoljnog za obično sortiranje. Rezultat se poredi sa qsort, a
+ * prijavljeni scratch ne sme preći limit.
+ */
+void testSortBudget(void)
+{
+	printf("TEST 32: Sortiranje sa limitom pomoćne memorije\n");
+	printf("-----------------------------------------------\n");
+	printf("(Delovi u limitu se sortiraju radix-om, pa spajaju u mestu)\n");
+
+	const size_t n = 300001U;
+	int32_t* original = (int32_t*)malloc(n * sizeof(int32_t));
+	int32_t* arr = (int32_t*)malloc(n * sizeof(int32_t));
+	int32_t* reference = (int32_t*)malloc(n * sizeof(int32_t));
+	if ((original == NULL) || (arr == NULL) || (reference == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(original);
+		free(arr);
+		free(reference);
+		return;
+	}
+
+	srand(32);
+	for (size_t i = 0; i < n; i++)
+	{
+		/* Slučajne vrednosti preko celog opsega, sa nešto ponavljanja */
+		original[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+		if ((i % 7U) == 0U)
+		{
+			original[i] = (int32_t)(i % 100U) - 50;
+		}
+	}
+	(void)memcpy(reference, original, n * sizeof(int32_t));
+	qsort(reference, n, sizeof(int32_t), compareInt32);
+
+	const size_t budgets[] =
+	{
+		0U,
+		1000U,
+		64U * 1024U,
+		n,
+		n * sizeof(int32_t),
+		2U * n * sizeof(int32_t) - 1U,
+		(size_t)64U * 1024U * 1024U,
+	};
+
+	bool passed = true;
+	for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++)
+	{
+		(void)memcpy(arr, original, n * sizeof(int32_t));
+		SortResult result = radixSortBudget(arr, n, budgets[b]);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (result == SORT_SUCCESS) && (stats.scratchBytes <= budgets[b]) &&
+		          (memcmp(arr, reference, n * sizeof(int32_t)) == 0);
+		printf("limit %10zu B: scratch %9zu B, %s, prolaza %zu - %s\n", budgets[b], stats.scratchBytes,
+		       getStrategyString(stats.strategy), stats.passes, ok ? "OK" : "GREŠKA");
+		passed = passed && ok;
+	}
+
+	/* Mali nizovi i već sortiran ulaz */
+	for (size_t size = 1U; size <= 200U; size += 13U)
+	{
+		(void)memcpy(arr, original, size * sizeof(int32_t));
+		(void)memcpy(reference, original, size * sizeof(int32_t));
+		passed = passed && (radixSortBudget(arr, size, 0U) == SORT_SUCCESS) &&
+		         matchesQsort(arr, reference, size);
+	}
+	for (size_t i = 0; i < n; i++)
+	{
+		arr[i] = (int32_t)i;
+	}
+	passed = passed && (radixSortBudget(arr, n, 4096U) == SORT_SUCCESS);
+	for (size_t i = 0; passed && (i < n); i++)
+	{
+		passed = (arr[i] == (int32_t)i);
+	}
+
+	passed = passed && (radixSortBudget(NULL, 4U, 0U) == SORT_ERROR_NULL) &&
+	         (radixSortBudget(arr, 0U, 0U) == SORT_ERROR_SIZE);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Rezultat je isti za svaki limit, scratch je u limitu.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Sortiranje sa limitom memorije nije ispravno!\n\n");
+	}
+
+	free(original);
+	free(arr);
+	free(reference);
+}
+
+/*
+ * TEST 33: Kvantili iz histograma (bez sortiranja)
+ *
+ * Tačni kvantili se porede sa elementima qsort-ovanog niza, za široku,
+ * usku i jednu vrednost. Približni moraju biti u granici epsilon * n po
+ * rangu, a ulaz ne sme biti promenjen.
+ */
+void testQuantiles(void)
+{
+	printf("TEST 33: Kvantili iz histograma (bez sortiranja)\n");
+	printf("------------------------------------------------\n");
+	printf("(Jedno čitanje za bucket-e, drugo samo za ciljne bucket-e)\n");
+
+	const size_t n = 200003U;
+	int32_t* data = (int32_t*)malloc(n * sizeof(int32_t));
+	int32_t* sorted = (int32_t*)malloc(n * sizeof(int32_t));
+	if ((data == NULL) || (sorted == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(data);
+		free(sorted);
+		return;
+	}
+
+	const double qs[] = { 0.0, 0.001, 0.25, 0.5, 0.5, 0.75, 0.9, 0.99, 0.999, 0.9999, 1.0, 0.1, 0.3 };
+	const size_t numQs = sizeof(qs) / sizeof(qs[0]);
+	const char* names[] = { "široka", "uska", "jedna vrednost" };
+	bool passed = true;
+
+	srand(33);
+	for (size_t dist = 0; dist < 3U; dist++)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			if (dist == 0U)
+			{
+				data[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+			}
+			else if (dist == 1U)
+			{
+				data[i] = (rand() % 5000) - 2500;
+			}
+			else
+			{
+				data[i] = INT32_MIN;
+			}
+		}
+		(void)memcpy(sorted, data, n * sizeof(int32_t));
+		qsort(sorted, n, sizeof(int32_t), compareInt32);
+
+		int32_t out[sizeof(qs) / sizeof(qs[0])];
+		bool ok = (radixQuantiles(data, n, qs, numQs, out) == SORT_SUCCESS);
+		SortStats stats;
+		radixSortGetStats(&stats);
+		for (size_t q = 0; ok && (q < numQs); q++)
+		{
+			ok = (out[q] == sorted[(size_t)(qs[q] * (double)(n - 1U))]);
+		}
+
+		/* Približno: rang vraćene vrednosti najviše epsilon * n od traženog */
+		const double epsilon = 0.01;
+		bool approxOk = (radixQuantilesApprox(data, n, qs, numQs, epsilon, out) == SORT_SUCCESS);
+		SortStats approxStats;
+		radixSortGetStats(&approxStats);
+		for (size_t q = 0; approxOk && (q < numQs); q++)
+		{
+			size_t rank = (size_t)(qs[q] * (double)(n - 1U));
+			size_t lo = 0U;
+			while ((lo < n) && (sorted[lo] < out[q]))
+			{
+				lo++;
+			}
+			size_t hi = lo;
+			while ((hi < n) && (sorted[hi] <= out[q]))
+			{
+				hi++;
+			}
+			/* Rangovi vrednosti su [lo, hi]; traženi mora biti blizu tog opsega */
+			double limit = epsilon * (double)n;
+			approxOk = ((double)rank + limit >= (double)lo) && ((double)rank <= (double)hi + limit);
+		}
+
+		DistributionSummary summary;
+		bool summaryOk = (radixSummarize(data, n, &summary) == SORT_SUCCESS) &&
+		                 (summary.count == n) && (summary.min == sorted[0]) && (summary.max == sorted[n - 1U]) &&
+		                 (summary.median == sorted[(n - 1U) / 2U]) && (summary.mean >= (double)sorted[0]) &&
+		                 (summary.mean <= (double)sorted[n - 1U]);
+
+		printf("%-15s tačno: %zu čitanja, približno: %zu - %s\n", names[dist], stats.passes,
+		       approxStats.passes, (ok && approxOk && summaryOk) ? "OK" : "GREŠKA");
+		passed = passed && ok && approxOk && summaryOk;
+	}
+
+	/* Ulaz ostaje nepromenjen */
+	int32_t small[5] = { 5, -3, 9, 0, -3 };
+	int32_t out[3];
+	const double q3[3] = { 0.0, 0.5, 1.0 };
+	passed = passed && (radixQuantiles(small, 5U, q3, 3U, out) == SORT_SUCCESS) &&
+	         (out[0] == -3) && (out[1] == 0) && (out[2] == 9) && (small[0] == 5) && (small[4] == -3);
+
+	const double bad[1] = { 1.5 };
+	passed = passed && (radixQuantiles(NULL, 5U, q3, 3U, out) == SORT_ERROR_NULL) &&
+	         (radixQuantiles(small, 0U, q3, 3U, out) == SORT_ERROR_SIZE) &&
+	         (radixQuantiles(small, 5U, q3, 0U, out) == SORT_ERROR_ARGUMENT) &&
+	         (radixQuantiles(small, 5U, bad, 1U, out) == SORT_ERROR_ARGUMENT) &&
+	         (radixQuantilesApprox(small, 5U, q3, 3U, -1.0, out) == SORT_ERROR_ARGUMENT);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Kvantili odgovaraju sortiranom nizu.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Kvantili nisu ispravni!\n\n");
+	}
+
+	free(data);
+	free(sorted);
+}
+
+#if TEST_HAVE_THREADS
+
+/*
+ * Pozivalac sa sopstvenim kešom: sortira nizove različitih veličina i
+ * beleži da li je keš tog thread-a nešto zadržao
+ */
+typedef struct
+{
+	unsigned int seed;
+	size_t cachedBytes;
+	bool ok;
+} CacheCaller;
+
+static void* cacheCallerThread(void* arg)
+{
+	CacheCaller* caller = (CacheCaller*)arg;
+	const size_t maxSize = 100000U;
+	int32_t* arr = (int32_t*)malloc(maxSize * sizeof(int32_t));
+	int32_t* reference = (int32_t*)malloc(maxSize * sizeof(int32_t));
+
+	caller->ok = (arr != NULL) && (reference != NULL);
+	for (size_t round = 0; caller->ok && (round < 40U); round++)
+	{
+		size_t size = 1000U + (((size_t)caller->seed >> 8) % (maxSize - 1000U));
+		for (size_t i = 0; i < size; i++)
+		{
+			caller->seed = (caller->seed * 1103515245U) + 12345U;
+			arr[i] = (int32_t)(caller->seed ^ (caller->seed << 7));
+			reference[i] = arr[i];
+		}
+		caller->ok = (radixSort(arr, size) == SORT_SUCCESS) && matchesQsort(arr, reference, size);
+	}
+	caller->cachedBytes = radixSortThreadCacheBytes();
+
+	free(arr);
+	free(reference);
+	return NULL;/*keš oslobađa destruktor na kraju thread-a*/
+}
+
+#endif
+
+/*
+ * TEST 34: Keš pomoćnih bafera po thread-u
+ *
+ * Sa uključenim kešom ponovljeno sortiranje iz istog thread-a ne
+ * alocira: keš drži bafere posle poziva i ne raste za niz iste
+ * veličine. Posle 64 mala niza veliki bafer se oslobađa (high-water
+ * mark), a radixSortReleaseThreadCache prazni keš. Zatim 4 thread-a
+ * sortiraju istovremeno, svaki iz svog keša.
+ */
+void testThreadCache(void)
+{
+	printf("TEST 34: Keš pomoćnih bafera po thread-u\n");
+	printf("----------------------------------------\n");
+	printf("(Baferi ostaju u thread-u između poziva, bez malloc-a)\n");
+
+	const size_t size = 1000000U;
+	int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+	if ((arr == NULL) || (reference == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(arr);
+		free(reference);
+		return;
+	}
+
+	SortConfig original;
+	radixSortGetConfig(&original);
+	SortConfig config = original;
+	config.threadCacheBytes = (size_t)64U * 1024U * 1024U;
+	(void)radixSortSetConfig(&config);
+
+	bool passed = (radixSortThreadCacheBytes() == 0U);
+	size_t held[2] = { 0U, 0U };
+	srand(34);
+	for (size_t round = 0; round < 2U; round++)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			arr[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+			reference[i] = arr[i];
+		}
+		passed = passed && (radixSort(arr, size) == SORT_SUCCESS) && matchesQsort(arr, reference, size);
+		held[round] = radixSortThreadCacheBytes();
+	}
+	printf("posle 1. niza keš drži %zu B, posle 2. %zu B\n", held[0], held[1]);
+	passed = passed && (held[0] >= 2U * size * sizeof(int32_t)) && (held[1] == held[0]);
+
+	/* Mnogo malih nizova: veliki baferi ispadaju na kraju prozora */
+	for (size_t round = 0; round < 70U; round++)
+	{
+		for (size_t i = 0; i < 1000U; i++)
+		{
+			arr[i] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+			reference[i] = arr[i];
+		}
+		passed = passed && (radixSort(arr, 1000U) == SORT_SUCCESS) && matchesQsort(arr, reference, 1000U);
+	}
+	size_t trimmed = radixSortThreadCacheBytes();
+	radixSortReleaseThreadCache();
+	printf("posle 70 malih nizova %zu B, posle oslobađanja %zu B\n", trimmed, radixSortThreadCacheBytes());
+	passed = passed && (trimmed < held[0]) && (radixSortThreadCacheBytes() == 0U);
+
+#if TEST_HAVE_THREADS
+	CacheCaller callers[4];
+	pthread_t threads[4];
+	bool started[4] = {false};
+	for (size_t t = 0; t < 4U; t++)
+	{
+		callers[t].seed = 34U + (unsigned int)t;
+		callers[t].cachedBytes = 0U;
+		callers[t].ok = false;
+		started[t] = (pthread_create(&threads[t], NULL, cacheCallerThread, &callers[t]) == 0);
+		if (!started[t])
+		{
+			(void)cacheCallerThread(&callers[t]);
+		}
+	}
+	for (size_t t = 0; t < 4U; t++)
+	{
+		if (started[t])
+		{
+			(void)pthread_join(threads[t], NULL);
+		}
+		passed = passed && callers[t].ok && (callers[t].cachedBytes > 0U);
+	}
+	printf("4 thread-a istovremeno: %s\n", passed ? "OK" : "GREŠKA");
+	radixSortReleaseThreadCache();/*ako neki thread nije pokrenut, radio je ovde*/
+#endif
+
+	(void)radixSortSetConfig(&original);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Keš se ponovo koristi, smanjuje i oslobađa.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Keš pomoćnih bafera nije ispravan!\n\n");
+	}
+
+	free(arr);
+	free(reference);
+}
+
+/*
+ * String sa početnom pozicijom: qsort nije stabilan, pa se jednaki
+ * stringovi porede po index-u
+ */
+typedef struct
+{
+	const char* text;
+	size_t length;
+	size_t index;
+} IndexedString;
+
+static int compareIndexedStrings(const void* a, const void* b)
+{
+	const IndexedString* sa = (const IndexedString*)a;
+	const IndexedString* sb = (const IndexedString*)b;
+	size_t common = (sa->length < sb->length) ? sa->length : sb->length;
+	int diff = (common > 0U) ? memcmp(sa->text, sb->text, common) : 0;
+	if (diff != 0)
+	{
+		return diff;
+	}
+	if (sa->length != sb->length)
+	{
+		return (sa->length < sb->length) ? -1 : 1;
+	}
+	return (sa->index < sb->index) ? -1 : ((sa->index > sb->index) ? 1 : 0);
+}
+
+/*
+ * TEST 35: Sortiranje stringova (MSD po bajtovima)
+ *
+ * Oba oblika ulaza (pokazivač + dužina, blob + offsets) porede se sa
+ * qsort-om (memcmp, pa dužina, pa početna pozicija): URL-ovi sa dugim
+ * zajedničkim prefiksom, kratki stringovi sa '\0' i bajtom 255 (mnogo
+ * duplikata i prefiksa), isti dugi string i mala grupa. Stabilnost se
+ * vidi po permutaciji i po pokazivačima na tekst.
+ */
+void testStringSort(void)
+{
+	printf("TEST 35: Sortiranje stringova (MSD po bajtovima)\n");
+	printf("-------------------------------------------------\n");
+	printf("(Keš reč od 7 znakova po stringu, multikey quicksort za male grupe)\n");
+
+	const size_t n = 100003U;
+	const size_t maxLength = 64U;
+	char* blob = (char*)malloc(n * maxLength);
+	size_t* offsets = (size_t*)malloc((n + 1U) * sizeof(size_t));
+	uint32_t* perm = (uint32_t*)malloc(n * sizeof(uint32_t));
+	RadixString* strings = (RadixString*)malloc(n * sizeof(RadixString));
+	IndexedString* expected = (IndexedString*)malloc(n * sizeof(IndexedString));
+	if ((blob == NULL) || (offsets == NULL) || (perm == NULL) || (strings == NULL) || (expected == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(blob);
+		free(offsets);
+		free(perm);
+		free(strings);
+		free(expected);
+		return;
+	}
+
+	const char* names[] = { "URL-ovi", "kratki sa '\\0'", "isti dugi string", "mala grupa" };
+	const char* prefix = "https://example.com/static/";
+	const char alphabet[4] = { '\0', '\x01', 'a', '\xFF' };
+	bool passed = true;
+
+	srand(35);
+	for (size_t kind = 0; kind < 4U; kind++)
+	{
+		size_t count = (kind == 3U) ? 50U : n;
+		size_t used = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			offsets[i] = used;
+			char* text = blob + used;
+			size_t length = 0;
+			if (kind == 0U)
+			{
+				length = strlen(prefix);
+				(void)memcpy(text, prefix, length);
+				size_t extra = (size_t)rand() % 30U;
+				for (size_t k = 0; k < extra; k++)
+				{
+					text[length++] = (char)('a' + (rand() % 3));
+				}
+			}
+			else if (kind == 2U)
+			{
+				length = maxLength;
+				(void)memset(text, 'x', length);
+			}
+			else
+			{
+				length = (size_t)rand() % 13U;
+				for (size_t k = 0; k < length; k++)
+				{
+					text[k] = alphabet[rand() % 4];
+				}
+			}
+			used += length;
+			strings[i].text = text;
+			strings[i].length = length;
+			expected[i].text = text;
+			expected[i].length = length;
+			expected[i].index = i;
+		}
+		offsets[count] = used;
+		qsort(expected, count, sizeof(IndexedString), compareIndexedStrings);
+
+		bool ok = (radixSortStringOffsets(blob, offsets, count, perm) == SORT_SUCCESS);
+		for (size_t i = 0; ok && (i < count); i++)
+		{
+			ok = (perm[i] == (uint32_t)expected[i].index);
+		}
+
+		ok = ok && (radixSortStrings(strings, count) == SORT_SUCCESS);
+		SortStats stats;
+		radixSortGetStats(&stats);
+		for (size_t i = 0; ok && (i < count); i++)
+		{
+			ok = (strings[i].text == expected[i].text) && (strings[i].length == expected[i].length);
+		}
+
+		printf("%-17s %6zu stringova, %zu punjenja keša - %s\n", names[kind], count, stats.passes,
+		       ok ? "OK" : "GREŠKA");
+		passed = passed && ok && (stats.strategy == SORT_STRATEGY_STRING_MSD);
+	}
+
+	/* Greške: NULL, n == 0, offsets koji opadaju */
+	size_t badOffsets[3] = { 0U, 5U, 2U };
+	passed = passed && (radixSortStrings(NULL, 5U) == SORT_ERROR_NULL) &&
+	         (radixSortStrings(strings, 0U) == SORT_ERROR_SIZE) &&
+	         (radixSortStringOffsets(blob, NULL, 2U, perm) == SORT_ERROR_NULL) &&
+	         (radixSortStringOffsets(blob, badOffsets, 2U, perm) == SORT_ERROR_ARGUMENT);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Redosled se poklapa sa qsort-om (memcmp).\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Stringovi nisu ispravno sortirani!\n\n");
+	}
+
+	free(blob);
+	free(offsets);
+	free(perm);
+	free(strings);
+	free(expected);
+}
+
+static size_t g_keyBytes;/*dužina ključa za compareKeyBytes (qsort nema kontekst)*/
+
+static int compareKeyBytes(const void* a, const void* b)
+{
+	return memcmp(a, b, g_keyBytes);
+}
+
+/*
+ * TEST 36: Sortiranje ključeva fiksne dužine (radixSortKeysN)
+ *
+ * Ključevi od 4, 6, 8, 16 i 32 bajta se porede sa qsort-om (memcmp):
+ * slučajni (16 i 32 bajta idu MSD putem), IPv6 adrese sa zajedničkim
+ * /52 prefiksom (konstantni bajtovi se preskaču), mali brojevi u 16
+ * bajtova (samo 3 bajta se menjaju, LSD) i svi isti.
+ */
+void testKeysN(void)
+{
+	printf("TEST 36: Sortiranje ključeva fiksne dužine (radixSortKeysN)\n");
+	printf("------------------------------------------------------------\n");
+	printf("(LSD za malo bajtova koji se menjaju, MSD za široke ključeve)\n");
+
+	const size_t n = 200003U;
+	const size_t maxBytes = 32U;
+	uint8_t* keys = (uint8_t*)malloc(n * maxBytes);
+	uint8_t* reference = (uint8_t*)malloc(n * maxBytes);
+	if ((keys == NULL) || (reference == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(keys);
+		free(reference);
+		return;
+	}
+
+	const size_t widths[] = { 4U, 6U, 8U, 16U, 32U, 16U, 16U, 16U };
+	const char* names[] = { "slučajni", "slučajni", "slučajni", "slučajni (UUID)", "slučajni",
+	                        "IPv6, isti /52", "mali brojevi", "svi isti" };
+	bool passed = true;
+
+	srand(36);
+	for (size_t c = 0; c < (sizeof(widths) / sizeof(widths[0])); c++)
+	{
+		size_t keyBytes = widths[c];
+		for (size_t i = 0; i < n; i++)
+		{
+			uint8_t* key = keys + (i * keyBytes);
+			for (size_t b = 0; b < keyBytes; b++)
+			{
+				key[b] = (uint8_t)rand();
+			}
+			if (c == 5U)
+			{
+				(void)memcpy(key, "\x20\x01\x0d\xb8\x85\xa3", 6U);
+				key[6] = (uint8_t)(rand() % 16);
+			}
+			else if (c == 6U)
+			{
+				(void)memset(key, 0, keyBytes - 3U);
+				key[keyBytes - 3U] = (uint8_t)(rand() % 2);
+			}
+			else if (c == 7U)
+			{
+				(void)memset(key, 0xAB, keyBytes);
+			}
+		}
+		(void)memcpy(reference, keys, n * keyBytes);
+		g_keyBytes = keyBytes;
+		qsort(reference, n, keyBytes, compareKeyBytes);
+
+		bool ok = (radixSortKeysN(keys, keyBytes, n) == SORT_SUCCESS) && (memcmp(keys, reference, n * keyBytes) == 0);
+		SortStats stats;
+		radixSortGetStats(&stats);
+		printf("%2zu B %-16s %-32s %zu - %s\n", keyBytes, names[c], getStrategyString(stats.strategy),
+		       stats.passes, ok ? "OK" : "GREŠKA");
+		passed = passed && ok;
+	}
+
+	/* Male grupe i neporavnat početak */
+	uint8_t small[1U + (5U * 3U)] = { 0, 9, 9, 9, 1, 2, 3, 9, 9, 8, 0, 0, 0, 1, 2, 2 };
+	const uint8_t expected[5U * 3U] = { 0, 0, 0, 1, 2, 2, 1, 2, 3, 9, 9, 8, 9, 9, 9 };
+	passed = passed && (radixSortKeysN(small + 1, 3U, 5U) == SORT_SUCCESS) && (memcmp(small + 1, expected, sizeof(expected)) == 0);
+
+	passed = passed && (radixSortKeysN(NULL, 16U, 5U) == SORT_ERROR_NULL) &&
+	         (radixSortKeysN(keys, 16U, 0U) == SORT_ERROR_SIZE) &&
+	         (radixSortKeysN(keys, 0U, 5U) == SORT_ERROR_ARGUMENT) &&
+	         (radixSortKeysN(keys, 16U, SIZE_MAX / 8U) == SORT_ERROR_SIZE);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Redosled se poklapa sa qsort-om (memcmp).\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Ključevi nisu ispravno sortirani!\n\n");
+	}
+
+	free(keys);
+	free(reference);
+}
+
+/* Upisuje datoteku profila sa datim sadržajem */
+static bool writeTextFile(const char* path, const char* text)
+{
+	FILE* file = fopen(path, "w");
+	if (file == NULL)
+	{
+		return false;
+	}
+	bool ok = (fputs(text, file) >= 0);
+	return (fclose(file) == 0) && ok;
+}
+
+static bool sameProfile(const SortProfile* a, const SortProfile* b)
+{
+	return (a->smallSortThreshold == b->smallSortThreshold) && (a->wideDigitMinSize == b->wideDigitMinSize) &&
+	       (a->wideDigitMaxSize == b->wideDigitMaxSize) && (a->writeCombineMinSize == b->writeCombineMinSize) &&
+	       (a->cacheBlockedMinSize == b->cacheBlockedMinSize) && (a->parallelMinPerThread == b->parallelMinPerThread) &&
+	       (a->poolMinPerThread == b->poolMinPerThread);
+}
+
+/*
+ * TEST 37: Profil mašine (radixSortLoadProfile / radixSortSetProfile)
+ *
+ * Profil iz datoteke uključuje insertion sort do 64 elementa, 11-bitne
+ * cifre i rasipanje kroz bafere po bucket-u; rezultat se poredi sa
+ * qsort-om, a izbor strategije sa statistikom. Neispravne datoteke se
+ * odbijaju bez promene aktivnog profila, a upisan profil se učitava
+ * nazad isti.
+ */
+void testSortProfile(void)
+{
+	printf("TEST 37: Profil mašine (radixSortLoadProfile)\n");
+	printf("---------------------------------------------\n");
+
+	const char* path = "radixsort_test.profile";
+	const size_t size = 100003U;
+	int32_t* arr = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* copy = (int32_t*)malloc(size * sizeof(int32_t));
+	int32_t* reference = (int32_t*)malloc(size * sizeof(int32_t));
+	if ((arr == NULL) || (copy == NULL) || (reference == NULL))
+	{
+		printf("✗ Greška: Neuspela alokacija memorije za test niz!\n\n");
+		free(arr);
+		free(copy);
+		free(reference);
+		return;
+	}
+
+	SortProfile original;
+	radixSortGetProfile(&original);
+
+	bool passed = writeTextFile(path,
+		"# profil za test\n"
+		"version = 1\n"
+		"small_sort_threshold = 64   # insertion sort do 64\n"
+		"wide_digit_min_size = 50000\n"
+		"wide_digit_max_size = 200000\n"
+		"write_combine_min_size = 1000\n"
+		"nepoznat_kljuc = 7\n");
+	passed = passed && (radixSortLoadProfile(path) == SORT_SUCCESS);
+
+	SortProfile profile;
+	radixSortGetProfile(&profile);
+	passed = passed && (profile.smallSortThreshold == 64U) && (profile.wideDigitMinSize == 50000U) &&
+	         (profile.wideDigitMaxSize == 200000U) && (profile.writeCombineMinSize == 1000U) &&
+	         (profile.parallelMinPerThread == original.parallelMinPerThread);
+
+	typedef struct
+	{
+		const char* name;
+		size_t size;
+		uint32_t mask;        /* opseg vrednosti */
+		bool copy;            /* radixSortCopy umesto radixSort */
+		SortStrategy strategy;
+		size_t passes;        /* 0 = ne proverava se */
+	} ProfileCase;
+
+	const ProfileCase cases[] =
+	{
+		{ "64 elementa",               64U,     UINT32_MAX, false, SORT_STRATEGY_INSERTION, 0U },
+		{ "100003, 11-bitne cifre",    size,    UINT32_MAX, false, SORT_STRATEGY_LSD, 3U },
+		{ "100003, kopija, 11-bitne",  size,    UINT32_MAX, true,  SORT_STRATEGY_LSD, 3U },
+		{ "30000, bafer po bucket-u",  30000U,  UINT32_MAX, false, SORT_STRATEGY_LSD, 4U },
+		{ "100003, 3 bajta",           size,    0xFFFFFFU,  false, SORT_STRATEGY_LSD, 3U },
+	};
+
+	srand(37);
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+	{
+		const ProfileCase* test = &cases[c];
+		for (size_t i = 0; i < test->size; i++)
+		{
+			uint32_t random = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+			arr[i] = (int32_t)(random & test->mask);
+			reference[i] = arr[i];
+		}
+
+		SortResult result = test->copy ? radixSortCopy(arr, copy, test->size) : radixSort(arr, test->size);
+		SortStats stats;
+		radixSortGetStats(&stats);
+
+		bool ok = (result == SORT_SUCCESS) && matchesQsort(test->copy ? copy : arr, reference, test->size) &&
+		          (stats.strategy == test->strategy) && ((test->passes == 0U) || (stats.passes == test->passes));
+		printf("%-28s %-28s %zu - %s\n", test->name, getStrategyString(stats.strategy), stats.passes, ok ? "OK" : "GREŠKA");
+		passed = passed && ok;
+	}
+
+	/* Neispravne datoteke: aktivan profil ostaje isti */
+	const char* invalid[] =
+	{
+		"small_sort_threshold = 16\n",                   /* nema version */
+		"version = 2\n",                                 /* druga verzija formata */
+		"version = 1\nsmall_sort_threshold = 16x\n",     /* nije broj */
+		"version = 1\nsmall_sort_threshold = -16\n",
+		"version = 1\nsmall_sort_threshold = 600\n",     /* veće od 512 */
+		"version = 1\nparallel_min_per_thread = 0\n",
+		"version = 1\nwide_digit_min_size = 9\nwide_digit_max_size = 8\n",
+		"version = 1\nsmall_sort_threshold\n",           /* nema '=' */
+	};
+	bool rejected = true;
+	for (size_t f = 0; f < sizeof(invalid) / sizeof(invalid[0]); f++)
+	{
+		rejected = rejected && writeTextFile(path, invalid[f]) && (radixSortLoadProfile(path) == SORT_ERROR_ARGUMENT);
+	}
+	SortProfile after;
+	radixSortGetProfile(&after);
+	rejected = rejected && sameProfile(&after, &profile) && (radixSortLoadProfile("nepostojeci/radixsort.profile") == SORT_ERROR_ARGUMENT);
+	printf("%-28s %s\n", "neispravne datoteke", rejected ? "OK" : "GREŠKA");
+	passed = passed && rejected;
+
+	/* Upis pa učitavanje daje isti profil; ugrađene vrednosti se mogu vratiti */
+	SortProfile defaults;
+	radixSortDefaultProfile(&defaults);
+	profile.cacheBlockedMinSize = SIZE_MAX;
+	bool roundTrip = (radixSortSetProfile(&profile) == SORT_SUCCESS) && (radixSortSaveProfile(path) == SORT_SUCCESS) &&
+	                 (radixSortSetProfile(&defaults) == SORT_SUCCESS) && (radixSortLoadProfile(path) == SORT_SUCCESS);
+	radixSortGetProfile(&after);
+	roundTrip = roundTrip && sameProfile(&after, &profile) && (defaults.smallSortThreshold == 32U) &&
+	            (defaults.wideDigitMaxSize == 0U) && (defaults.writeCombineMinSize == 0U) &&
+	            (radixSortSetProfile(NULL) == SORT_ERROR_NULL);
+	defaults.poolMinPerThread = 1U;
+	roundTrip = roundTrip && (radixSortSetProfile(&defaults) == SORT_ERROR_ARGUMENT);
+	printf("%-28s %s\n", "upis i ponovno učitavanje", roundTrip ? "OK" : "GREŠKA");
+	passed = passed && roundTrip;
+
+	(void)remove(path);
+	(void)radixSortSetProfile(&original);
+
+	if (passed)
+	{
+		printf("✓ Test uspešan! Profil menja izbor strategije, rezultat je isti.\n\n");
+	}
+	else
+	{
+		printf("✗ Greška: Profil nije ispravno primenjen!\n\n");
+	}
+
+	free(arr);
+	free(copy);
+	free(reference);
+}
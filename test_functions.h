@@ -31,4 +31,26 @@ void testAllSameElements(void);
 
 void testMillionElements(void);
 
+void testHugePageScratch(void);
+void testParallelSort(void);
+void testBatchSort(void);
+void testSegmentedSort(void);
+void testNarrowRange(void);
+void testLowCardinality(void);
+void testUniqueCounts(void);
+void testCacheBlockedSort(void);
+void testSortCopy(void);
+void testSortContext(void);
+void testSortAsync(void);
+void testPackedSort(void);
+void testSortedRuns(void);
+void testSortColumns(void);
+void testSortRecords(void);
+void testSortBudget(void);
+void testQuantiles(void);
+void testThreadCache(void);
+void testStringSort(void);
+void testKeysN(void);
+void testSortProfile(void);
+
 #endif /* TEST_FUNCTIONS_H */
@@ -0,0 +1,142 @@
+"""
+============================================================================
+test_python.py
+OPIS: Testovi za Python modul radixsort (radixsort_module.c)
+============================================================================
+
+Rezultati se porede sa sorted() / stabilnim sortiranjem indeksa. Testovi
+koriste array.array i memoryview; numpy delovi se preskaču ako numpy nije
+instaliran.
+
+POKRETANJE:
+    make check-python
+
+============================================================================
+"""
+
+import array
+import math
+import random
+import struct
+import sys
+import threading
+
+import radixsort
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+
+def report(name, ok):
+    print(f"{name:<46} {'OK' if ok else 'GREŠKA'}")
+    return ok
+
+
+def sort_key(value):
+    """Poredak kao u modulu: float po bitovima (-0.0 pre +0.0)."""
+    if isinstance(value, float):
+        bits = struct.unpack("<q", struct.pack("<d", value))[0]
+        return bits ^ 0x7FFFFFFFFFFFFFFF if bits < 0 else bits
+    return value
+
+
+def random_values(code, n, rng):
+    if code in "fd":
+        values = [rng.uniform(-1e6, 1e6) for _ in range(n)]
+        values[:4] = [-0.0, 0.0, math.inf, -math.inf]
+        return values
+    bits = array.array(code).itemsize * 8
+    if code.isupper():
+        return [rng.randrange(0, 1 << bits) for _ in range(n)]
+    return [rng.randrange(-(1 << (bits - 1)), 1 << (bits - 1)) for _ in range(n)]
+
+
+def main():
+    print("TEST Python: modul radixsort")
+    print("----------------------------")
+
+    rng = random.Random(46)
+    n = 20011
+    passed = True
+
+    for code in "iIfqQd":
+        values = list(array.array(code, random_values(code, n, rng)))  # float32 zaokruživanje
+        expected = sorted(values, key=sort_key)
+        order = sorted(range(n), key=lambda i: sort_key(values[i]))
+
+        data = array.array(code, values)
+        radixsort.sort(data)
+        ok = [sort_key(v) for v in data] == [sort_key(v) for v in expected]
+        passed = report(f"sort array('{code}')", ok) and passed
+
+        perm = radixsort.argsort(array.array(code, values))
+        passed = report(f"argsort array('{code}') -> memoryview('q')", perm.format == "q" and list(perm) == order) and passed
+
+        out = array.array("I", bytes(4 * n))
+        radixsort.argsort(array.array(code, values), out=out)
+        passed = report(f"argsort array('{code}'), out=array('I')", list(out) == order) and passed
+
+        keys = array.array(code, values)
+        payload = array.array("q", range(n))
+        radixsort.sort_pairs(keys, payload)
+        passed = report(f"sort_pairs array('{code}') + array('q')", list(payload) == order) and passed
+
+    # Prazan niz, jedan element, memoryview nad bytearray
+    empty = array.array("i")
+    radixsort.sort(empty)
+    single = array.array("d", [1.5])
+    radixsort.sort(single)
+    raw = bytearray(struct.pack("<4i", 3, -1, 2, 0))
+    radixsort.sort(memoryview(raw).cast("i"))
+    ok = (len(empty) == 0) and (list(single) == [1.5]) and (struct.unpack("<4i", raw) == (-1, 0, 2, 3))
+    passed = report("prazan, jedan element, memoryview.cast('i')", ok) and passed
+
+    # Greške: nepodržan tip, nema upisa, različite dužine - svaka sa svojim izuzetkom
+    errors = 0
+    cases = [(TypeError, lambda: radixsort.sort(array.array("h", [2, 1]))),
+             (BufferError, lambda: radixsort.sort(b"\x01\x02\x03\x04")),
+             (ValueError, lambda: radixsort.sort_pairs(array.array("i", [2, 1]), array.array("i", [1]))),
+             (ValueError, lambda: radixsort.argsort(array.array("i", [2, 1]), out=array.array("d", [0.0, 0.0])))]
+    if numpy is not None:
+        cases.append((TypeError, lambda: radixsort.sort(numpy.array([3, 1, 2], dtype=numpy.int16))))
+    for expected_error, call in cases:
+        try:
+            call()
+        except expected_error:
+            errors += 1
+    passed = report("greške: tip, read-only, dužina, out", errors == len(cases)) and passed
+
+    # Više thread-ova istovremeno (GIL je otpušten tokom sortiranja)
+    arrays = [array.array("i", random_values("i", 200000, rng)) for _ in range(4)]
+    expected = [sorted(a) for a in arrays]
+    threads = [threading.Thread(target=radixsort.sort, args=(a,)) for a in arrays]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    passed = report("4 thread-a istovremeno", all(list(a) == e for a, e in zip(arrays, expected))) and passed
+
+    if numpy is not None:
+        ok = True
+        for dtype in ("int32", "uint32", "float32", "int64", "uint64", "float64"):
+            x = (numpy.random.default_rng(46).standard_normal(100003) * 1000).astype(dtype)
+            y = x.copy()
+            radixsort.sort(y)
+            ok = ok and numpy.array_equal(y, numpy.sort(x))
+            ok = ok and numpy.array_equal(numpy.asarray(radixsort.argsort(x)), numpy.argsort(x, kind="stable"))
+            matrix = x[:100000].reshape(100, 1000).copy()
+            radixsort.sort(matrix)
+            ok = ok and numpy.array_equal(matrix.ravel(), numpy.sort(x[:100000]))
+        passed = report("numpy: sort / argsort / 2D kao ravan niz", ok) and passed
+
+    if passed:
+        print("✓ Test uspešan! Rezultati se poklapaju sa sorted().\n")
+        return 0
+    print("✗ Test neuspešan!\n")
+    return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())